@@ -32,7 +32,8 @@ schiene_t::schiene_t(waytype_t waytype) :
 	weg_t(waytype),
 	reserved(convoihandle_t()),
 	type(block),
-	direction(ribi_t::none)
+	direction(ribi_t::none),
+	reservation_index(0)
 {
 }
 
@@ -41,7 +42,8 @@ schiene_t::schiene_t() :
 	weg_t(track_wt),
 	reserved(convoihandle_t()),
 	type(block),
-	direction(ribi_t::none)
+	direction(ribi_t::none),
+	reservation_index(0)
 {
 	if (schiene_t::default_schiene) {
 		set_desc(schiene_t::default_schiene);
@@ -56,12 +58,41 @@ schiene_t::schiene_t(loadsave_t *file) :
 	weg_t(track_wt),
 	reserved(convoihandle_t()),
 	type(block),
-	direction(ribi_t::none)
+	direction(ribi_t::none),
+	reservation_index(0)
 {
 	rdwr(file);
 }
 
 
+schiene_t::~schiene_t()
+{
+	// the convoy must not keep a pointer to this way
+	set_reserved( convoihandle_t() );
+}
+
+
+void schiene_t::set_reserved(convoihandle_t c)
+{
+	if(  reserved.is_bound()  ) {
+		// reservations loaded before their convoy are not listed yet
+		vector_tpl<schiene_t *> &ways = reserved->reserved_ways;
+		if(  reservation_index < ways.get_count()  &&  ways[reservation_index] == this  ) {
+			schiene_t *const last = ways.back();
+			ways[reservation_index] = last;
+			last->reservation_index = reservation_index;
+			ways.pop_back();
+		}
+	}
+	reserved = c;
+	if(  reserved.is_bound()  ) {
+		vector_tpl<schiene_t *> &ways = reserved->reserved_ways;
+		reservation_index = ways.get_count();
+		ways.append( this );
+	}
+}
+
+
 void schiene_t::cleanup(player_t *)
 {
 	// removes reservation
@@ -93,7 +124,7 @@ bool schiene_t::reserve(convoihandle_t c, ribi_t::ribi dir, reservation_type t,
 			// is already done, but show that this is reservable.
 			return true;
 		}
-		reserved = c;
+		set_reserved(c);
 		type = t;
 		direction = dir;
 
@@ -138,7 +169,7 @@ bool schiene_t::unreserve(convoihandle_t c)
 {
 	// is this tile reserved by us?
 	if(reserved.is_bound()  &&  reserved==c) {
-		reserved = convoihandle_t();
+		set_reserved(convoihandle_t());
 		if(schiene_t::show_reservations) {
 			set_flag( obj_t::dirty );
 		}
@@ -161,7 +192,7 @@ bool schiene_t::unreserve(vehicle_t*)
 		return true;
 	}
 //	if(!welt->lookup(get_pos())->suche_obj(v->get_typ())) {
-		reserved = convoihandle_t();
+		set_reserved(convoihandle_t());
 		if(schiene_t::show_reservations) {
 			set_flag( obj_t::dirty );
 		}
@@ -286,7 +317,15 @@ void schiene_t::rdwr(loadsave_t *file)
 			}
 		}
 		file->rdwr_short(reserved_index);
-		reserved.set_id(reserved_index);
+		if (file->is_loading())
+		{
+			// karte_t::load() lists it with its convoy
+			reserved.set_id(reserved_index);
+		}
+		else if (reserved_index == 0)
+		{
+			set_reserved(convoihandle_t());
+		}
 
 		uint8 t = (uint8)type;
 		file->rdwr_byte(t);
@@ -41,6 +41,18 @@ protected:
 	// Additional data for reservations, such as the priority level or direction.
 	ribi_t::ribi direction;
 
+	/**
+	 * Position of this way in the list of ways reserved by the convoy,
+	 * so that it can be taken off that list at once.
+	 */
+	uint32 reservation_index;
+
+	/**
+	 * Changes the reserving convoy and keeps the lists of reserved ways
+	 * of both convoys up to date. All reservations must go through here.
+	 */
+	void set_reserved(convoihandle_t c);
+
 	schiene_t(waytype_t waytype);
 
 	bool is_type_rail_type(waytype_t wt) { return wt == track_wt || wt == monorail_wt || wt == maglev_wt || wt == tram_wt || wt == narrowgauge_wt; }
@@ -57,6 +69,8 @@ public:
 
 	schiene_t();
 
+	virtual ~schiene_t();
+
 	/**
 	* true, if this rail can be reserved
 	*/
@@ -125,6 +139,12 @@ public:
 	*/
 	convoihandle_t get_reserved_convoi() const {return reserved;}
 
+	/**
+	 * Adds this way to the list of reserved ways of its convoy. For the
+	 * reservations which were loaded before their convoys.
+	 */
+	void register_reservation() { set_reserved(reserved); }
+
 	void rdwr(loadsave_t *file) OVERRIDE;
 
 	void rotate90() OVERRIDE;
@@ -6,7 +6,13 @@
 #include <stdio.h>
 #include <tuple>
 
+#include <algorithm>
+#include <string.h>
+
 #include "../../tpl/slist_tpl.h"
+#include "../../tpl/inthashtable_tpl.h"
+#include "../../tpl/koordhashtable_tpl.h"
+#include "../../tpl/ptrhashtable_tpl.h"
 
 #include "weg.h"
 
@@ -43,6 +49,7 @@
 #include "../../descriptor/roadsign_desc.h"
 #include "../../descriptor/building_desc.h" // for ::should_city_adopt_this
 #include "../../utils/simstring.h"
+#include "../../simmem.h"
 #include "../../simcity.h"
 
 #include "../../bauer/wegbauer.h"
@@ -53,16 +60,183 @@ static pthread_mutex_t weg_calc_image_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZE
 static pthread_mutexattr_t mutex_attributes;
 //static pthread_rwlockattr_t rwlock_attributes;
 
-pthread_mutex_t weg_t::private_car_route_map::route_map_mtx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t private_car_route_mutex = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
 
 /**
  * Alle instantiierten Wege
+ * The order only depends on the order in which ways were built and removed,
+ * so it is the same on all clients.
  */
 vector_tpl <weg_t *> alle_wege;
 
+// 0 is never a valid generation
+std::atomic<uint32> weg_t::network_generation(1);
+
 static slist_tpl<std::tuple<weg_t*, uint32, uint32>> pending_road_travel_time_updates;
+
+/*
+ * Private car routes
+ *
+ * Each set has its own numbering of the destinations and its own registry
+ * of route tables, so that the set being written never touches anything
+ * the set being read uses.
+ */
+
+/// The entries of a route table, used to find an identical table
+struct route_table_key_t
+{
+	const uint32 *entries;
+	uint32 count;
+	uint32 hash;
+};
+
+class route_table_hash_t
+{
+public:
+	typedef int diff_type;
+
+	static uint32 hash(const route_table_key_t &key)
+	{
+		return key.hash;
+	}
+
+	static diff_type comp(const route_table_key_t &key1, const route_table_key_t &key2)
+	{
+		if(  key1.count != key2.count  ) {
+			return key1.count < key2.count ? -1 : 1;
+		}
+		for(  uint32 i = 0;  i < key1.count;  i++  ) {
+			if(  key1.entries[i] != key2.entries[i]  ) {
+				return key1.entries[i] < key2.entries[i] ? -1 : 1;
+			}
+		}
+		return 0;
+	}
+};
+
+/// destination -> destination id + 1
+static koordhashtable_tpl<koord, uint32, N_BAGS_LARGE> private_car_destination_ids[2];
+/// destination id -> destination
+static vector_tpl<koord> private_car_destinations[2];
+/// all route tables in use
+static hashtable_tpl<route_table_key_t, weg_t::private_car_route_table_t *, route_table_hash_t, N_BAGS_LARGE> private_car_route_tables[2];
+
+/// Routes read from a savegame, applied in private_car_routes_finish_rdwr()
+static weg_t::private_car_route_buffer_t private_car_routes_loaded[2];
+
+/// Destination lists shared between tiles in savegames (by set and index)
+static inthashtable_tpl<uint32, vector_tpl<koord>, N_BAGS_MEDIUM> private_car_routes_loaded_lists[2];
+
+struct loaded_route_link_t
+{
+	koord3d pos;
+	uint32 idx;
+	uint8 set;
+	uint8 direction;
+};
+static vector_tpl<loaded_route_link_t> private_car_routes_loaded_links;
+
+/// Routes of searches waiting for merge_private_car_routes()
+struct submitted_private_car_routes_t
+{
+	koord3d origin;
+	uint32 sequence; ///< orders the parts submitted by one search
+	vector_tpl<weg_t::private_car_route_buffer_t::entry_t> entries;
+};
+static vector_tpl<submitted_private_car_routes_t *> private_car_routes_submitted;
+static uint32 private_car_routes_submitted_sequence = 0;
+
+/// Index of the lists already written, by set and direction
+static ptrhashtable_tpl<const weg_t::private_car_route_table_t *, uint32, N_BAGS_LARGE> private_car_routes_saved_lists[2][5];
+static uint32 private_car_routes_saved_list_count = 0;
+
+static uint32 hash_route_entries(const uint32 *entries, uint32 count)
+{
+	uint32 hash = 2166136261u;
+	for(  uint32 i = 0;  i < count;  i++  ) {
+		hash = (hash ^ entries[i]) * 16777619u;
+	}
+	return hash;
+}
+
+/// @returns the id of the destination in the set, numbering it if it is new
+static uint32 get_private_car_destination_id(uint8 set, koord destination)
+{
+	const uint32 id = private_car_destination_ids[set].get(destination);
+	if(  id != 0  ) {
+		return id - 1;
+	}
+	private_car_destinations[set].append(destination);
+	private_car_destination_ids[set].put(destination, private_car_destinations[set].get_count());
+	return private_car_destinations[set].get_count() - 1;
+}
+
+/// Finds or creates the shared table with these entries and takes a reference on it
+static const weg_t::private_car_route_table_t *acquire_route_table(uint8 set, const uint32 *entries, uint32 count)
+{
+	if(  count == 0  ) {
+		return NULL;
+	}
+	route_table_key_t key;
+	key.entries = entries;
+	key.count = count;
+	key.hash = hash_route_entries(entries, count);
+	weg_t::private_car_route_table_t *table = private_car_route_tables[set].get(key);
+	if(  table == NULL  ) {
+		table = (weg_t::private_car_route_table_t *)xmalloc(sizeof(weg_t::private_car_route_table_t) + count * sizeof(uint32));
+		table->references = 0;
+		table->count = count;
+		memcpy(table->get_entries(), entries, count * sizeof(uint32));
+		key.entries = table->get_entries();
+		private_car_route_tables[set].put(key, table);
+	}
+	table->references++;
+	return table;
+}
+
+static void release_route_table(uint8 set, const weg_t::private_car_route_table_t *table)
+{
+	if(  table == NULL  ) {
+		return;
+	}
+	weg_t::private_car_route_table_t *t = const_cast<weg_t::private_car_route_table_t *>(table);
+	if(  --t->references == 0  ) {
+		route_table_key_t key;
+		key.entries = t->get_entries();
+		key.count = t->count;
+		key.hash = hash_route_entries(key.entries, key.count);
+		private_car_route_tables[set].remove(key);
+		free(t);
+	}
+}
+
+static bool compare_submitted_routes(const submitted_private_car_routes_t *a, const submitted_private_car_routes_t *b)
+{
+	if(  a->origin.x != b->origin.x  ) {
+		return a->origin.x < b->origin.x;
+	}
+	if(  a->origin.y != b->origin.y  ) {
+		return a->origin.y < b->origin.y;
+	}
+	if(  a->origin.z != b->origin.z  ) {
+		return a->origin.z < b->origin.z;
+	}
+	return a->sequence < b->sequence;
+}
+
+static bool compare_route_buffer_entries(const weg_t::private_car_route_buffer_t::entry_t &a, const weg_t::private_car_route_buffer_t::entry_t &b)
+{
+	if(  a.pos.x != b.pos.x  ) {
+		return a.pos.x < b.pos.x;
+	}
+	if(  a.pos.y != b.pos.y  ) {
+		return a.pos.y < b.pos.y;
+	}
+	return a.pos.z < b.pos.z;
+}
+
 /**
  * Get list of all ways
  */
@@ -79,6 +253,13 @@ uint32 weg_t::get_all_ways_count()
 void weg_t::clear_list_of__ways()
 {
 	alle_wege.clear();
+	// the ways are gone, so only the tables are left to free
+	FOR(vector_tpl<submitted_private_car_routes_t *>, const submitted, private_car_routes_submitted) {
+		delete submitted;
+	}
+	private_car_routes_submitted.clear();
+	clear_private_car_routes(0);
+	clear_private_car_routes(1);
 }
 
 
@@ -151,6 +332,7 @@ sint32 weg_t::get_max_speed(bool needs_electrification) const
 
 void weg_t::set_desc(const way_desc_t *b, bool from_saved_game)
 {
+	network_changed();
 	if(desc && desc != b)
 	{
 		// Remove the old maintenance cost
@@ -458,7 +640,9 @@ void weg_t::init()
 	bridge_weight_limit = UINT32_MAX_VALUE;
 	desc = 0;
 	init_statistics();
+	alle_wege_index = alle_wege.get_count();
 	alle_wege.append(this);
+	network_changed();
 	flags = 0;
 	image = IMG_EMPTY;
 	foreground_image = IMG_EMPTY;
@@ -473,11 +657,8 @@ void weg_t::init()
 	//int error = pthread_rwlock_init(&private_car_store_route_rwlock, &rwlock_attributes);
 	//assert(error == 0);
 #endif
-	for(uint32 j=0; j<2; j++){
-		for(uint32 i=0; i<5; i++){
-			private_car_routes[j][i].set_route_map_elem(j);
-		}
-	}
+	private_car_routes[0] = NULL;
+	private_car_routes[1] = NULL;
 }
 
 
@@ -491,7 +672,15 @@ weg_t::~weg_t()
 		// This is possibly unnecessary and may lead to crashes
 		//delete_all_routes_from_here();
 
-		alle_wege.remove(this);
+		weg_t *const last = alle_wege.back();
+		alle_wege[alle_wege_index] = last;
+		last->alle_wege_index = alle_wege_index;
+		alle_wege.pop_back();
+		network_changed();
+		lock_private_car_routes();
+		release_route_table(0, private_car_routes[0]);
+		release_route_table(1, private_car_routes[1]);
+		unlock_private_car_routes();
 		player_t *player = get_owner();
 		if (player  &&  desc)
 		{
@@ -654,8 +843,8 @@ void weg_t::rdwr(loadsave_t *file)
 			{
 				for (uint32 i = 0; i < route_array_number; i++)
 				{
-					for(uint32 j=0; j<5; j++) {
-						private_car_routes[i][j].rdwr(file);
+					for(uint8 j=0; j<5; j++) {
+						rdwr_private_car_routes(file, i, j);
 					}
 				}
 			}
@@ -675,23 +864,20 @@ void weg_t::rdwr(loadsave_t *file)
 									// Koord3d representation
 									koord3d next_tile;
 									next_tile.rdwr(file);
-									private_car_routes[i][get_map_idx(next_tile)].insert_unique(destination);
+									private_car_routes_loaded[i].add(get_pos(), destination, get_map_idx(next_tile));
 								} else {
 									// Integer-neighbour representation
 									uint8 next_tile_neighbour;
 									file->rdwr_byte(next_tile_neighbour);
-									private_car_routes[i][get_map_idx(private_car_t::neighbour_from_int(get_pos(), next_tile_neighbour))].insert_unique(destination);
+									private_car_routes_loaded[i].add(get_pos(), destination, get_map_idx(private_car_t::neighbour_from_int(get_pos(), next_tile_neighbour)));
 								}
 							}
 						} else {
 							// Container membership representation
 							for(uint8 j=0; j<5; j++) {
-								private_car_routes[i][j].rdwr(file);
-							}
-
-							if(file->is_version_ex_less(14,39)) {
 								// Correct for nsew->nesw change
-								std::swap(private_car_routes[i][1],private_car_routes[i][2]);
+								const uint8 direction = file->is_version_ex_less(14,39) && (j == 1 || j == 2) ? 3 - j : j;
+								rdwr_private_car_routes(file, i, direction);
 							}
 						}
 					}
@@ -703,72 +889,6 @@ void weg_t::rdwr(loadsave_t *file)
 
 
 
-void weg_t::private_car_route_map::rdwr(loadsave_t *file){
-	if(file->is_saving()){
-
-		uint32 count=get_count();
-		//single or null
-		if(count < 2){
-			file->rdwr_long(count);
-			if(count==1){
-				single_koord.rdwr(file);
-			}
-			return;
-		}
-		//use negative coords to store index and link mode
-		if(link_mode == link_mode_master){
-			count+=2;
-		}else{
-			count=2;
-		}
-		file->rdwr_long(count);
-		koord idx1,idx2;
-		idx1.x = -2;
-		idx1.y = static_cast<sint16>((idx >> 16) & 0xFFFF);
-		idx1.rdwr(file);
-		idx2.x = -1 - (sint16)link_mode;
-		idx2.y = static_cast<sint16>((idx) & 0xFFFF);
-		idx2.rdwr(file);
-		//save the destination list
-		if(link_mode==link_mode_master){
-			for(uint32 k = 0; k < get_count(); k++){
-				route_maps[route_map_elem][idx].get_by_index(k).rdwr(file);
-			}
-		}
-	}else{
-		uint32 count=0;
-		file->rdwr_long(count);
-		resize(0);
-		if(count == 1){
-			single_koord.rdwr(file);
-			link_mode = link_mode_single;
-		}else if(count >= 2){
-			koord idx1,idx2;
-			idx1.rdwr(file);
-			idx2.rdwr(file);
-			if(idx1.x == -2){
-				//newer file, extract index and link mode
-				idx =  uint32(static_cast<uint16>(idx1.y)) << 16;
-				idx |= uint32(static_cast<uint16>(idx2.y));
-				link_mode = -1 - idx2.x;
-				if(link_mode == link_mode_master){
-					route_maps[route_map_elem].store_at(idx,ordered_vector_tpl<koord,uint32>(count-2));
-				}
-			}else{
-				//older file, just append destinations
-				resize(count);
-				insert_unique(idx1);
-				insert_unique(idx2);
-			}
-			//for master or old file, read remaining destinations
-			for(uint32 k=2; k<count; k++){
-				koord dest; dest.rdwr(file);
-				insert_unique(dest);
-			}
-		}
-	}
-}
-
 weg_t::runway_directions weg_t::get_runway_directions() const
 {
 	bool runway_36_18 = false;
@@ -918,6 +1038,7 @@ void weg_t::rotate90()
 	obj_t::rotate90();
 	ribi = ribi_t::rotate90( ribi );
 	ribi_maske = ribi_t::rotate90( ribi_maske );
+	network_changed();
 }
 
 
@@ -929,6 +1050,7 @@ void weg_t::count_sign()
 {
 	// Either only sign or signal please ...
 	flags &= ~(HAS_SIGN|HAS_SIGNAL|HAS_CROSSING);
+	network_changed();
 	const grund_t *gr=welt->lookup(get_pos());
 	if(gr) {
 		uint8 i = 1;
@@ -1075,7 +1197,7 @@ void weg_t::calc_image()
 #endif
 
 #ifdef DEBUG_PRIVATE_CAR_ROUTES
-	if (private_car_routes[private_car_routes_currently_reading_element].empty())
+	if (private_car_routes[private_car_routes_currently_reading_element] == NULL)
 	{
 		set_image(IMG_EMPTY);
 		set_after_image(IMG_EMPTY);
@@ -1524,6 +1646,7 @@ void weg_t::degrade()
 #ifdef MULTI_THREAD
 	welt->await_private_car_threads();
 #endif
+	network_changed();
 	if(public_right_of_way)
 	{
 		// Do not degrade public rights of way, as these should remain passable.
@@ -1592,252 +1715,222 @@ signal_t *weg_t::get_signal(ribi_t::ribi direction_of_travel) const
 	else return NULL;
 }
 
-//#define NO_PRIVATE_CAR_DESTINATION_LINKING
 
-vector_tpl<ordered_vector_tpl<koord,uint32> > weg_t::private_car_route_map::route_maps[2];
 
-void weg_t::private_car_route_map::clear(){
-	if(link_mode==link_mode_master){
-		route_maps[route_map_elem][idx].clear();
-	}else{
-		link_mode=link_mode_NULL;
-	}
+void weg_t::lock_private_car_routes()
+{
+#ifdef MULTI_THREAD
+	int error = pthread_mutex_lock(&private_car_route_mutex);
+	assert(error == 0);
+	(void)error;
+#endif
 }
 
-void weg_t::private_car_route_map::pre_reset(){
-	if(link_mode==link_mode_master){
-		route_maps[route_map_elem][idx].clear();
-	}
-	link_mode=link_mode_NULL;
+
+void weg_t::unlock_private_car_routes()
+{
+#ifdef MULTI_THREAD
+	int error = pthread_mutex_unlock(&private_car_route_mutex);
+	assert(error == 0);
+	(void)error;
+#endif
 }
 
-bool weg_t::private_car_route_map::contains(koord elem) const{
-	if(link_mode==link_mode_NULL){
-		return false;
-	}
-	if(link_mode==link_mode_single){
-		bool result= single_koord==elem;
-		return result;
+
+uint8 weg_t::private_car_route_table_t::get_directions(uint32 id) const
+{
+	const uint32 *entries = get_entries();
+	const uint32 first = id << 3;
+	uint32 low = 0, high = count;
+	while(  low < high  ) {
+		const uint32 mid = (low + high) / 2;
+		if(  entries[mid] < first  ) {
+			low = mid + 1;
+		}
+		else {
+			high = mid;
+		}
 	}
-	if (route_maps[route_map_elem].get_count() <= idx)
-	{
-		return false;
+	uint8 directions = 0;
+	for(  ;  low < count  &&  (entries[low] >> 3) == id;  low++  ) {
+		directions |= 1 << (entries[low] & 7);
 	}
-	bool result=route_maps[route_map_elem][idx].contains(elem);
-	return result;
+	return directions;
 }
 
-bool weg_t::private_car_route_map::insert_unique(koord elem, private_car_route_map* link_to, uint8 link_dir){
-	if(link_mode==link_mode_NULL){
-		single_koord=elem;
-		link_mode=link_mode_single;
-		return true;
-	}
-	if(link_mode==link_mode_single){
-		if(single_koord==elem){
-			return false;
-		}
-		if(link_to
-				&& link_to->link_mode!=link_mode_NULL
-				&& link_to->link_mode!=link_mode_single
-				&& link_to->contains(single_koord)
-				&& link_to->contains(elem)){
-			link_mode=link_dir;
-			idx=link_to->idx;
-			return true;
-		}
-		route_maps[route_map_elem].append(ordered_vector_tpl<koord,uint32>());
-		uint32 new_idx=route_maps[route_map_elem].get_count()-1;
-		route_maps[route_map_elem][new_idx].insert_unique(single_koord);
-		idx=new_idx;
-		link_mode=link_mode_master;
-	}
-	if(link_mode==link_mode_master){
-		bool result = route_maps[route_map_elem][idx].insert_unique(elem);
-		return result;
-	}
-	if(link_to){
-		if(link_mode==link_dir
-				&& link_to->link_mode!=link_mode_NULL
-				&& link_to->link_mode!=link_mode_single){
-			idx=link_to->idx;
-			return false;
-		}
-		route_maps[route_map_elem].append(ordered_vector_tpl<koord,uint32>(route_maps[route_map_elem][idx]));
-		uint32 new_idx=route_maps[route_map_elem].get_count()-1;
-		if(link_to->link_mode==link_mode_single){
-			route_maps[route_map_elem][new_idx].insert_unique(link_to->single_koord);
-		}else if(link_to->link_mode!=link_mode_NULL){
-			route_maps[route_map_elem][new_idx].set_union(route_maps[route_map_elem][link_to->idx]);
-		}
-		idx=new_idx;
-		link_mode=link_mode_master;
-		bool result = route_maps[route_map_elem][idx].insert_unique(elem);
-		return result;
-	}
-	return false;
-}
 
-koord& weg_t::private_car_route_map::get_by_index(uint32_t i){
-	if(link_mode==link_mode_single){
-		koord& result=single_koord;
-		return result;
-	}
-	koord& result = route_maps[route_map_elem][idx][i];
-	return result;
+void weg_t::private_car_route_buffer_t::add(const weg_t *w, koord destination, koord3d next_tile, bool exclusive)
+{
+	entry_t entry;
+	entry.pos = w->get_pos();
+	entry.destination = destination;
+	entry.direction = w->get_map_idx(next_tile);
+	entry.exclusive = exclusive;
+	entries.append(entry);
 }
 
-const koord& weg_t::private_car_route_map::get_by_index(uint32_t i) const {
-	if(link_mode==link_mode_single){
-		const koord& result=single_koord;
-		return result;
-	}
-	const koord& result = route_maps[route_map_elem][idx][i];
-	return result;
-}
-koord& weg_t::private_car_route_map::operator[](uint32 i){
-	return get_by_index(i);
-}
 
-const koord& weg_t::private_car_route_map::operator[](uint32 i) const {
-	return get_by_index(i);
+void weg_t::private_car_route_buffer_t::add(koord3d pos, koord destination, uint8 direction)
+{
+	entry_t entry;
+	entry.pos = pos;
+	entry.destination = destination;
+	entry.direction = direction;
+	entry.exclusive = false;
+	entries.append(entry);
 }
 
-uint32 weg_t::private_car_route_map::get_count() const {
-	if(link_mode==link_mode_NULL){
-		return 0;
-	}
-	if(link_mode==link_mode_single){
-		return 1;
-	}
-	if (route_maps[route_map_elem].get_count() <= idx)
-	{
-		return false;
-	}
-	const uint32 result = route_maps[route_map_elem][idx].get_count();
-	return result;
-}
 
-bool weg_t::private_car_route_map::is_empty() const {
-	if(link_mode==link_mode_NULL){
-		return true;
-	}
-	if(link_mode==link_mode_single){
-		return false;
-	}
-	if (route_maps[route_map_elem].get_count() <= idx)
-	{
-		return false;
+void weg_t::private_car_route_buffer_t::flush(sint8 set)
+{
+	if(  entries.empty()  ) {
+		return;
 	}
-	const bool result = route_maps[route_map_elem][idx].is_empty();
-	return result;
-}
+	const uint8 s = set < 0 ? get_private_car_routes_currently_writing_element() : set;
+
+	// Group by tile; the order within a tile only matters for exclusive entries
+	std::stable_sort(entries.begin(), entries.end(), compare_route_buffer_entries);
+
+	vector_tpl<uint32> added;
+	vector_tpl<uint32> merged;
+	lock_private_car_routes();
+	for(  uint32 i = 0;  i < entries.get_count();  ) {
+		const koord3d pos = entries[i].pos;
+		uint32 end = i;
+		while(  end < entries.get_count()  &&  entries[end].pos == pos  ) {
+			end++;
+		}
+		const grund_t *gr = world()->lookup(pos);
+		weg_t *w = gr ? gr->get_weg(road_wt) : NULL;
+		if(  w == NULL  ) {
+			// the road was removed meanwhile
+			i = end;
+			continue;
+		}
 
-bool weg_t::private_car_route_map::remove(koord elem){
+		bool any_exclusive = false;
+		added.clear();
+		for(  uint32 k = i;  k < end;  k++  ) {
+			added.append((get_private_car_destination_id(s, entries[k].destination) << 3) | entries[k].direction);
+			any_exclusive |= entries[k].exclusive;
+		}
+		std::sort(added.begin(), added.end());
+
+		// union of the current table and the new entries
+		const private_car_route_table_t *old_table = w->private_car_routes[s];
+		const uint32 *old_entries = old_table ? old_table->get_entries() : NULL;
+		const uint32 old_count = old_table ? old_table->count : 0;
+		merged.clear();
+		uint32 a = 0, b = 0;
+		while(  a < old_count  ||  b < added.get_count()  ) {
+			uint32 next;
+			if(  b == added.get_count()  ||  (a < old_count  &&  old_entries[a] <= added[b])  ) {
+				next = old_entries[a++];
+			}
+			else {
+				next = added[b++];
+			}
+			if(  merged.empty()  ||  merged.back() != next  ) {
+				merged.append(next);
+			}
+		}
 
-	if(link_mode==link_mode_NULL){
-		return false;
-	}
-	if(link_mode==link_mode_single){
-		if(single_koord==elem){
-			link_mode=link_mode_NULL;
-			return true;
+		if(  any_exclusive  ) {
+			// an exclusive entry replaces all other directions to its destination
+			for(  uint32 k = i;  k < end;  k++  ) {
+				if(  entries[k].exclusive  ) {
+					const uint32 entry = (get_private_car_destination_id(s, entries[k].destination) << 3) | entries[k].direction;
+					for(  uint32 m = 0;  m < merged.get_count();  ) {
+						if(  (merged[m] >> 3) == (entry >> 3)  &&  merged[m] != entry  ) {
+							merged.remove_at(m);
+						}
+						else {
+							m++;
+						}
+					}
+				}
+			}
 		}
-		return false;
-	}
-	if (route_maps[route_map_elem].get_count() <= idx)
-	{
-		return false;
-	}
-	bool result = route_maps[route_map_elem][idx].remove(elem);
-	return result;
-}
 
-void weg_t::private_car_route_map::resize(uint32 new_size){
-	if((link_mode==link_mode_single || link_mode==link_mode_NULL) && new_size<=1){
-		return;
-	}
-	if(link_mode!=link_mode_master){
-		ordered_vector_tpl<koord,uint32> to_append=(link_mode==link_mode_single || link_mode==link_mode_NULL)
-				? ordered_vector_tpl<koord,uint32>() : ordered_vector_tpl<koord,uint32>(route_maps[route_map_elem][idx]);
-		route_maps[route_map_elem].append(to_append);
-		idx=route_maps[route_map_elem].get_count()-1;
-		if(link_mode==link_mode_single){
-			route_maps[route_map_elem][idx].insert_unique(single_koord);
+		if(  merged.get_count() != old_count  ||  any_exclusive  ) {
+			w->set_private_car_routes(s, merged.begin(), merged.get_count());
+#ifdef DEBUG_PRIVATE_CAR_ROUTES
+			w->calc_image();
+#endif
 		}
-		link_mode=link_mode_master;
+		i = end;
 	}
-	route_maps[route_map_elem][idx].resize(new_size);
+	unlock_private_car_routes();
+	entries.clear();
 }
 
-void weg_t::private_car_route_map::reset(uint8 map_elem){
-	route_maps[map_elem].clear();
-	route_maps[map_elem].resize(0);
-}
-
-weg_t::private_car_route_map* weg_t::private_car_backtrace_last_route_map=NULL;
-uint8 weg_t::private_car_backtrace_last_idx=0;
-
-void weg_t::private_car_backtrace_begin(){
-	private_car_route_map::route_map_lock();
-	private_car_backtrace_last_route_map=NULL;
-}
 
-void weg_t::private_car_backtrace_end(){
-	private_car_route_map::route_map_unlock();
+void weg_t::private_car_route_buffer_t::submit(koord3d origin)
+{
+	if(  entries.empty()  ) {
+		return;
+	}
+	submitted_private_car_routes_t *submitted = new submitted_private_car_routes_t();
+	submitted->origin = origin;
+	swap(submitted->entries, entries);
+	lock_private_car_routes();
+	submitted->sequence = private_car_routes_submitted_sequence++;
+	private_car_routes_submitted.append(submitted);
+	unlock_private_car_routes();
 }
 
-void weg_t::private_car_backtrace_add(koord destination, koord3d next_tile){
-	uint8 writing_elem=get_private_car_routes_currently_writing_element();
-	auto map = private_car_routes[writing_elem];
-	const uint8 map_idx = get_map_idx(next_tile);
 
-	if(!map[map_idx].contains(destination)) {
-#ifdef NO_PRIVATE_CAR_DESTINATION_LINKING
-		for(uint8 i=0;i<5;i++) {
-			if(i != map_idx && map[i].remove(destination)) {
-				break;
-			}
+void weg_t::merge_private_car_routes()
+{
+	if(  private_car_routes_submitted.empty()  ) {
+		return;
+	}
+	std::sort(private_car_routes_submitted.begin(), private_car_routes_submitted.end(), compare_submitted_routes);
+	private_car_route_buffer_t buffer;
+	FOR(vector_tpl<submitted_private_car_routes_t *>, const submitted, private_car_routes_submitted) {
+		FOR(vector_tpl<private_car_route_buffer_t::entry_t>, const& entry, submitted->entries) {
+			buffer.add(entry.pos, entry.destination, entry.direction);
 		}
-		map[map_idx].insert_unique(destination);
-#else
-		map[map_idx].insert_unique(destination,private_car_backtrace_last_route_map,private_car_backtrace_last_idx);
-#endif
+		delete submitted;
 	}
+	private_car_routes_submitted.clear();
+	private_car_routes_submitted_sequence = 0;
+	buffer.flush();
 }
 
-void weg_t::private_car_backtrace_inc(koord3d next_tile){
-	uint8 writing_elem=get_private_car_routes_currently_writing_element();
-	auto map = private_car_routes[writing_elem];
-	const uint8 map_idx = get_map_idx(next_tile);
-	private_car_backtrace_last_route_map=map+map_idx;
-	private_car_backtrace_last_idx=map_idx;
-}
 
-void weg_t::add_private_car_route(koord destination, koord3d next_tile)
+void weg_t::set_private_car_routes(uint8 set, const uint32 *entries, uint32 count)
 {
+	// acquire first, as the new table may be the old one
+	const private_car_route_table_t *old_table = private_car_routes[set];
+	private_car_routes[set] = acquire_route_table(set, entries, count);
+	release_route_table(set, old_table);
+}
 
-	uint8 writing_elem=get_private_car_routes_currently_writing_element();
-	private_car_route_map::route_map_lock();
-	auto map = private_car_routes[writing_elem];
-	const uint8 map_idx = get_map_idx(next_tile);
 
-	if(!map[map_idx].contains(destination)) {
-		for(uint8 i=0;i<5;i++) {
-			if(i != map_idx && map[i].remove(destination)) {
-				break;
-			}
-		}
-		map[map_idx].insert_unique(destination);
+void weg_t::clear_private_car_routes(uint8 set)
+{
+	lock_private_car_routes();
+	FOR(vector_tpl<weg_t*>, const w, alle_wege) {
+		w->private_car_routes[set] = NULL;
 	}
+	while(  !private_car_route_tables[set].empty()  ) {
+		free(private_car_route_tables[set].remove_first());
+	}
+	private_car_destination_ids[set].clear();
+	private_car_destinations[set].clear();
+	unlock_private_car_routes();
+}
 
-	private_car_route_map::route_map_unlock();
 
-#ifdef DEBUG_PRIVATE_CAR_ROUTES
-	calc_image();
-#endif
+void weg_t::add_private_car_route(koord destination, koord3d next_tile)
+{
+	private_car_route_buffer_t buffer;
+	buffer.add(this, destination, next_tile, true);
+	buffer.flush();
 }
 
+
 uint8 weg_t::get_map_idx(const koord3d &next_tile) const {
 	const ribi_t::ribi dir = ribi_type(get_pos(), next_tile);
 	if(next_tile != koord3d::invalid) {
@@ -1850,6 +1943,24 @@ uint8 weg_t::get_map_idx(const koord3d &next_tile) const {
 	return (uint8) 4;
 }
 
+
+void weg_t::get_private_car_route_destinations(vector_tpl<koord> &destinations) const
+{
+	const uint8 set = private_car_routes_currently_reading_element;
+	const private_car_route_table_t *table = private_car_routes[set];
+	if(  table == NULL  ) {
+		return;
+	}
+	const uint32 *entries = table->get_entries();
+	for(  uint32 i = 0;  i < table->count;  i++  ) {
+		// the entries of one destination are adjacent
+		if(  i == 0  ||  (entries[i] >> 3) != (entries[i - 1] >> 3)  ) {
+			destinations.append(private_car_destinations[set][entries[i] >> 3]);
+		}
+	}
+}
+
+
 //never called
 void weg_t::delete_all_routes_from_here(bool reading_set)
 {
@@ -1857,12 +1968,11 @@ void weg_t::delete_all_routes_from_here(bool reading_set)
 
 	vector_tpl<koord> destinations_to_delete;
 
-	for(uint8 i=0;i<5;i++) {
-		auto &map = private_car_routes[routes_index][i];
-		if (!map.is_empty()) {
-			for(uint32 j=0; j<map.get_count();j++) {
-				destinations_to_delete.append(map[j]);
-			}
+	const private_car_route_table_t *table = private_car_routes[routes_index];
+	if (table) {
+		const uint32 *entries = table->get_entries();
+		for(uint32 i=0; i<table->count; i++) {
+			destinations_to_delete.append_unique(private_car_destinations[routes_index][entries[i] >> 3]);
 		}
 	}
 		FOR(vector_tpl<koord>, dest, destinations_to_delete)
@@ -1904,17 +2014,156 @@ void weg_t::delete_route_to(koord destination, bool reading_set)
 	}
 }
 
+
 //never called
 void weg_t::remove_private_car_route(koord destination, bool reading_set)
 {
 	const uint32 routes_index = reading_set ? private_car_routes_currently_reading_element : get_private_car_routes_currently_writing_element();
-	private_car_route_map::route_map_lock();
-	for(uint8 i=0;i<5;i++) {
-		if(private_car_routes[routes_index][i].remove(destination)) {
-			break;
+	lock_private_car_routes();
+	const private_car_route_table_t *table = private_car_routes[routes_index];
+	const uint32 id = private_car_destination_ids[routes_index].get(destination);
+	if(table && id) {
+		vector_tpl<uint32> remaining(table->count);
+		const uint32 *entries = table->get_entries();
+		for(uint32 i=0; i<table->count; i++) {
+			if((entries[i] >> 3) != id - 1) {
+				remaining.append(entries[i]);
+			}
+		}
+		if(remaining.get_count() != table->count) {
+			set_private_car_routes(routes_index, remaining.begin(), remaining.get_count());
 		}
 	}
-	private_car_route_map::route_map_unlock();
+	unlock_private_car_routes();
+}
+
+
+void weg_t::rdwr_private_car_routes(loadsave_t *file, uint8 set, uint8 direction)
+{
+	if(file->is_saving()) {
+		vector_tpl<koord> destinations;
+		const private_car_route_table_t *table = private_car_routes[set];
+		if(table) {
+			const uint32 *entries = table->get_entries();
+			for(uint32 i=0; i<table->count; i++) {
+				if((entries[i] & 7) == direction) {
+					destinations.append(private_car_destinations[set][entries[i] >> 3]);
+				}
+			}
+		}
+		uint32 count = destinations.get_count();
+		if(count < 2) {
+			file->rdwr_long(count);
+			if(count == 1) {
+				destinations[0].rdwr(file);
+			}
+			return;
+		}
+		// Longer lists are written once per file and referred to by index
+		// from every other tile with the same table, as in the older format:
+		// negative coords store the index and the link mode (5: master)
+		private_car_routes_saved_lists[set][direction].put(table);
+		uint32 &idx = *private_car_routes_saved_lists[set][direction].access(table);
+		const bool master = idx == 0;
+		if(master) {
+			idx = ++private_car_routes_saved_list_count;
+		}
+		count = master ? count + 2 : 2;
+		file->rdwr_long(count);
+		koord idx1, idx2;
+		idx1.x = -2;
+		idx1.y = static_cast<sint16>((idx >> 16) & 0xFFFF);
+		idx1.rdwr(file);
+		idx2.x = master ? -1 - 5 : -1 - (sint16)direction;
+		idx2.y = static_cast<sint16>(idx & 0xFFFF);
+		idx2.rdwr(file);
+		if(master) {
+			FOR(vector_tpl<koord>, dest, destinations) {
+				dest.rdwr(file);
+			}
+		}
+	}
+	else {
+		uint32 count = 0;
+		file->rdwr_long(count);
+		if(count == 1) {
+			koord dest;
+			dest.rdwr(file);
+			private_car_routes_loaded[set].add(get_pos(), dest, direction);
+		}
+		else if(count >= 2) {
+			koord idx1, idx2;
+			idx1.rdwr(file);
+			idx2.rdwr(file);
+			if(idx1.x == -2) {
+				// a list shared with other tiles, possibly stored further on in the file
+				const uint32 idx = uint32(static_cast<uint16>(idx1.y)) << 16 | uint32(static_cast<uint16>(idx2.y));
+				if(-1 - idx2.x == 5) {
+					private_car_routes_loaded_lists[set].put(idx);
+					vector_tpl<koord> &destinations = *private_car_routes_loaded_lists[set].access(idx);
+					destinations.resize(count - 2);
+					for(uint32 k=2; k<count; k++) {
+						koord dest;
+						dest.rdwr(file);
+						destinations.append(dest);
+					}
+				}
+				loaded_route_link_t link;
+				link.pos = get_pos();
+				link.idx = idx;
+				link.set = set;
+				link.direction = direction;
+				private_car_routes_loaded_links.append(link);
+			}
+			else {
+				private_car_routes_loaded[set].add(get_pos(), idx1, direction);
+				private_car_routes_loaded[set].add(get_pos(), idx2, direction);
+				for(uint32 k=2; k<count; k++) {
+					koord dest;
+					dest.rdwr(file);
+					private_car_routes_loaded[set].add(get_pos(), dest, direction);
+				}
+			}
+		}
+	}
+}
+
+
+void weg_t::private_car_routes_start_rdwr()
+{
+	for(uint8 set=0; set<2; set++) {
+		for(uint8 direction=0; direction<5; direction++) {
+			private_car_routes_saved_lists[set][direction].clear();
+		}
+		private_car_routes_loaded_lists[set].clear();
+	}
+	private_car_routes_saved_list_count = 0;
+	private_car_routes_loaded_links.clear();
+}
+
+
+void weg_t::private_car_routes_finish_rdwr(loadsave_t *file)
+{
+	if(file->is_loading()) {
+		FOR(vector_tpl<loaded_route_link_t>, const& link, private_car_routes_loaded_links) {
+			const vector_tpl<koord> *destinations = private_car_routes_loaded_lists[link.set].access(link.idx);
+			if(destinations == NULL) {
+				dbg->warning("weg_t::private_car_routes_finish_rdwr()", "Missing private car route list %u", link.idx);
+				continue;
+			}
+			FOR(vector_tpl<koord>, const dest, *destinations) {
+				private_car_routes_loaded[link.set].add(link.pos, dest, link.direction);
+			}
+			// keep the buffer small, as long lists may be shared by thousands of tiles
+			if(private_car_routes_loaded[link.set].get_count() > (1u << 20)) {
+				private_car_routes_loaded[link.set].flush(link.set);
+			}
+		}
+		for(uint8 set=0; set<2; set++) {
+			private_car_routes_loaded[set].flush(set);
+		}
+	}
+	private_car_routes_start_rdwr();
 }
 
 void weg_t::add_travel_time_update(weg_t* w, uint32 actual, uint32 ideal)
@@ -1943,15 +2192,21 @@ void weg_t::clear_travel_time_updates() {
 }
 
 koord3d weg_t::get_next_on_private_car_route_to(koord dest, bool reading_set, uint8 startdir) const {
-#ifdef NO_PRIVATE_CAR_DESTINATION_LINKING
-	startdir=0;
-#endif
-	auto map = private_car_routes[reading_set ? private_car_routes_currently_reading_element : get_private_car_routes_currently_writing_element()];
-	if(map[4].contains(dest)){
+	const uint8 set = reading_set ? private_car_routes_currently_reading_element : get_private_car_routes_currently_writing_element();
+	const private_car_route_table_t *table = private_car_routes[set];
+	if(table == NULL) {
+		return koord3d();
+	}
+	const uint32 id = private_car_destination_ids[set].get(dest);
+	if(id == 0) {
+		return koord3d();
+	}
+	const uint8 directions = table->get_directions(id - 1);
+	if(directions & (1 << 4)) {
 		return koord3d::invalid;
 	}
 	for(uint8 i=startdir; i<4+startdir; i++) {
-		if(map[i&3].contains(dest)) {
+		if(directions & (1 << (i&3))) {
 			grund_t* to;
 			if(welt->lookup(get_pos())->get_neighbour(to, waytype_t::road_wt,ribi_t::nesw[i&3])) {
 				return to->get_pos();
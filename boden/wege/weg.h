@@ -12,6 +12,8 @@
 #include <unordered_map>
 #endif
 
+#include <atomic>
+
 #include "../../display/simimg.h"
 #include "../../simtypes.h"
 #include "../../obj/simobj.h"
@@ -19,6 +21,7 @@
 #include "../../dataobj/koord3d.h"
 #include "../../tpl/minivec_tpl.h"
 #include "../../tpl/ordered_vector_tpl.h"
+#include "../../tpl/vector_tpl.h"
 #include "../../simskin.h"
 
 #ifdef MULTI_THREAD
@@ -123,7 +126,25 @@ public:
 	static void apply_travel_time_updates();
 	static void clear_travel_time_updates();
 
+	/**
+	 * Changes whenever a way is built, removed or changed in a way that
+	 * matters to the route search (directions, speed and weight limits,
+	 * constraints, signs, owner, stops and depots on it).
+	 * The routes kept by route_t are valid only for one generation.
+	 */
+	static uint32 get_network_generation() { return network_generation.load(); }
+	static void network_changed() { network_generation++; }
+
 private:
+	/// atomic, as the convoy threads may change ways too
+	static std::atomic<uint32> network_generation;
+
+	/**
+	 * Position of this way in alle_wege. The last way takes the place of
+	 * a removed one, so removal does not search or shift the list.
+	 */
+	uint32 alle_wege_index;
+
 	/**
 	* array for statistical values
 	* MAX_WAY_STAT_MONTHS: [0] = actual value; [1] = last month value
@@ -250,108 +271,105 @@ public:
 	minivec_tpl<gebaeude_t*> connected_buildings;
 
 	/**
-	 * Map of all private car routes from way
+	 * Private car routes: for each destination (townhall road, industry or
+	 * attraction) the direction in which a car leaves this tile to get there.
+	 *
+	 * The routes of a tile are kept in an immutable table of sorted entries
+	 * (destination id << 3 | direction), where direction is 0..3 for
+	 * ribi_t::nesw and 4 for "destination reached". Tables are shared: all
+	 * tiles with the same entries, typically every tile of a road between two
+	 * junctions, point to one table. Destinations are numbered densely per set.
+	 *
+	 * There are two sets: one is read while the other one is written by the
+	 * route refresh. The reading set is never modified, so lookups need no lock.
 	 */
-	class private_car_route_map{
+	class private_car_route_table_t
+	{
 	public:
-		void set_route_map_elem(uint8 elem){route_map_elem=elem;}
-
-		private_car_route_map(){link_mode=link_mode_NULL;}
-
-		void clear();
-
-		void pre_reset();
+		uint32 references;
+		uint32 count;
 
-		bool contains(koord elem) const;
-		bool insert_unique(koord elem, private_car_route_map* link_to = NULL, uint8 link_dir=0);
+		uint32 *get_entries() { return reinterpret_cast<uint32 *>(this + 1); }
+		const uint32 *get_entries() const { return reinterpret_cast<const uint32 *>(this + 1); }
 
-		koord& get_by_index(uint32_t i);
-		const koord& get_by_index(uint32_t i) const;
-
-		koord& operator [] (uint32 i);
-		const koord& operator [] (uint32 i) const ;
-
-		uint32 get_count() const ;
-		bool is_empty() const ;
-
-		bool remove(koord elem);
-		void resize(uint32 new_size);
-
-		static void reset(uint8 map_elem);
-
-		//backwards compatible saving
-		void rdwr(loadsave_t *file);
+		/// @returns a bit mask of the directions (bit 4: reached) stored for the destination id
+		uint8 get_directions(uint32 id) const;
+	};
 
-	private:
-		union {
-			uint32 idx;
-			koord single_koord;
-		};
-		uint8 link_mode:3;
-		uint8 route_map_elem:1;
-		enum link_modes {
-			link_mode_NULL=7,
-			link_mode_single=6,
-			link_mode_master=5
+	/**
+	 * Collects private car routes written by one route search, so that
+	 * the shared tables are rebuilt only once per tile and not for every
+	 * single destination.
+	 */
+	class private_car_route_buffer_t
+	{
+	public:
+		struct entry_t
+		{
+			koord3d pos;
+			koord destination;
+			uint8 direction;
+			bool exclusive; ///< removes the destination from all other directions
 		};
 
-		static vector_tpl<ordered_vector_tpl<koord,uint32> > route_maps[2];
-public:
-
-		inline sint32 get_idx() const {if(link_mode==link_mode_NULL || link_mode==link_mode_single) return -1; return idx;}
+		void add(const weg_t *w, koord destination, koord3d next_tile, bool exclusive = false);
+		void add(koord3d pos, koord destination, uint8 direction);
 
-#ifdef MULTI_THREAD
-		static pthread_mutex_t route_map_mtx;
-#endif
+		/// Merges all entries into the given set (default: the set currently written)
+		void flush(sint8 set = -1);
 
+		/**
+		 * Hands the entries over to merge_private_car_routes() instead of
+		 * merging them now. Used by searches running in parallel, so that
+		 * the merge order depends on the origins and not on thread timing.
+		 */
+		void submit(koord3d origin);
 
-		inline static void route_map_lock() {
-#ifdef MULTI_THREAD
-			int error = pthread_mutex_lock(&route_map_mtx);
-			assert(error == 0);
-			(void)error;
-#endif
-			return;
-		}
+		uint32 get_count() const { return entries.get_count(); }
 
-		inline static void route_map_unlock() {
-#ifdef MULTI_THREAD
-			int error = pthread_mutex_unlock(&route_map_mtx);
-			assert(error == 0);
-			(void)error;
-#endif
-			return;
-		}
+	private:
+		vector_tpl<entry_t> entries;
 	};
 
+private:
+	const private_car_route_table_t *private_car_routes[2];
+
+	/// Replaces the table of this tile in the given set; must be called with the route lock held
+	void set_private_car_routes(uint8 set, const uint32 *entries, uint32 count);
 
+	static void lock_private_car_routes();
+	static void unlock_private_car_routes();
 
-	// Likewise, out of caution, put this here for the same reason.
-	// n_bags must be fairly low as there are 2 maps per way and usually zero elements per way, up to ~150 in high cases and ~1500 in highest cases
-	//typedef ordered_vector_tpl<koord, uint32> private_car_route_map;
-	//typedef std::unordered_map<koord, koord3d> private_car_route_map_2;
-	private_car_route_map private_car_routes[2][5];
-	//private_car_route_map_2 private_car_routes_std[2];
+public:
 	static uint32 private_car_routes_currently_reading_element;
 	static uint32 get_private_car_routes_currently_writing_element() { return private_car_routes_currently_reading_element == 1 ? 0 : 1; }
+	static void swap_private_car_routes_currently_reading_element() { private_car_routes_currently_reading_element = private_car_routes_currently_reading_element == 0 ? 1 : 0; }
+
+	/// Drops all routes of the set. Must not be called while route searches write to it.
+	static void clear_private_car_routes(uint8 set);
 
-	static void private_car_backtrace_begin();
-	static void private_car_backtrace_end();
-	void private_car_backtrace_add(koord destination, koord3d next_tile);
-	void private_car_backtrace_inc(koord3d next_tile);
+	/// Merges all submitted routes, ordered by origin. Must not be called while route searches run.
+	static void merge_private_car_routes();
 
-	static private_car_route_map* private_car_backtrace_last_route_map;
-	static uint8 private_car_backtrace_last_idx;
+	/// Must be called before the ways are saved or loaded
+	static void private_car_routes_start_rdwr();
+	/// Must be called after all ways are saved or loaded; builds the tables read with the ways
+	static void private_car_routes_finish_rdwr(loadsave_t *file);
 
 	void add_private_car_route(koord dest, koord3d next_tile);
 	bool has_private_car_route(koord dest) const;
 	koord3d get_next_on_private_car_route_to(koord dest, bool reading_set=true, uint8 start_dir=0) const;
+
+	/// Appends all destinations with a route from here (in the reading set) to destinations
+	void get_private_car_route_destinations(vector_tpl<koord> &destinations) const;
+
 private:
 	/// Set the boolean value to true to modify the set currently used for reading (this must ONLY be done when this is called from a single threaded part of the code).
 	void remove_private_car_route(koord dest, bool reading_set = false);
-public:
-	static void swap_private_car_routes_currently_reading_element() { private_car_routes_currently_reading_element = private_car_routes_currently_reading_element == 0 ? 1 : 0; }
 
+	void rdwr_private_car_routes(loadsave_t *file, uint8 set, uint8 direction);
+
+public:
 	/// Delete all private car routes originating from or passing through this tile.
 	/// Set the boolean value to true to modify the set currently used for reading (this must ONLY be done when this is called from a single threaded part of the code).
 	void delete_all_routes_from_here(bool reading_set = false);
@@ -377,15 +395,15 @@ public:
 	 */
 	bool check_season(const bool calc_only_season_change) OVERRIDE;
 
-	void set_max_speed(sint32 s) { max_speed = s; }
+	void set_max_speed(sint32 s) { max_speed = s; network_changed(); }
 
-	void set_max_axle_load(uint32 w) { max_axle_load = w; }
-	void set_bridge_weight_limit(uint32 value) { bridge_weight_limit = value; }
+	void set_max_axle_load(uint32 w) { max_axle_load = w; network_changed(); }
+	void set_bridge_weight_limit(uint32 value) { bridge_weight_limit = value; network_changed(); }
 
 	// Resets constraints to their base values. Used when removing way objects.
-	void reset_way_constraints() { way_constraints = desc->get_way_constraints(); }
+	void reset_way_constraints() { way_constraints = desc->get_way_constraints(); network_changed(); }
 
-	void clear_way_constraints() { way_constraints.set_permissive(0); way_constraints.set_prohibitive(0); }
+	void clear_way_constraints() { way_constraints.set_permissive(0); way_constraints.set_prohibitive(0); network_changed(); }
 
 	/* Way constraints: determines whether vehicles
 	 * can travel on this way. This method decodes
@@ -396,8 +414,8 @@ public:
 	 * */
 
 	const way_constraints_of_way_t& get_way_constraints() const { return way_constraints; }
-	void add_way_constraints(const way_constraints_of_way_t& value) { way_constraints.add(value); }
-	void remove_way_constraints(const way_constraints_of_way_t& value) { way_constraints.remove(value); }
+	void add_way_constraints(const way_constraints_of_way_t& value) { way_constraints.add(value); network_changed(); }
+	void remove_way_constraints(const way_constraints_of_way_t& value) { way_constraints.remove(value); network_changed(); }
 
 	// Convoys that do not require electrification can ignore speed limit by electrification
 	sint32 get_max_speed(bool needs_electrification = false) const;
@@ -448,7 +466,7 @@ public:
 	* @note After changing of ribi the image of the way is wrong. To correct this,
 	* grund_t::calc_image needs to be called. This is not done here (Too expensive).
 	*/
-	void ribi_add(ribi_t::ribi ribi) { this->ribi |= (uint8)ribi;}
+	void ribi_add(ribi_t::ribi ribi) { this->ribi |= (uint8)ribi; network_changed(); }
 
 	/**
 	* Remove direction bits (ribi) for a way.
@@ -456,7 +474,7 @@ public:
 	* @note After changing of ribi the image of the way is wrong. To correct this,
 	* grund_t::calc_image needs to be called. This is not done here (Too expensive).
 	*/
-	void ribi_rem(ribi_t::ribi ribi) { this->ribi &= (uint8)~ribi;}
+	void ribi_rem(ribi_t::ribi ribi) { this->ribi &= (uint8)~ribi; network_changed(); }
 
 	/**
 	* Set direction bits (ribi) for the way.
@@ -464,7 +482,7 @@ public:
 	* @note After changing of ribi the image of the way is wrong. To correct this,
 	* grund_t::calc_image needs to be called. This is not done here (Too expensive).
 	*/
-	void set_ribi(ribi_t::ribi ribi) { this->ribi = (uint8)ribi;}
+	void set_ribi(ribi_t::ribi ribi) { this->ribi = (uint8)ribi; network_changed(); }
 
 	/**
 	* Get the unmasked direction bits (ribi) for the way (without signals or other ribi changer).
@@ -480,7 +498,7 @@ public:
 	* For signals it is necessary to mask out certain ribi to prevent vehicles
 	* from driving the wrong way (e.g. oneway roads)
 	*/
-	void set_ribi_maske(ribi_t::ribi ribi) { ribi_maske = (uint8)ribi; }
+	void set_ribi_maske(ribi_t::ribi ribi) { ribi_maske = (uint8)ribi; network_changed(); }
 	ribi_t::ribi get_ribi_maske() const { return (ribi_t::ribi)ribi_maske; }
 
 	/**
@@ -514,7 +532,7 @@ public:
 	void set_gehweg(const bool yesno) { flags = (yesno ? flags | HAS_SIDEWALK : flags & ~HAS_SIDEWALK); }
 	inline bool hat_gehweg() const { return flags & HAS_SIDEWALK; }
 
-	void set_electrify(bool janein) {janein ? flags |= IS_ELECTRIFIED : flags &= ~IS_ELECTRIFIED;}
+	void set_electrify(bool janein) {janein ? flags |= IS_ELECTRIFIED : flags &= ~IS_ELECTRIFIED; network_changed(); }
 	inline bool is_electrified() const {return flags&IS_ELECTRIFIED; }
 
 	inline bool has_sign() const {return flags&HAS_SIGN; }
@@ -547,7 +565,7 @@ public:
 	bool should_city_adopt_this(const player_t* player);
 
 	bool is_public_right_of_way() const { return public_right_of_way; }
-	void set_public_right_of_way(bool arg=true) { public_right_of_way = arg; }
+	void set_public_right_of_way(bool arg=true) { public_right_of_way = arg; network_changed(); }
 
 	bool is_degraded() const { return degraded; }
 
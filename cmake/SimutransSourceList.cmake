@@ -200,6 +200,7 @@ target_sources(simutrans-extended PRIVATE
 	gui/pier_rotation_select.cc
 	gui/player_frame_t.cc
 	gui/privatesign_info.cc
+	gui/profiler_frame.cc
 	gui/replace_frame.cc
 	gui/savegame_frame.cc
 	gui/scenario_frame.cc
@@ -228,13 +229,16 @@ target_sources(simutrans-extended PRIVATE
 	gui/water_info.cc
 	gui/way_info.cc
 	gui/welt.cc
+	halt_cargo.cc
 	io/raw_image.cc
 	io/raw_image_bmp.cc
 	io/raw_image_png.cc
 	io/raw_image_ppm.cc
 	io/rdwr/adler32_stream.cc
 	io/rdwr/bzip2_file_rdwr_stream.cc
+	io/rdwr/chunked_file_rdwr_stream.cc
 	io/rdwr/compare_file_rd_stream.cc
+	io/rdwr/memory_rdwr_stream.cc
 	io/rdwr/raw_file_rdwr_stream.cc
 	io/rdwr/rdwr_stream.cc
 	io/rdwr/zlib_file_rdwr_stream.cc
@@ -357,6 +361,7 @@ target_sources(simutrans-extended PRIVATE
 	utils/csv.cc
 	utils/float32e8_t.cc
 	utils/log.cc
+	utils/simprofiler.cc
 	utils/searchfolder.cc
 	utils/sha1.cc
 	utils/simrandom.cc
@@ -139,6 +139,7 @@ sint32 env_t::intercity_road_length;
 plainstring env_t::river_type[10];
 uint8 env_t::river_types;
 sint32 env_t::autosave;
+bool env_t::background_save;
 uint32 env_t::fps;
 uint32 env_t::ff_fps;
 sint16 env_t::max_acceleration;
@@ -162,6 +163,8 @@ bool env_t::cities_ignore_height = false;
 bool env_t::second_open_closes_win;
 bool env_t::remember_window_positions;
 uint8 env_t::num_threads;
+bool env_t::parallel_sync_step;
+uint32 env_t::image_cache_size;
 bool env_t::draw_earth_border;
 bool env_t::draw_outside_tile;
 
@@ -275,6 +278,7 @@ void env_t::init()
 
 	// autosave every x months (0=off)
 	autosave = 0;
+	background_save = false;
 
 	reload_and_save_on_quit = true;
 
@@ -290,6 +294,8 @@ void env_t::init()
 #else
 	num_threads = 1;
 #endif
+	parallel_sync_step = false;
+	image_cache_size = 512;
 
 	sound_distance_scaling = 10;
 
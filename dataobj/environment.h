@@ -431,6 +431,19 @@ public:
 	/// number of threads to use (if MULTI_THREAD defined)
 	static uint8 num_threads;
 
+	/**
+	 * Move private cars and pedestrians within their tiles in parallel.
+	 * This changes the order of the sync steps, hence it is ignored in network games.
+	 */
+	static bool parallel_sync_step;
+
+	/**
+	 * Memory in MiB for the zoomed and recoloured images. Images not drawn
+	 * recently are freed above this and recoloured again when needed.
+	 * 0 for no limit.
+	 */
+	static uint32 image_cache_size;
+
 	/// false to quit the programs
 	static bool quit_simutrans;
 
@@ -481,6 +494,9 @@ public:
 	/// do autosave every month?
 	static sint32 autosave;
 
+	/// write autosaves from a copy of the process while the game goes on (not on Windows)
+	static bool background_save;
+
 
 	/**
 	 * @name Midi/sound options
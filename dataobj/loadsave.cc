@@ -21,6 +21,8 @@
 #include "../utils/simstring.h"
 
 #include "../io/rdwr/bzip2_file_rdwr_stream.h"
+#include "../io/rdwr/chunked_file_rdwr_stream.h"
+#include "../io/rdwr/memory_rdwr_stream.h"
 #include "../io/rdwr/raw_file_rdwr_stream.h"
 #include "../io/rdwr/zlib_file_rdwr_stream.h"
 #if USE_ZSTD
@@ -288,17 +290,10 @@ loadsave_t::file_status_t loadsave_t::rd_open(const char *filename_utf8)
 		dbg->warning("loadsave_t::rd_open", "File '%s' does not exist or is not accessible", filename_utf8);
 		return FILE_STATUS_ERR_NOT_EXISTING;
 	}
-	else if(  finfo.ext_version.version == INVALID_FILE_VERSION  ) {
-		return FILE_STATUS_ERR_NO_VERSION;
-	}
-	else if(  finfo.ext_version.version > (SIM_VERSION_MAJOR*1000 + SIM_SERVER_MINOR)  ) {
-		/*
-		 * Reading future versions will almost certainly lead to exceptions; so we close here.
-		 * It would be nice to give a detailed message what failed (like the fatal error does)
-		 * But this error may happening also in regular installations after running a nighly
-		 * so we just record the failure.
-		 */
-		return FILE_STATUS_ERR_FUTURE_VERSION;
+
+	const file_status_t version_status = check_version();
+	if(  version_status != FILE_STATUS_OK  ) {
+		return version_status;
 	}
 
 	// now open the file
@@ -318,6 +313,13 @@ loadsave_t::file_status_t loadsave_t::rd_open(const char *filename_utf8)
 			return FILE_STATUS_ERR_UNSUPPORTED_COMPRESSION;
 #endif
 
+		case file_info_t::TYPE_XML_CHUNKED:
+			mode = xml;
+			// fallthrough
+		case file_info_t::TYPE_CHUNKED:
+			mode |= chunked;
+			stream = new chunked_file_rdwr_stream_t(filename_utf8, false, 0); break;
+
 		case file_info_t::TYPE_XML_BZIP2:
 			mode = xml;
 			// fallthrough
@@ -353,6 +355,53 @@ loadsave_t::file_status_t loadsave_t::rd_open(const char *filename_utf8)
 		return FILE_STATUS_ERR_NOT_EXISTING;
 	}
 
+	return read_header();
+}
+
+
+loadsave_t::file_status_t loadsave_t::rd_open_memory(const std::string &data)
+{
+	close();
+
+	memory_rdwr_stream_t header_stream(data.data(), data.size());
+	finfo = file_info_t(file_info_t::TYPE_RAW);
+	if(  !classify_file_data(&header_stream, &finfo)  ) {
+		return FILE_STATUS_ERR_NO_VERSION;
+	}
+
+	const file_status_t version_status = check_version();
+	if(  version_status != FILE_STATUS_OK  ) {
+		return version_status;
+	}
+
+	assert(stream == NULL);
+	mode = (finfo.file_type & file_info_t::TYPE_XML) ? xml : binary;
+	stream = new memory_rdwr_stream_t(data.data(), data.size());
+
+	return read_header();
+}
+
+
+loadsave_t::file_status_t loadsave_t::check_version() const
+{
+	if(  finfo.ext_version.version == INVALID_FILE_VERSION  ) {
+		return FILE_STATUS_ERR_NO_VERSION;
+	}
+	else if(  finfo.ext_version.version > (SIM_VERSION_MAJOR*1000 + SIM_SERVER_MINOR)  ) {
+		/*
+		 * Reading future versions will almost certainly lead to exceptions; so we close here.
+		 * It would be nice to give a detailed message what failed (like the fatal error does)
+		 * But this error may happening also in regular installations after running a nighly
+		 * so we just record the failure.
+		 */
+		return FILE_STATUS_ERR_FUTURE_VERSION;
+	}
+	return FILE_STATUS_OK;
+}
+
+
+loadsave_t::file_status_t loadsave_t::read_header()
+{
 	// skip header
 	size_t header_size = finfo.header_size;
 
@@ -420,6 +469,7 @@ loadsave_t::file_status_t loadsave_t::wr_open( const char *filename_utf8, mode_t
 #if USE_ZSTD
 		case zstd: stream = new zstd_file_rdwr_stream_t(filename_utf8, true, level); break;
 #endif
+		case chunked: stream = new chunked_file_rdwr_stream_t(filename_utf8, true, level); break;
 		case bzip2:  stream = new bzip2_file_rdwr_stream_t(filename_utf8, true);       break;
 		case zipped: stream = new zlib_file_rdwr_stream_t(filename_utf8, true, level); break;
 		case binary: stream = new raw_file_rdwr_stream_t(filename_utf8, true);         break;
@@ -433,6 +483,46 @@ loadsave_t::file_status_t loadsave_t::wr_open( const char *filename_utf8, mode_t
 		return (stream->get_status() == rdwr_stream_t::STATUS_ERR_NOT_EXISTING) ? FILE_STATUS_ERR_NOT_EXISTING : FILE_STATUS_ERR_CORRUPT;
 	}
 
+	return write_header( pak_extension, savegame_version, savegame_version_ex );
+}
+
+
+loadsave_t::file_status_t loadsave_t::wr_open_memory( std::string &data, const char *pak_extension,
+	const char *savegame_version, const char *savegame_version_ex, const char * )
+{
+	mode = binary;
+	close();
+
+	assert(stream == NULL);
+	stream = new memory_rdwr_stream_t(data);
+
+	return write_header( pak_extension, savegame_version, savegame_version_ex );
+}
+
+
+bool loadsave_t::zip_memory(const std::string &data, std::string &zipped)
+{
+	z_stream zs;
+	memset( &zs, 0, sizeof(zs) );
+	// 15+16: with gzip header, like gzopen() writes it
+	if(  deflateInit2( &zs, autosave_level, Z_DEFLATED, 15+16, 8, Z_DEFAULT_STRATEGY ) != Z_OK  ) {
+		return false;
+	}
+	zipped.resize( deflateBound( &zs, (uLong)data.size() ) );
+	zs.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+	zs.avail_in  = (uInt)data.size();
+	zs.next_out  = (Bytef *)&zipped[0];
+	zs.avail_out = (uInt)zipped.size();
+
+	const int res = deflate( &zs, Z_FINISH );
+	zipped.resize( zs.total_out );
+	deflateEnd( &zs );
+	return res == Z_STREAM_END;
+}
+
+
+loadsave_t::file_status_t loadsave_t::write_header(const char *pak_extension, const char *savegame_version, const char *savegame_version_ex)
+{
 	set_buffered( true );
 
 	// get the right extension
@@ -514,6 +604,11 @@ const char *loadsave_t::close()
 		set_buffered(false);
 	}
 
+	if(  stream->is_writing()  ) {
+		// write the trailers now, the destructor could not report errors
+		stream->finish();
+	}
+
 	const char *errmsg = NULL;
 
 	switch (stream->get_status()) {
@@ -44,9 +44,11 @@ public:
 		zipped     = 1 << 2,
 		bzip2      = 1 << 3,
 		zstd       = 1 << 4,
+		chunked    = 1 << 5, ///< zlib compressed blocks, (de)compressed by all threads
 		xml_zipped = xml | zipped,
 		xml_bzip2  = xml | bzip2,
-		xml_zstd   = xml | zstd
+		xml_zstd   = xml | zstd,
+		xml_chunked = xml | chunked
 	};
 
 	enum file_status_t {
@@ -99,6 +101,15 @@ protected:
 
 	bool is_xml() const { return mode&xml; }
 
+	/// checks the version of a savegame about to be read
+	file_status_t check_version() const;
+
+	/// skips the header of a savegame about to be read from stream
+	file_status_t read_header();
+
+	/// writes the header of a savegame to the freshly opened stream
+	file_status_t write_header(const char *pak_extension, const char *savegame_version, const char *savegame_version_ex);
+
 public:
 	static mode_t save_mode;     ///< default to use for saving
 	static mode_t autosave_mode; ///< default to use for autosaves and network mode client temp saves
@@ -120,6 +131,25 @@ public:
 
 	file_status_t rd_open(const char *filename);
 	file_status_t wr_open(const char *filename, mode_t mode, int level, const char *pak_extension, const char *savegame_version, const char *savegame_version_ex, const char *savegame_revision_ex);
+
+	/**
+	 * Reads an uncompressed savegame from memory instead of a file.
+	 * @p data must not change until the file is closed.
+	 */
+	file_status_t rd_open_memory(const std::string &data);
+
+	/**
+	 * Writes an uncompressed binary savegame to memory instead of a file.
+	 * Everything written is appended to @p data, it is complete after close().
+	 */
+	file_status_t wr_open_memory(std::string &data, const char *pak_extension, const char *savegame_version, const char *savegame_version_ex, const char *savegame_revision_ex);
+
+	/**
+	 * Compresses an uncompressed savegame from memory with gzip at autosave_level,
+	 * so the result reads like a zipped savegame file.
+	 * @return false on error
+	 */
+	static bool zip_memory(const std::string &data, std::string &zipped);
 	const char *close();
 
 	static void set_savemode(mode_t mode) { save_mode = mode; }
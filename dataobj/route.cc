@@ -482,6 +482,9 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 	}
 
 	uint32 private_car_route_step_counter = 0;
+	// The routes found are collected here. The main thread merges them into the route tables
+	// of the ways in a fixed order, so that checking several cities at once is deterministic.
+	weg_t::private_car_route_buffer_t private_car_routes;
 
 	fixed_list_tpl<koord, 8> destinations_already_processed; // We use a fixed list because alomst inevitably with a Dikejstra search, finding another tile of the same destination will be shortly after the last one.
 
@@ -706,7 +709,6 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 				koord3d previous = koord3d::invalid;
 				weg_t* w;
 				if(fresh_destination && tmp != NULL){
-					weg_t::private_car_backtrace_begin();
 					while (fresh_destination && tmp != NULL)
 					{
 						private_car_route_step_counter++;
@@ -721,19 +723,18 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 
 							if (industry_destination_pos != koord::invalid)
 							{
-								w->private_car_backtrace_add(industry_destination_pos, previous);
+								private_car_routes.add(w, industry_destination_pos, previous);
 							}
 
 							if (attraction_destination_pos != koord::invalid)
 							{
-								w->private_car_backtrace_add(attraction_destination_pos, previous);
+								private_car_routes.add(w, attraction_destination_pos, previous);
 							}
 
 							if (city_destination_pos != koord::invalid)
 							{
-								w->private_car_backtrace_add(city_destination_pos, previous);
+								private_car_routes.add(w, city_destination_pos, previous);
 							}
-							w->private_car_backtrace_inc(previous);
 						}
 
 						// Old route storage - we probably no longer need this.
@@ -742,7 +743,11 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 						previous = tmp->gr->get_pos();
 						tmp = tmp->parent;
 					}
-					weg_t::private_car_backtrace_end();
+					if (private_car_routes.get_count() >= (1u << 20))
+					{
+						// Do not let the buffer grow without limit on very large maps
+						private_car_routes.submit(start);
+					}
 				}
 #ifdef MULTI_THREAD
 				uint32 max_steps;
@@ -760,6 +765,9 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 					// Halt this mid step if there are too many routes being calculated so as not to make the game unresponsive.
 					// On a Ryzen 3900x, calculating all routes from one city on a 600 city map can take ~4 seconds.
 
+					// Hand over the routes found so far: the world may change while this waits.
+					private_car_routes.submit(start);
+
 					// It is intentional to have two barriers here.
 					simthread_barrier_wait(&karte_t::private_car_barrier);
 					if (!suspend_private_car_routing)
@@ -931,6 +939,7 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 		}
 //		ok = !route.empty();
 	}
+	private_car_routes.submit(start);
 	if (origin_city)
 	{
 		origin_city->set_private_car_route_finding_in_progress(false);
@@ -958,6 +967,156 @@ ribi_t::ribi *get_next_dirs(const koord3d& gr_pos, const koord3d& ziel)
 }
 
 
+bool route_t::can_enter_tile(karte_t *welt, const grund_t *to, ribi_t::ribi dir, test_driver_t *tdriver, uint8 enforce_weight_limits, uint32 axle_load, uint32 convoy_weight, sint32 tile_length, bool is_tall, sint32 &bridge_tile_count, sint32 &is_overweight)
+{
+	// Do not go on a tile where a one way sign forbids going.
+	// This saves time and fixed the bug in which a oneway sign on the final tile was ignored.
+	weg_t *w = to->get_weg(tdriver->get_waytype());
+	ribi_t::ribi go_dir = (w == NULL) ? 0 : w->get_ribi_maske();
+	if ((dir&go_dir) != 0)
+	{
+		if (tdriver->get_waytype() == track_wt || tdriver->get_waytype() == narrowgauge_wt || tdriver->get_waytype() == maglev_wt || tdriver->get_waytype() == tram_wt || tdriver->get_waytype() == monorail_wt)
+		{
+			// Unidirectional signals allow routing in both directions but only act in one direction. Check whether this is one of those.
+			if (!w->has_signal())
+			{
+				return false;
+			}
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	// Low bridges
+	if (is_tall && to->is_height_restricted())
+	{
+		return false;
+	}
+
+	// Weight limits
+	is_overweight = not_overweight;
+	if (enforce_weight_limits > 0 && w != NULL)
+	{
+		// Bernd Gabriel, Mar 10, 2010: way limit info
+		if (to->ist_bruecke() || w->get_desc()->get_styp() == type_elevated || w->get_waytype() == air_wt || w->get_waytype() == water_wt)
+		{
+			// Bridges care about convoy weight, whereas other types of way
+			// care about axle weight.
+			bridge_tile_count++;
+
+			// This is actually maximum convoy weight: the name is odd because of the virtual method.
+			uint32 way_max_convoy_weight;
+
+			// Trams need to check the weight of the underlying bridge.
+
+			if (w->get_desc()->get_styp() == type_tram)
+			{
+				const weg_t* underlying_bridge = welt->lookup(w->get_pos())->get_weg(road_wt);
+				if (!underlying_bridge)
+				{
+					goto check_axle_load;
+				}
+				way_max_convoy_weight = underlying_bridge->get_bridge_weight_limit();
+
+			}
+			else
+			{
+				way_max_convoy_weight = w->get_bridge_weight_limit();
+			}
+
+			// This ensures that only that part of the convoy that is actually on the bridge counts.
+			const sint32 proper_tile_length = tile_length > 8888 ? tile_length - 8888 : tile_length;
+			uint32 adjusted_convoy_weight = tile_length == 0 ? convoy_weight : (convoy_weight * max(bridge_tile_count - 2, 1)) / proper_tile_length;
+			const uint32 min_weight = min(adjusted_convoy_weight, convoy_weight);
+			if (min_weight > way_max_convoy_weight)
+			{
+				switch (enforce_weight_limits)
+				{
+				case 1:
+				default:
+
+					is_overweight = slowly_only;
+					break;
+
+				case 2:
+
+					is_overweight = cannot_route;
+					break;
+
+				case 3:
+
+					is_overweight = way_max_convoy_weight == 0 || (min_weight * 100) / way_max_convoy_weight > 110 ? cannot_route : slowly_only;
+					break;
+				}
+			}
+			if (to->ist_bruecke())
+			{
+				// For a real bridge, also check the axle load of the underlying way.
+				goto check_axle_load;
+			}
+		}
+		else
+		{
+		check_axle_load:
+			bridge_tile_count = 0;
+			const uint32 way_max_axle_load = w->get_max_axle_load();
+			max_axle_load = std::min(max_axle_load, way_max_axle_load);
+			if (axle_load > way_max_axle_load)
+			{
+				switch (enforce_weight_limits)
+				{
+				case 1:
+				default:
+
+					is_overweight = slowly_only;
+					break;
+
+				case 2:
+
+					is_overweight = cannot_route;
+					break;
+
+				case 3:
+
+					is_overweight = way_max_axle_load == 0 || (axle_load * 100) / way_max_axle_load > 110 ? cannot_route : slowly_only;
+					break;
+				}
+			}
+		}
+
+		if (is_overweight == cannot_route)
+		{
+			// Avoid routing over ways for which the convoy is overweight.
+			return false;
+		}
+
+	}
+	return true;
+}
+
+
+/**
+ * A tile which is left by the way in only one direction (apart from the one
+ * we came from), and without anything on it which could end or divert a
+ * route: no signal or sign, no stop and no depot.
+ * @return the direction to leave such a tile, or ribi_t::none for other tiles
+ */
+static ribi_t::ribi get_corridor_ribi(const grund_t *gr, test_driver_t *tdriver, ribi_t::ribi ribi_from)
+{
+	const weg_t *w = gr->get_weg(tdriver->get_waytype());
+	if(  w == NULL  ||  w->has_signal()  ||  w->has_sign()  ) {
+		return ribi_t::none;
+	}
+	const ribi_t::ribi onward = tdriver->get_ribi(gr) & ~ribi_t::reverse_single(ribi_from);
+	if(  !ribi_t::is_single(onward)  ||  gr->is_halt()  ||  gr->get_depot()  ) {
+		return ribi_t::none;
+	}
+	return onward;
+}
+
+
 route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d start, const koord3d ziel, test_driver_t* const tdriver, const sint32 max_speed, const sint64 max_cost, const uint32 axle_load, const uint32 convoy_weight, bool is_tall, const sint32 tile_length, koord3d avoid_tile, uint8 start_dir, find_route_flags flags)
 {
 	route_result_t ok = no_route;
@@ -997,6 +1156,10 @@ route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d
 	const bool use_jps     = tdriver->get_waytype()==water_wt;
 	//const bool use_jps     = false;
 
+	// Contracting the stretches between junctions does not fit jump point search,
+	// and start_dir restricts every step.
+	const bool contract_corridors = !is_airplane  &&  !use_jps  &&  start_dir == ribi_t::all;
+
 	bool ziel_erreicht=false;
 
 	// memory in static list ...
@@ -1027,6 +1190,7 @@ route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d
 	tmp->dir = 0;
 	tmp->count = 0;
 	tmp->ribi_from = ribi_t::none;
+	tmp->first_ribi = ribi_t::none;
 	tmp->jps_ribi  = ribi_t::all;
 
 	// nothing in lists
@@ -1112,130 +1276,10 @@ route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d
 
 			// a way goes here, and it is not marked (i.e. in the closed list)
 			if((to  ||  gr->get_neighbour(to, wegtyp, next_ribi[r]))  &&  tdriver->check_next_tile(to)  &&  !marker.is_marked(to)) {
-				// Do not go on a tile where a one way sign forbids going.
-				// This saves time and fixed the bug in which a oneway sign on the final tile was ignored.
-				ribi_t::ribi last_dir = next_ribi[r];
 				weg_t *w = to->get_weg(wegtyp);
-				ribi_t::ribi go_dir = (w == NULL) ? 0 : w->get_ribi_maske();
-				if ((last_dir&go_dir) != 0)
-				{
-					if (tdriver->get_waytype() == track_wt || tdriver->get_waytype() == narrowgauge_wt || tdriver->get_waytype() == maglev_wt || tdriver->get_waytype() == tram_wt || tdriver->get_waytype() == monorail_wt)
-					{
-						// Unidirectional signals allow routing in both directions but only act in one direction. Check whether this is one of those.
-						if (!w->has_signal())
-						{
-							continue;
-						}
-					}
-					else
-					{
-						continue;
-					}
-				}
-
-				// Low bridges
-				if (is_tall && to->is_height_restricted())
-				{
-					continue;
-				}
-
-				// Weight limits
 				sint32 is_overweight = not_overweight;
-				if (enforce_weight_limits > 0 && w != NULL)
-				{
-					// Bernd Gabriel, Mar 10, 2010: way limit info
-					if (to->ist_bruecke() || w->get_desc()->get_styp() == type_elevated || w->get_waytype() == air_wt || w->get_waytype() == water_wt)
-					{
-						// Bridges care about convoy weight, whereas other types of way
-						// care about axle weight.
-						bridge_tile_count++;
-
-						// This is actually maximum convoy weight: the name is odd because of the virtual method.
-						uint32 way_max_convoy_weight;
-
-						// Trams need to check the weight of the underlying bridge.
-
-						if (w->get_desc()->get_styp() == type_tram)
-						{
-							const weg_t* underlying_bridge = welt->lookup(w->get_pos())->get_weg(road_wt);
-							if (!underlying_bridge)
-							{
-								goto check_axle_load;
-							}
-							way_max_convoy_weight = underlying_bridge->get_bridge_weight_limit();
-
-						}
-						else
-						{
-							way_max_convoy_weight = w->get_bridge_weight_limit();
-						}
-
-						// This ensures that only that part of the convoy that is actually on the bridge counts.
-						const sint32 proper_tile_length = tile_length > 8888 ? tile_length - 8888 : tile_length;
-						uint32 adjusted_convoy_weight = tile_length == 0 ? convoy_weight : (convoy_weight * max(bridge_tile_count - 2, 1)) / proper_tile_length;
-						const uint32 min_weight = min(adjusted_convoy_weight, convoy_weight);
-						if (min_weight > way_max_convoy_weight)
-						{
-							switch (enforce_weight_limits)
-							{
-							case 1:
-							default:
-
-								is_overweight = slowly_only;
-								break;
-
-							case 2:
-
-								is_overweight = cannot_route;
-								break;
-
-							case 3:
-
-								is_overweight = way_max_convoy_weight == 0 || (min_weight * 100) / way_max_convoy_weight > 110 ? cannot_route : slowly_only;
-								break;
-							}
-						}
-						if (to->ist_bruecke())
-						{
-							// For a real bridge, also check the axle load of the underlying way.
-							goto check_axle_load;
-						}
-					}
-					else
-					{
-					check_axle_load:
-						bridge_tile_count = 0;
-						const uint32 way_max_axle_load = w->get_max_axle_load();
-						max_axle_load = std::min(max_axle_load, way_max_axle_load);
-						if (axle_load > way_max_axle_load)
-						{
-							switch (enforce_weight_limits)
-							{
-							case 1:
-							default:
-
-								is_overweight = slowly_only;
-								break;
-
-							case 2:
-
-								is_overweight = cannot_route;
-								break;
-
-							case 3:
-
-								is_overweight = way_max_axle_load == 0 || (axle_load * 100) / way_max_axle_load > 110 ? cannot_route : slowly_only;
-								break;
-							}
-						}
-					}
-
-					if (is_overweight == cannot_route)
-					{
-						// Avoid routing over ways for which the convoy is overweight.
-						continue;
-					}
-
+				if(  !can_enter_tile(welt, to, next_ribi[r], tdriver, enforce_weight_limits, axle_load, convoy_weight, tile_length, is_tall, bridge_tile_count, is_overweight)  ) {
+					continue;
 				}
 
 				// new values for cost g (without way it is either in the air or in water => no costs)
@@ -1264,6 +1308,53 @@ route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d
 					current_dir = next_ribi[r];
 				}
 
+				// Only junctions, signals, stops and depots become nodes of the search:
+				// from there follow the way as long as it does not branch. The tiles
+				// passed are put back in when the route is constructed.
+				uint32 count = tmp->count + 1;
+				ribi_t::ribi ribi_from = next_ribi[r];
+				if(  contract_corridors  ) {
+					uint8 last_dir = tmp->dir;
+					bool has_grandparent = tmp->parent != NULL;
+					ribi_t::ribi onward;
+					// (the length of a route must fit into ANode::count)
+					while(  to->get_pos() != ziel  &&  count < 0xFFFF  &&  (onward = get_corridor_ribi(to, tdriver, ribi_from)) != ribi_t::none  ) {
+						grund_t *next = NULL;
+						sint32 next_overweight = not_overweight;
+						if(  !to->get_neighbour(next, wegtyp, onward)  ||  !tdriver->check_next_tile(next)  ||  marker.is_marked(next)  ||
+							!can_enter_tile(welt, next, onward, tdriver, enforce_weight_limits, axle_load, convoy_weight, tile_length, is_tall, bridge_tile_count, next_overweight)  ) {
+							// dead end, or back where we have already been
+							to = NULL;
+							break;
+						}
+
+						// same costs as for a step from a node
+						new_g += flags == simple_cost ? 1 : tdriver->get_cost(next, max_speed, to->get_pos().get_2d()) + (next_overweight == slowly_only ? 400 : 0);
+						uint8 next_dir = onward;
+						if(  flags != simple_cost  ) {
+							next_dir = onward | ribi_from;
+							if(  current_dir != next_dir  ) {
+								new_g += 30;
+								if(  last_dir != current_dir  &&  has_grandparent  ) {
+									new_g += 10;
+								}
+								else if(  ribi_t::is_perpendicular(current_dir, next_dir)  ) {
+									new_g += 25;
+								}
+							}
+						}
+						last_dir = current_dir;
+						current_dir = next_dir;
+						has_grandparent = true;
+						ribi_from = onward;
+						to = next;
+						count++;
+					}
+					if(  to == NULL  ) {
+						continue;
+					}
+				}
+
 				uint32 dist = calc_distance( to->get_pos(), ziel );
 
 				best_distance = (dist < best_distance) ? dist : best_distance;
@@ -1290,7 +1381,7 @@ route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d
 				// take height difference into account when calculating distance
 				uint32 costup = 0;
 				if (cost_upslope) {
-					costup = cost_upslope * max(ziel.z - to->get_vmove(next_ribi[r]), 0);
+					costup = cost_upslope * max(ziel.z - to->get_vmove(ribi_from), 0);
 				}
 
 				const uint32 new_f = (new_g + dist + turns * 3 + costup) * 10;
@@ -1306,8 +1397,9 @@ route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d
 				k->g = new_g;
 				k->f = new_f;
 				k->dir = current_dir;
-				k->ribi_from = next_ribi[r];
-				k->count = tmp->count+1;
+				k->ribi_from = ribi_from;
+				k->first_ribi = next_ribi[r];
+				k->count = count;
 				k->jps_ribi = ribi_t::all;
 
 				if (use_jps  &&  to->is_water()) {
@@ -1371,6 +1463,18 @@ route_t::route_result_t route_t::intern_calc_route(karte_t *welt, const koord3d
 			}
 #endif
 			route[ tmp->count ] = tmp->gr->get_pos();
+			if(  tmp->parent != NULL  &&  tmp->count > tmp->parent->count + 1  ) {
+				// the tiles of a contracted stretch
+				const grund_t *from = tmp->parent->gr;
+				ribi_t::ribi dir = tmp->first_ribi;
+				for(  uint32 i = tmp->parent->count + 1;  i < tmp->count;  i++  ) {
+					grund_t *next = NULL;
+					from->get_neighbour( next, wegtyp, dir );
+					route[i] = next->get_pos();
+					dir = get_corridor_ribi( next, tdriver, dir );
+					from = next;
+				}
+			}
 			tmp = tmp->parent;
 		}
 		if (use_jps  &&  tdriver->get_waytype()==water_wt) {
@@ -1490,11 +1594,133 @@ void route_t::postprocess_water_route(karte_t *welt)
 
 
 
+// number of routes kept by calc_route(); a new route replaces the one in its slot
+#define ROUTE_CACHE_SIZE (1024)
+
+struct route_cache_entry_t
+{
+	uint32 generation; ///< weg_t::get_network_generation() when found, 0 for unused entries
+	koord3d start;
+	koord3d ziel;
+	uint64 driver_key;
+	sint32 max_khm;
+	uint32 axle_load;
+	uint32 convoy_weight;
+	sint32 max_len;
+	uint8 waytype;
+	bool is_tall;
+
+	route_t::route_result_t result;
+	uint32 max_axle_load;
+	koord3d_vector_t route;
+
+	bool is_same_search(const route_cache_entry_t &e) const
+	{
+		return start == e.start  &&  ziel == e.ziel  &&  driver_key == e.driver_key  &&  max_khm == e.max_khm  &&  axle_load == e.axle_load  &&
+			convoy_weight == e.convoy_weight  &&  max_len == e.max_len  &&  waytype == e.waytype  &&  is_tall == e.is_tall;
+	}
+
+	uint32 get_slot() const
+	{
+		uint32 h = (uint32)driver_key ^ (uint32)(driver_key >> 32);
+		h = h * 31 + start.x;
+		h = h * 31 + start.y;
+		h = h * 31 + (uint8)start.z;
+		h = h * 31 + ziel.x;
+		h = h * 31 + ziel.y;
+		h = h * 31 + (uint8)ziel.z;
+		h = h * 31 + axle_load;
+		h = h * 31 + convoy_weight;
+		h = h * 31 + (uint32)max_khm;
+		h = h * 31 + (uint32)max_len;
+		return (h * 0x9E3779B1u) >> 22; // ROUTE_CACHE_SIZE = 2^10 slots
+	}
+};
+
+static route_cache_entry_t route_cache[ROUTE_CACHE_SIZE];
+
+#ifdef MULTI_THREAD
+// convoys search routes in parallel
+static pthread_mutex_t route_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+void route_t::clear_cache()
+{
+	for(  uint32 i = 0;  i < ROUTE_CACHE_SIZE;  i++  ) {
+		route_cache[i].generation = 0;
+		route_cache[i].route.clear();
+	}
+}
+
+
+route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d start, const koord3d ziel, test_driver_t* const tdriver, const sint32 max_khm, const uint32 axle_load, bool is_tall, sint32 max_len, const sint64 max_cost, const uint32 convoy_weight, koord3d avoid_tile, uint8 direction, find_route_flags flags)
+{
+	route_cache_entry_t search;
+	// The convoy threads fill the slots in the order they happen to run, so hits could differ between server and clients
+	if(  env_t::networkmode  ||  flags != none  ||  max_cost != SINT64_MAX_VALUE  ||  avoid_tile != koord3d::invalid  ||  direction != ribi_t::all  ||  !tdriver->get_route_cache_key(search.driver_key)  ) {
+		return uncached_calc_route(welt, start, ziel, tdriver, max_khm, axle_load, is_tall, max_len, max_cost, convoy_weight, avoid_tile, direction, flags);
+	}
+
+	search.start = start;
+	search.ziel = ziel;
+	search.max_khm = max_khm;
+	search.axle_load = axle_load;
+	search.convoy_weight = convoy_weight;
+	search.max_len = max_len;
+	search.waytype = tdriver->get_waytype();
+	search.is_tall = is_tall;
+	const uint32 slot = search.get_slot();
+
+#ifdef MULTI_THREAD
+	pthread_mutex_lock(&route_cache_mutex);
+#endif
+	route_cache_entry_t &entry = route_cache[slot];
+	if(  entry.generation == weg_t::get_network_generation()  &&  entry.is_same_search(search)  ) {
+		route = entry.route;
+		max_axle_load = entry.max_axle_load;
+		max_convoy_weight = MAXUINT32;
+		const route_result_t result = entry.result;
+#ifdef MULTI_THREAD
+		pthread_mutex_unlock(&route_cache_mutex);
+#endif
+		return result;
+	}
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock(&route_cache_mutex);
+#endif
+
+	const uint32 generation = weg_t::get_network_generation();
+	const route_result_t result = uncached_calc_route(welt, start, ziel, tdriver, max_khm, axle_load, is_tall, max_len, max_cost, convoy_weight, avoid_tile, direction, flags);
+	if(  result == route_too_complex  ) {
+		// may succeed with other settings for the number of steps
+		return result;
+	}
+
+#ifdef MULTI_THREAD
+	pthread_mutex_lock(&route_cache_mutex);
+#endif
+	// only if the ways did not change while searching
+	if(  generation == weg_t::get_network_generation()  ) {
+		route_cache_entry_t &entry = route_cache[slot];
+		entry = search;
+		entry.generation = generation;
+		entry.result = result;
+		entry.max_axle_load = max_axle_load;
+		entry.route = route;
+	}
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock(&route_cache_mutex);
+#endif
+	return result;
+}
+
+
 /**
  * searches route, uses intern_calc_route() for distance between stations
  * handles only driving in stations by itself
  */
- route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d start, const koord3d ziel, test_driver_t* const tdriver, const sint32 max_khm, const uint32 axle_load, bool is_tall, sint32 max_len, const sint64 max_cost, const uint32 convoy_weight, koord3d avoid_tile, uint8 direction, find_route_flags flags)
+route_t::route_result_t route_t::uncached_calc_route(karte_t *welt, const koord3d start, const koord3d ziel, test_driver_t* const tdriver, const sint32 max_khm, const uint32 axle_load, bool is_tall, sint32 max_len, const sint64 max_cost, const uint32 convoy_weight, koord3d avoid_tile, uint8 direction, find_route_flags flags)
 {
 	route.clear();
 	const uint32 distance = shortest_distance(start.get_2d(), ziel.get_2d()) * 600;
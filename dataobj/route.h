@@ -41,6 +41,12 @@ public:
 
 private:
 
+	/**
+	 * Checks one way signs, low bridges and weight limits when entering @p to in direction @p dir.
+	 * @param is_overweight set to slowly_only if the convoy can pass only slowly
+	 */
+	bool can_enter_tile(karte_t *welt, const grund_t *to, ribi_t::ribi dir, test_driver_t *tdriver, uint8 enforce_weight_limits, uint32 axle_load, uint32 convoy_weight, sint32 tile_length, bool is_tall, sint32 &bridge_tile_count, sint32 &is_overweight);
+
 	/**
 	 * The actual route search
 	 */
@@ -77,6 +83,7 @@ public:
 		uint32 g;        ///< cost to reach this tile
 		uint8 dir;       ///< driving direction
 		uint8 ribi_from; ///< we came from this direction
+		uint8 first_ribi; ///< direction of the first step from the parent, which can be several tiles away
 		uint16 count;    ///< length of route up to here
 		uint8 jps_ribi;  ///< extra ribi mask for jump-point search
 
@@ -181,6 +188,10 @@ protected:
    */
 	void assign_from_reversed_route(const route_t& input);
 
+private:
+	/// calc_route() without the cache
+	route_result_t uncached_calc_route(karte_t *welt, koord3d start, koord3d ziel, test_driver_t* const tdriver, const sint32 max_speed_kmh, const uint32 axle_load, bool is_tall, sint32 max_tile_len, const sint64 max_cost, const uint32 convoy_weight, const koord3d avoid_tile, uint8 direction, find_route_flags flags);
+
 public:
 	/**
 	 * Tries the ocean route in both directions.
@@ -195,10 +206,17 @@ public:
 	bool find_route(karte_t *w, const koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 axle_load, sint32 max_tile_len, uint32 total_weight, uint32 max_depth, bool is_tall, find_route_flags flags = none);
 
 	/**
-	 * Calculates the route from @p start to @p target
+	 * Calculates the route from @p start to @p target.
+	 * Routes of drivers which allow it (see test_driver_t::get_route_cache_key())
+	 * are kept until the ways change, and copied for the next convoy on the same leg.
+	 * Not in network games, where the convoys searching in parallel would fill the cache
+	 * in an order depending on thread timing.
 	 */
 	route_result_t calc_route(karte_t *welt, koord3d start, koord3d ziel, test_driver_t* const tdriver, const sint32 max_speed_kmh, const uint32 axle_load, bool is_tall, sint32 max_tile_len, const sint64 max_cost = SINT64_MAX_VALUE, const uint32 convoy_weight = 0, const koord3d avoid_tile = koord3d::invalid, uint8 direction = ribi_t::all, find_route_flags flags = none);
 
+	/// forgets all routes kept by calc_route()
+	static void clear_cache();
+
 	/**
 	 * Load/Save of the route.
 	 */
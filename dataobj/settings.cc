@@ -2104,6 +2104,8 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	env_t::fps                         = contents.get_int_clamped( "frames_per_second",              env_t::fps,                       env_t::min_fps, env_t::max_fps );
 	env_t::ff_fps                      = contents.get_int_clamped( "fast_forward_frames_per_second", env_t::ff_fps,                    env_t::min_fps, env_t::max_fps );
 	env_t::num_threads                 = contents.get_int_clamped( "threads",                        env_t::num_threads,               1, MAX_THREADS );
+	env_t::parallel_sync_step          = contents.get_int( "parallel_sync_step",          env_t::parallel_sync_step ) != 0;
+	env_t::image_cache_size            = contents.get_int_clamped( "image_cache_size",               env_t::image_cache_size,          0, INT_MAX );
 	env_t::simple_drawing_default      = contents.get_int_clamped( "simple_drawing_tile_size",       env_t::simple_drawing_default,    2, 256 );
 	env_t::simple_drawing_fast_forward = contents.get_int( "simple_drawing_fast_forward", env_t::simple_drawing_fast_forward ) != 0;
 	env_t::visualize_schedule          = contents.get_int( "visualize_schedule",          env_t::visualize_schedule ) != 0;
@@ -2386,6 +2388,7 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	}
 
 	env_t::autosave = contents.get_int_clamped( "autosave", env_t::autosave, 0, INT_MAX );
+	env_t::background_save = contents.get_int( "background_save", env_t::background_save ) != 0;
 
 	// routing stuff
 	max_route_steps        = contents.get_int_clamped( "max_route_steps",        max_route_steps,        0, INT_MAX );
@@ -3167,6 +3170,12 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	else if(strcmp(str, "xml_zstd") == 0) {
 		loadsave_t::set_savemode(loadsave_t::xml_zstd );
 	}
+	else if(strcmp(str, "chunked") == 0) {
+		loadsave_t::set_savemode(loadsave_t::chunked );
+	}
+	else if(strcmp(str, "xml_chunked") == 0) {
+		loadsave_t::set_savemode(loadsave_t::xml_chunked );
+	}
 
 	str = contents.get("autosaveformat" );
 	while (*str == ' ') str++;
@@ -3194,6 +3203,12 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	else if(strcmp(str, "xml_zstd") == 0) {
 		loadsave_t::set_autosavemode(loadsave_t::xml_zstd );
 	}
+	else if(strcmp(str, "chunked") == 0) {
+		loadsave_t::set_autosavemode(loadsave_t::chunked );
+	}
+	else if(strcmp(str, "xml_chunked") == 0) {
+		loadsave_t::set_autosavemode(loadsave_t::xml_chunked );
+	}
 
 	loadsave_t::save_level     = contents.get_int("save_level", loadsave_t::save_level );
 	loadsave_t::autosave_level = contents.get_int("autosave_level", loadsave_t::autosave_level );
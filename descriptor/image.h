@@ -40,7 +40,15 @@ public:
 	uint8 zoomable;   ///< some images may not be zoomed i.e. icons
 	PIXVAL *data;     ///< RLE encoded image data
 
-	image_t(size_t len_ = 0) : data(NULL)
+private:
+	/// false if data points into a mapped pak file, which stays mapped
+	bool owns_data;
+
+	/// checksum of data, to find duplicates while loading
+	uint32 adler;
+
+public:
+	image_t(size_t len_ = 0) : data(NULL), owns_data(true), adler(0)
 	{
 		if (len_) {
 			alloc(len_);
@@ -49,14 +57,19 @@ public:
 
 	~image_t()
 	{
-		delete[] data;
+		if (owns_data) {
+			delete[] data;
+		}
 	}
 
 	void alloc(size_t len_)
 	{
-		delete[] data;
+		if (owns_data) {
+			delete[] data;
+		}
 		data = new PIXVAL[len_];
 		len = len_;
+		owns_data = true;
 	}
 
 	static image_t* copy_image(const image_t& other);
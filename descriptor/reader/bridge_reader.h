@@ -21,7 +21,8 @@ public:
 	static bridge_reader_t*instance() { return &the_instance; }
 
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *data, obj_node_info_t &node) OVERRIDE;
+	bool is_read_node_independent() const OVERRIDE { return true; }
 
 	obj_type get_type() const OVERRIDE { return obj_bridge; }
 	char const* get_type_name() const OVERRIDE { return "bridge"; }
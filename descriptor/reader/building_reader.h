@@ -21,7 +21,8 @@ public:
 	char const* get_type_name() const OVERRIDE { return "tile"; }
 
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *data, obj_node_info_t &node) OVERRIDE;
+	bool is_read_node_independent() const OVERRIDE { return true; }
 };
 
 
@@ -43,7 +44,8 @@ public:
 	char const* get_type_name() const OVERRIDE { return "building"; }
 
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *data, obj_node_info_t &node) OVERRIDE;
+	bool is_read_node_independent() const OVERRIDE { return true; }
 
 };
 
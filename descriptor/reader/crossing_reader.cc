@@ -30,14 +30,10 @@ void crossing_reader_t::register_obj(obj_desc_t *&data)
 }
 
 
-obj_desc_t * crossing_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t * crossing_reader_t::read_node(char *desc_buf, obj_node_info_t &/*node*/)
 {
-	ALLOCA(char, desc_buf, node.size);
-
 	crossing_desc_t *desc = new crossing_desc_t();
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
 	char * p = desc_buf;
 
 	// old versions of PAK files have no version stamp.
@@ -33,14 +33,10 @@ uint16 rescale_probability(const uint16 p)
 }
 
 
-obj_desc_t *factory_field_class_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_field_class_reader_t::read_node(char *desc_buf, obj_node_info_t &/*node*/)
 {
-	ALLOCA(char, desc_buf, node.size);
-
 	field_class_desc_t *desc = new field_class_desc_t();
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
 	char * p = desc_buf;
 
 	uint16 v = decode_uint16(p);
@@ -65,14 +61,10 @@ obj_desc_t *factory_field_class_reader_t::read_node(FILE *fp, obj_node_info_t &n
 }
 
 
-obj_desc_t *factory_field_group_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_field_group_reader_t::read_node(char *desc_buf, obj_node_info_t &/*node*/)
 {
-	ALLOCA(char, desc_buf, node.size);
-
 	field_group_desc_t *desc = new field_group_desc_t();
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
 	char * p = desc_buf;
 
 	uint16 v = decode_uint16(p);
@@ -159,14 +151,10 @@ void factory_field_group_reader_t::register_obj(obj_desc_t *&data)
 	}
 }
 
-obj_desc_t *factory_smoke_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_smoke_reader_t::read_node(char *desc_buf, obj_node_info_t &node)
 {
-	ALLOCA(char, desc_buf, node.size);
-
 	smoke_desc_t *desc = new smoke_desc_t();
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
 	char * p = desc_buf;
 
 	sint16 x = decode_sint16(p);
@@ -185,15 +173,11 @@ obj_desc_t *factory_smoke_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 }
 
 
-obj_desc_t *factory_supplier_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_supplier_reader_t::read_node(char *desc_buf, obj_node_info_t &/*node*/)
 {
 	// DBG_DEBUG("factory_product_reader_t::read_node()", "called");
-	ALLOCA(char, desc_buf, node.size);
-
 	factory_supplier_desc_t *desc = new factory_supplier_desc_t();
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
 	char * p = desc_buf;
 
 	// old versions of PAK files have no version stamp.
@@ -224,16 +208,11 @@ obj_desc_t *factory_supplier_reader_t::read_node(FILE *fp, obj_node_info_t &node
 }
 
 
-obj_desc_t *factory_product_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_product_reader_t::read_node(char *desc_buf, obj_node_info_t &/*node*/)
 {
 	// DBG_DEBUG("factory_product_reader_t::read_node()", "called");
-	ALLOCA(char, desc_buf, node.size);
-
 	factory_product_desc_t *desc = new factory_product_desc_t();
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
-
 	char * p = desc_buf;
 
 	// old versions of PAK files have no version stamp.
@@ -258,16 +237,11 @@ obj_desc_t *factory_product_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 }
 
 
-obj_desc_t *factory_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_reader_t::read_node(char *desc_buf, obj_node_info_t &/*node*/)
 {
 	// DBG_DEBUG("factory_reader_t::read_node()", "called");
-	ALLOCA(char, desc_buf, node.size);
-
 	factory_desc_t *desc = new factory_desc_t();
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
-
 	desc->sound_id = NO_SOUND;
 	desc->sound_interval = 10000u;
 
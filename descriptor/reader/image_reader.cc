@@ -7,6 +7,7 @@
 #include <string.h>
 
 #include "../../display/simgraph.h"
+#include "../../simconst.h"
 #include "../../simdebug.h"
 #include "../../display/simimg.h"
 
@@ -24,13 +25,10 @@
 #define skip_reading_pixels_if_no_graphics goto adjust_image
 #endif
 
-obj_desc_t *image_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *image_reader_t::read_node(char *desc_buf, obj_node_info_t &node)
 {
-	ALLOCA(char, desc_buf, node.size);
 	image_t* desc=NULL;
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
 	char * p = desc_buf+6;
 
 	// always zero in old version, since length was always less than 65535
@@ -96,15 +94,28 @@ obj_desc_t *image_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 		desc->w = decode_sint16(p);
 		p++; // skip version information
 		desc->h = decode_sint16(p);
-		desc->alloc((node.size - 10) / 2); // len
+		const size_t len = (node.size - 10) / 2;
 		desc->zoomable = decode_uint8(p);
 		desc->imageid = IMG_EMPTY;
 
-		skip_reading_pixels_if_no_graphics;
-		uint16* dest = desc->data;
-		if (desc->h > 0) {
-			for (uint i = 0; i < desc->len; i++) {
-				*dest++ = decode_uint16(p);
+#if COLOUR_DEPTH != 0  &&  !defined(SIM_BIG_ENDIAN)
+		if(  ((size_t)p & 1) == 0  ) {
+			// the pixels are stored just as we need them, so use them where they are
+			desc->data = (PIXVAL *)p;
+			desc->len = len;
+			desc->owns_data = false;
+		}
+		else
+#endif
+		{
+			desc->alloc(len);
+
+			skip_reading_pixels_if_no_graphics;
+			uint16* dest = desc->data;
+			if (desc->h > 0) {
+				for (uint i = 0; i < desc->len; i++) {
+					*dest++ = decode_uint16(p);
+				}
 			}
 		}
 	}
@@ -164,10 +175,22 @@ adjust_image:
 
 	if (desc->len != 0) {
 		// get the adler hash (since we have zlib on board anyway ... )
-		bool do_register_image = true;
-		uint32 adler = adler32(0L, NULL, 0 );
+		desc->adler = adler32(0L, NULL, 0 );
 		// remember len is sizeof(uint16)!
-		adler = adler32(adler, (const Bytef *)(desc->data), desc->len * 2);
+		desc->adler = adler32(desc->adler, (const Bytef *)(desc->data), desc->len * 2);
+	}
+
+	return desc;
+}
+
+
+void image_reader_t::register_obj(obj_desc_t *&data)
+{
+	image_t *desc = static_cast<image_t *>(data);
+
+	if (desc->len != 0) {
+		bool do_register_image = true;
+		const uint32 adler = desc->adler;
 		static inthashtable_tpl<uint32, image_t *, N_BAGS_LARGE> images_adlers;
 		image_t *same = images_adlers.get(adler);
 		if (same) {
@@ -194,9 +217,7 @@ adjust_image:
 		else {
 			// no need to load doubles ...
 			delete desc;
-			desc = same;
+			data = same;
 		}
 	}
-
-	return desc;
 }
@@ -14,13 +14,18 @@ class image_reader_t : public obj_reader_t {
 	static image_reader_t the_instance;
 
 	image_reader_t() { register_reader(); }
+protected:
+	/// Drops duplicates of already registered images and registers the others.
+	void register_obj(obj_desc_t *&data) OVERRIDE;
+
 public:
 	static image_reader_t* instance() { return &the_instance; }
 
 	obj_type get_type() const OVERRIDE { return obj_image; }
 	char const* get_type_name() const OVERRIDE { return "image"; }
 
-	obj_desc_t* read_node(FILE*, obj_node_info_t&) OVERRIDE;
+	obj_desc_t* read_node(char*, obj_node_info_t&) OVERRIDE;
+	bool is_read_node_independent() const OVERRIDE { return true; }
 };
 
 #endif
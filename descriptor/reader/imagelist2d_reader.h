@@ -21,7 +21,8 @@ public:
 	char const* get_type_name() const OVERRIDE { return "imagelist2d"; }
 
 	/// @copydoc obj_reader::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *data, obj_node_info_t &node) OVERRIDE;
+	bool is_read_node_independent() const OVERRIDE { return true; }
 };
 
 #endif
@@ -6,11 +6,16 @@
 #include <string>
 #include <string.h>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 // for the progress bar
 #include "../../simcolor.h"
 #include "../../display/simimg.h"
 #include "../../sys/simsys.h"
 #include "../../simtypes.h"
+#include "../../simmem.h"
 #include "../../simloadingscreen.h"
 
 #include "../skin_desc.h"   // just for the logo
@@ -23,8 +28,12 @@
 
 #include "../../utils/searchfolder.h"
 #include "../../utils/simstring.h"
+#ifdef MULTI_THREAD
+#include "../../utils/simthread.h"
+#endif
 
 #include "../../tpl/inthashtable_tpl.h"
+#include "../../tpl/vector_tpl.h"
 #include "../../tpl/ptrhashtable_tpl.h"
 #include "../../tpl/stringhashtable_tpl.h"
 #include "../../simdebug.h"
@@ -40,6 +49,41 @@ inthashtable_tpl<obj_type, stringhashtable_tpl<obj_desc_t*, N_BAGS_LARGE>, N_BAG
 obj_reader_t::unresolved_map                                  obj_reader_t::unresolved;
 ptrhashtable_tpl<obj_desc_t**, int, N_BAGS_SMALL>             obj_reader_t::fatals;
 
+
+/// A node of a pak file, read already if its reader allows this.
+struct obj_reader_t::pak_node_t
+{
+	obj_node_info_t info;
+	char *data;           ///< in the mapped file
+	obj_reader_t *reader; ///< NULL for unknown nodes, whose children are skipped
+	obj_desc_t *desc;     ///< NULL until read
+};
+
+
+/// The nodes of a pak file, in the order of the file.
+struct obj_reader_t::pak_file_t
+{
+	const char *name;
+	vector_tpl<pak_node_t> nodes;
+	bool parsed;
+};
+
+
+#ifdef MULTI_THREAD
+static pthread_mutex_t parse_files_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  parse_files_cond  = PTHREAD_COND_INITIALIZER;
+
+
+/// The files of load(), parsed by all threads in order.
+struct obj_reader_t::pak_file_queue_t
+{
+	pak_file_t *files;
+	uint32 count;
+	uint32 next; ///< first file not yet taken by a thread
+};
+#endif
+
+
 void obj_reader_t::register_reader()
 {
 	if(!obj_reader) {
@@ -147,129 +191,317 @@ DBG_MESSAGE("obj_reader_t::load()","big logo %p", skinverwaltung_t::biglogosymbo
 
 DBG_MESSAGE("obj_reader_t::load()", "reading from '%s'", name.c_str());
 
-		uint n = 0;
-		FORX(searchfolder_t, const& i, find, ++n) {
-			read_file(i);
+		// the files are parsed in parallel, but registered in order
+		pak_file_t *files = new pak_file_t[max];
+		uint32 count = 0;
+		FOR(searchfolder_t, const& i, find) {
+			files[count].name = i;
+			files[count].parsed = false;
+			count++;
+		}
+
+#ifdef MULTI_THREAD
+		pak_file_queue_t queue;
+		queue.files = files;
+		queue.count = count;
+		queue.next = 0;
+
+		// the main thread parses too, while it waits for the next file
+		const uint32 thread_count = count > 0 ? min( (uint32)env_t::num_threads, count ) - 1 : 0;
+		pthread_t threads[MAX_THREADS];
+		bool started[MAX_THREADS];
+		for(  uint32 t = 0;  t < thread_count;  t++  ) {
+			started[t] = pthread_create( &threads[t], NULL, parse_files_thread, &queue ) == 0;
+		}
+#endif
+
+		for(  uint32 n = 0;  n < count;  n++  ) {
+#ifdef MULTI_THREAD
+			pthread_mutex_lock( &parse_files_mutex );
+			while(  !files[n].parsed  ) {
+				if(  queue.next < count  ) {
+					pthread_mutex_unlock( &parse_files_mutex );
+					parse_next_file( queue );
+					pthread_mutex_lock( &parse_files_mutex );
+				}
+				else {
+					pthread_cond_wait( &parse_files_cond, &parse_files_mutex );
+				}
+			}
+			pthread_mutex_unlock( &parse_files_mutex );
+#else
+			parse_file( files[n] );
+#endif
+			register_file( files[n] );
+			files[n].nodes = vector_tpl<pak_node_t>();
+
 			if ((n & step) == 0 && drawing) {
 				ls.set_progress(n);
 			}
 		}
 		ls.set_progress(max);
 
+#ifdef MULTI_THREAD
+		for(  uint32 t = 0;  t < thread_count;  t++  ) {
+			if(  started[t]  ) {
+				pthread_join( threads[t], NULL );
+			}
+		}
+#endif
+		delete [] files;
+
 		return find.begin()!=find.end();
 	}
 	return false;
 }
 
 
+/**
+ * Maps the whole pak file into memory, or reads it in one go where this is
+ * not possible. The mapping is private, so the nodes may be changed in place.
+ * @param mapped set to true if the memory must be unmapped instead of freed
+ * @return NULL if the file could not be read
+ */
+static char *map_pak_file(FILE *fp, size_t &size, bool &mapped)
+{
+	mapped = false;
+	if(  fseek(fp, 0, SEEK_END) != 0  ) {
+		return NULL;
+	}
+	const long len = ftell(fp);
+	if(  len <= 0  ) {
+		return NULL;
+	}
+	size = (size_t)len;
+
+#ifndef _WIN32
+	void *const map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(fp), 0);
+	if(  map != MAP_FAILED  ) {
+		mapped = true;
+		return (char *)map;
+	}
+#endif
+
+	char *const buf = MALLOCN(char, size);
+	rewind(fp);
+	if(  fread(buf, size, 1, fp) != 1  ) {
+		free(buf);
+		return NULL;
+	}
+	return buf;
+}
+
+
+static void unmap_pak_file(char *buf, size_t size, bool mapped)
+{
+#ifndef _WIN32
+	if(  mapped  ) {
+		munmap(buf, size);
+		return;
+	}
+#else
+	(void)size;
+	(void)mapped;
+#endif
+	free(buf);
+}
+
+
+#ifdef MULTI_THREAD
+bool obj_reader_t::parse_next_file(pak_file_queue_t &queue)
+{
+	pthread_mutex_lock( &parse_files_mutex );
+	const uint32 n = queue.next;
+	if(  n < queue.count  ) {
+		queue.next++;
+	}
+	pthread_mutex_unlock( &parse_files_mutex );
+
+	if(  n >= queue.count  ) {
+		return false;
+	}
+
+	parse_file( queue.files[n] );
+
+	pthread_mutex_lock( &parse_files_mutex );
+	queue.files[n].parsed = true;
+	pthread_cond_broadcast( &parse_files_cond );
+	pthread_mutex_unlock( &parse_files_mutex );
+	return true;
+}
+
+
+void *obj_reader_t::parse_files_thread(void *args)
+{
+	pak_file_queue_t *queue = (pak_file_queue_t *)args;
+	while(  parse_next_file( *queue )  ) {
+	}
+	return NULL;
+}
+#endif
+
+
 void obj_reader_t::read_file(const char *name)
 {
+	pak_file_t file;
+	file.name = name;
+	file.parsed = false;
+	parse_file( file );
+	register_file( file );
+}
+
+
+void obj_reader_t::parse_file(pak_file_t &file)
+{
+	const char *name = file.name;
 	// added trace
-	DBG_DEBUG("obj_reader_t::read_file()", "filename='%s'", name);
+	DBG_DEBUG("obj_reader_t::parse_file()", "filename='%s'", name);
 
-	if (FILE* const fp = dr_fopen(name, "rb")) {
-		sint32 n = 0;
+	FILE* const fp = dr_fopen(name, "rb");
+	size_t size = 0;
+	bool mapped = false;
+	char *const buf = fp ? map_pak_file(fp, size, mapped) : NULL;
+	if(  fp  ) {
+		fclose(fp);
+	}
+	if(  buf == NULL  ) {
+		dbg->error("obj_reader_t::parse_file()", "reading '%s' failed!", name);
+		return;
+	}
 
-		// This is the normal header reading code
-		int c;
-		do {
-			c = fgetc(fp);
-			n ++;
-		} while(!feof(fp) && c != 0x1a);
+	const char *const end = buf + size;
+	char *p = buf;
 
-		if(feof(fp)) {
-			dbg->error("obj_reader_t::read_file()", "unexpected end of file after %d bytes while reading '%s'!",n, name);
-		}
-		else {
-//			DBG_DEBUG("obj_reader_t::read_file()", "skipped %d header bytes", n);
-		}
+	// This is the normal header reading code
+	while(  p < end  &&  *p++ != 0x1a  ) {
+	}
 
-		// Compiled Version
-		uint32 version = 0;
-		char dummy[4], *p;
-		p = dummy;
+	if(  end - p < 4  ) {
+		dbg->error("obj_reader_t::parse_file()", "unexpected end of file after %d bytes while reading '%s'!", (int)(p - buf), name);
+		unmap_pak_file(buf, size, mapped);
+		return;
+	}
 
-		n = fread(dummy, 4, 1, fp);
-		version = decode_uint32(p);
+	// Compiled Version
+	const uint32 version = decode_uint32(p);
 
-		DBG_DEBUG("obj_reader_t::read_file()", "read %d blocks, file version is %x", n, version);
+	DBG_DEBUG("obj_reader_t::parse_file()", "file version is %x", version);
 
-		if(version <= COMPILER_VERSION_CODE) {
-			obj_desc_t *data = NULL;
-			read_nodes(fp, data, 0, version );
+	if(version <= COMPILER_VERSION_CODE) {
+		// The nodes stay in memory, since the images use their data in place.
+		// Loading still reads every image (checksums, player colours), but with
+		// a mapping the unchanged pages can be dropped again by the system.
+		if(  !read_nodes(file, p, end, version)  ) {
+			// skip the whole file; what was read of it is not used
+			dbg->error("obj_reader_t::parse_file()", "unexpected end of file while reading '%s'!", name);
+			file.nodes.clear();
+			unmap_pak_file(buf, size, mapped);
 		}
-		else {
-			DBG_DEBUG("obj_reader_t::read_file()","version of '%s' is too old, %d instead of %d", name, version, COMPILER_VERSION_CODE );
-		}
-		fclose(fp);
 	}
 	else {
-		dbg->error("obj_reader_t::read_file()", "reading '%s' failed!", name);
+		DBG_DEBUG("obj_reader_t::parse_file()","version of '%s' is too old, %d instead of %d", name, version, COMPILER_VERSION_CODE );
+		unmap_pak_file(buf, size, mapped);
 	}
 }
 
 
-static void read_node_info(obj_node_info_t& node, FILE* const f, uint32 const version)
+void obj_reader_t::register_file(pak_file_t &file)
 {
-	char data[EXT_OBJ_NODE_INFO_SIZE];
+	if(  !file.nodes.empty()  ) {
+		uint32 index = 0;
+		obj_desc_t *data = NULL;
+		register_nodes(file, index, data, 0);
+	}
+}
+
 
-	char* p = data;
-	fread(p, OBJ_NODE_INFO_SIZE, 1, f);
+/// @return false if the node does not fit into the rest of the file
+static bool read_node_info(obj_node_info_t& node, char *&p, const char *end, uint32 const version)
+{
+	if(  end - p < OBJ_NODE_INFO_SIZE  ) {
+		return false;
+	}
 	node.type     = decode_uint32(p);
 	node.children = decode_uint16(p);
 	node.size     = decode_uint16(p);
 	// can have larger records
 	if (version != COMPILER_VERSION_CODE_11 && node.size == LARGE_RECORD_SIZE) {
-		fread(p, sizeof(data) - OBJ_NODE_INFO_SIZE, 1, f);
+		if(  end - p < EXT_OBJ_NODE_INFO_SIZE - OBJ_NODE_INFO_SIZE  ) {
+			return false;
+		}
 		node.size = decode_uint32(p);
 	}
+	return (size_t)(end - p) >= node.size;
 }
 
 
-void obj_reader_t::read_nodes(FILE* fp, obj_desc_t*& data, int register_nodes, uint32 version )
+bool obj_reader_t::read_nodes(pak_file_t &file, char *&p, const char *end, uint32 version)
 {
-	obj_node_info_t node;
-	read_node_info(node, fp, version);
+	pak_node_t node;
+	if(  !read_node_info(node.info, p, end, version)  ) {
+		return false;
+	}
+	node.data = p;
+	p += node.info.size;
+
+	node.reader = obj_reader->get(static_cast<obj_type>(node.info.type));
+	node.desc = NULL;
+	if(  node.reader  &&  node.reader->is_read_node_independent()  ) {
+//DBG_DEBUG("obj_reader_t::read_nodes()","Reading %.4s-node of length %d with '%s'", reinterpret_cast<const char *>(&node.info.type), node.info.size, node.reader->get_type_name());
+		node.desc = node.reader->read_node(node.data, node.info);
+	}
+	file.nodes.append(node);
+
+	for(  int i = 0;  i < node.info.children;  i++  ) {
+		if(  node.reader ? !read_nodes(file, p, end, version) : !skip_nodes(p, end, version)  ) {
+			return false;
+		}
+	}
+	return true;
+}
 
-	obj_reader_t *reader = obj_reader->get(static_cast<obj_type>(node.type));
-	if(reader) {
 
-//DBG_DEBUG("obj_reader_t::read_nodes()","Reading %.4s-node of length %d with '%s'", reinterpret_cast<const char *>(&node.type), node.size, reader->get_type_name());
-		data = reader->read_node(fp, node);
-		if (node.children != 0) {
-			data->children = new obj_desc_t*[node.children];
-			for (int i = 0; i < node.children; i++) {
-				read_nodes(fp, data->children[i], register_nodes + 1, version);
+void obj_reader_t::register_nodes(pak_file_t &file, uint32 &index, obj_desc_t*& data, int level)
+{
+	pak_node_t &node = file.nodes[index++];
+	if(node.reader) {
+		// the other nodes must be read in order, since they use what was registered before
+		data = node.desc ? node.desc : node.reader->read_node(node.data, node.info);
+		if (node.info.children != 0) {
+			data->children = new obj_desc_t*[node.info.children];
+			for (int i = 0; i < node.info.children; i++) {
+				register_nodes(file, index, data->children[i], level + 1);
 			}
 		}
 
-//DBG_DEBUG("obj_reader_t","registering with '%s'", reader->get_type_name());
-		if(register_nodes<2  ||  node.type!=obj_cursor) {
+//DBG_DEBUG("obj_reader_t","registering with '%s'", node.reader->get_type_name());
+		if(level<2  ||  node.info.type!=obj_cursor) {
 			// since many buildings are with cursors that do not need registration
-			reader->register_obj(data);
+			node.reader->register_obj(data);
 		}
 	}
 	else {
 		// no reader found ...
-		dbg->warning("obj_reader_t::read_nodes()","skipping unknown %.4s-node\n",reinterpret_cast<const char *>(&node.type));
-		fseek(fp, node.size, SEEK_CUR);
-		for(int i = 0; i < node.children; i++) {
-			skip_nodes(fp,version);
-		}
+		dbg->warning("obj_reader_t::register_nodes()","skipping unknown %.4s-node\n",reinterpret_cast<const char *>(&node.info.type));
 		data = NULL;
 	}
 }
 
 
-void obj_reader_t::skip_nodes(FILE *fp,uint32 version)
+bool obj_reader_t::skip_nodes(char *&p, const char *end, uint32 version)
 {
 	obj_node_info_t node;
-	read_node_info(node, fp, version);
+	if(  !read_node_info(node, p, end, version)  ) {
+		return false;
+	}
 
-	fseek(fp, node.size, SEEK_CUR);
+	p += node.size;
 	for(int i = 0; i < node.children; i++) {
-		skip_nodes(fp,version);
+		if(  !skip_nodes(p, end, version)  ) {
+			return false;
+		}
 	}
+	return true;
 }
 
 
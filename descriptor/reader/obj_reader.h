@@ -80,8 +80,29 @@ class obj_reader_t
 	static unresolved_map unresolved;
 	static ptrhashtable_tpl<obj_desc_t **, int, N_BAGS_SMALL>  fatals;
 
-	static void read_nodes(FILE* fp, obj_desc_t*& data, int register_nodes,uint32 version);
-	static void skip_nodes(FILE *fp,uint32 version);
+	//
+	// Pak files are loaded in two steps: first they are parsed, which
+	// may happen in parallel for several files, then their nodes are
+	// registered in the order of the files.
+	//
+	struct pak_node_t;
+	struct pak_file_t;
+
+	static void parse_file(pak_file_t &file);
+	/// @return false if the file ends within a node
+	static bool read_nodes(pak_file_t &file, char *&p, const char *end, uint32 version);
+	static bool skip_nodes(char *&p, const char *end, uint32 version);
+
+	static void register_file(pak_file_t &file);
+	static void register_nodes(pak_file_t &file, uint32 &index, obj_desc_t*& data, int level);
+
+#ifdef MULTI_THREAD
+	struct pak_file_queue_t;
+
+	/// @returns false if all files are taken already
+	static bool parse_next_file(pak_file_queue_t &queue);
+	static void *parse_files_thread(void *args);
+#endif
 
 protected:
 	obj_reader_t() { /* Beware: Cannot register here! */}
@@ -91,13 +112,18 @@ protected:
 	static void xref_to_resolve(obj_type type, const char *name, obj_desc_t **dest, bool fatal);
 	static void resolve_xrefs();
 
-	/// Read a descriptor from @p fp. Does version check and compatibility transformations.
+	/// Read a descriptor from the @p data of the node. Does version check and compatibility transformations.
+	/// The data stays valid for the whole run, so descriptors may point into it.
 	/// @returns The descriptor on success, or NULL on failure
-	virtual obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) = 0;
+	virtual obj_desc_t *read_node(char *data, obj_node_info_t &node) = 0;
 
 	/// Register descriptor so the object described by the descriptor can be built in-game.
 	virtual void register_obj(obj_desc_t *&/*desc*/) {}
 
+	/// @returns true if read_node() only uses the data of its node. Then the nodes are read
+	/// by the loading threads, otherwise in order after all preceding nodes were registered.
+	virtual bool is_read_node_independent() const { return false; }
+
 	/// Does post-loading checks.
 	/// @returns true if everything ok
 	virtual bool successfully_loaded() const { return true; }
@@ -125,7 +151,11 @@ public:
 	 */
 	static bool load(const char *path, const char *message);
 
-	// Only for single files, must take care of all the cleanup/registering matrix themselves
+	/**
+	 * Only for single files, must take care of all the cleanup/registering matrix themselves.
+	 * The file is mapped into memory (or read in one go where this is not possible)
+	 * and stays there, since the image data is used in place.
+	 */
 	static void read_file(const char *name);
 };
 
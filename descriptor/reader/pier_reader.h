@@ -22,7 +22,8 @@ protected:
 public:
     static pier_reader_t *instance() {return &the_instance; }
 
-    obj_desc_t * read_node(FILE *fp, obj_node_info_t &node) override;
+    obj_desc_t * read_node(char *data, obj_node_info_t &node) override;
+    bool is_read_node_independent() const OVERRIDE { return true; }
 
     obj_type get_type() const override {return obj_pier; }
     char const* get_type_name() const override {return "pier";}
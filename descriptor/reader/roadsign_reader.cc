@@ -35,14 +35,10 @@ bool roadsign_reader_t::successfully_loaded() const
 }
 
 
-obj_desc_t * roadsign_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t * roadsign_reader_t::read_node(char *desc_buf, obj_node_info_t &/*node*/)
 {
-	ALLOCA(char, desc_buf, node.size);
-
 	roadsign_desc_t *desc = new roadsign_desc_t();
 
-	// Read data
-	fread(desc_buf, node.size, 1, fp);
 	char * p = desc_buf;
 
 	const uint16 v = decode_uint16(p);
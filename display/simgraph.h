@@ -173,6 +173,23 @@ void register_image(class image_t *);
 // delete all images above a certain number ...
 void display_free_all_images_above( image_id above );
 
+/**
+ * Frees the zoomed and recoloured data of the least recently drawn images
+ * while they take more than env_t::image_cache_size. Called once per frame,
+ * never while drawing.
+ */
+void display_trim_image_cache();
+
+struct image_cache_stats_t
+{
+	uint64 hits;      ///< images drawn with their zoomed and recoloured data at hand
+	uint64 misses;    ///< images recoloured before drawing
+	uint64 evictions; ///< images whose data was freed by display_trim_image_cache()
+	size_t bytes;     ///< memory for the zoomed and recoloured data
+};
+
+void display_get_image_cache_stats(image_cache_stats_t &stats);
+
 // unzoomed offsets
 void display_get_base_image_offset( image_id image, scr_coord_val *xoff, scr_coord_val *yoff, scr_coord_val *xw, scr_coord_val *yw );
 // zoomed offsets
@@ -428,6 +428,16 @@ void display_free_all_images_above(image_id)
 {
 }
 
+void display_trim_image_cache()
+{
+}
+
+void display_get_image_cache_stats(image_cache_stats_t &stats)
+{
+	stats.hits = stats.misses = stats.evictions = 0;
+	stats.bytes = 0;
+}
+
 void simgraph_exit()
 {
 	dr_os_close();
@@ -236,6 +236,8 @@ MSVC_ALIGN(64) struct clipping_info_t {
 	uint8 clip_ribi[MAX_POLY_CLIPS];
 	clip_line_t poly_clips[MAX_POLY_CLIPS];
 	xrange xranges[MAX_POLY_CLIPS];
+	// images drawn by this thread, for the image cache statistics
+	uint64 image_cache_lookups;
 } GCC_ALIGN(64); // aligned to separate cachelines
 
 #ifdef MULTI_THREAD
@@ -343,6 +345,8 @@ struct imd {
 	sint16 base_h; // height
 
 	PIXVAL* base_data; // original image data
+
+	uint32 last_used; // image_cache_frame when last drawn
 };
 
 // Flags for recoding
@@ -391,6 +395,23 @@ static image_id anz_images = 0;
 static image_id alloc_images = 0;
 
 
+/*
+ * The zoomed and recoloured data of the images: memory used and statistics.
+ * The base data always stays in memory.
+ */
+static size_t image_cache_bytes = 0;
+static uint64 image_cache_misses = 0;
+static uint64 image_cache_evictions = 0;
+
+// counts the calls of display_trim_image_cache(), i.e. the frames
+static uint32 image_cache_frame = 0;
+
+#ifdef MULTI_THREAD
+// image_cache_bytes is changed by all drawing threads
+static pthread_mutex_t image_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
 /*
  * Output framebuffer
  */
@@ -1362,6 +1383,42 @@ image_id get_image_count()
 }
 
 
+static void change_image_cache_bytes(size_t added, size_t freed)
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &image_cache_mutex );
+#endif
+	image_cache_bytes += added;
+	image_cache_bytes -= freed;
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &image_cache_mutex );
+#endif
+}
+
+
+/**
+ * Frees the zoomed and recoloured data of an image
+ * @return the number of bytes freed
+ */
+static size_t free_img_cache(imd &image)
+{
+	size_t freed = 0;
+	if(  image.zoom_data != NULL  ) {
+		free( image.zoom_data );
+		image.zoom_data = NULL;
+		freed += image.len;
+	}
+	for(  uint8 i = 0;  i < MAX_PLAYER_COUNT;  i++  ) {
+		if(  image.data[i] != NULL  ) {
+			free( image.data[i] );
+			image.data[i] = NULL;
+			freed += image.len;
+		}
+	}
+	return freed * sizeof(PIXVAL);
+}
+
+
 /**
  * Handles the conversion of an image to the output color
  */
@@ -1380,11 +1437,13 @@ static void recode_img(const image_id n, const sint8 player_nr)
 
 	if(  images[n].data[player_nr] == NULL  ) {
 		images[n].data[player_nr] = MALLOCN( PIXVAL, images[n].len );
+		change_image_cache_bytes( images[n].len * sizeof(PIXVAL), 0 );
 	}
 	// contains now the player color ...
 	activate_player_color( player_nr, true );
 	recode_img_src_target( images[n].h, src, images[n].data[player_nr] );
 	images[n].player_flags &= ~(1<<player_nr);
+	image_cache_misses++;
 #ifdef MULTI_THREAD
 	pthread_mutex_unlock( &recode_img_mutex );
 #endif
@@ -1467,16 +1526,7 @@ static void rezoom_img(const image_id n)
 
 		//  we recalculate the len (since it may be larger than before)
 		// thus we have to free the old caches
-		if(  images[n].zoom_data != NULL  ) {
-			free( images[n].zoom_data );
-			images[n].zoom_data = NULL;
-		}
-		for(  uint8 i = 0;  i < MAX_PLAYER_COUNT;  i++  ) {
-			if(  images[n].data[i] != NULL  ) {
-				free( images[n].data[i] );
-				images[n].data[i] = NULL;
-			}
-		}
+		change_image_cache_bytes( 0, free_img_cache( images[n] ) );
 
 		// just restore original size?
 		if(  zoom_factor == ZOOM_NEUTRAL  ||  (images[n].recode_flags&FLAG_ZOOMABLE) == 0  ) {
@@ -1913,6 +1963,7 @@ static void rezoom_img(const image_id n)
 				images[n].zoom_data = MALLOCN(PIXVAL, images[n].len);
 				assert( images[n].zoom_data );
 				memcpy( images[n].zoom_data, rezoom_baseimage[n % env_t::num_threads], zoom_len );
+				change_image_cache_bytes( images[n].len * sizeof(PIXVAL), 0 );
 			}
 		}
 		else {
@@ -2204,6 +2255,7 @@ void register_image(image_t *image_in)
 
 	image->zoom_data = NULL;
 	image->len = image_in->len;
+	image->last_used = image_cache_frame;
 
 	image->base_x = image_in->x;
 	image->base_w = image_in->w;
@@ -2224,15 +2276,85 @@ void display_free_all_images_above( image_id above )
 {
 	while(  above < anz_images  ) {
 		anz_images--;
-		if(  images[anz_images].zoom_data != NULL  ) {
-			free( images[anz_images].zoom_data );
+		change_image_cache_bytes( 0, free_img_cache( images[anz_images] ) );
+	}
+}
+
+
+struct image_age_t
+{
+	uint32 last_used;
+	image_id n;
+};
+
+static bool compare_image_age(const image_age_t &a, const image_age_t &b)
+{
+	return a.last_used < b.last_used;
+}
+
+
+void display_trim_image_cache()
+{
+	image_cache_frame++;
+
+	const size_t limit = (size_t)env_t::image_cache_size << 20;
+	if(  limit == 0  ||  image_cache_bytes <= limit  ) {
+		return;
+	}
+
+	// the images not drawn in the last two frames, least recently drawn first
+	image_age_t *ages = MALLOCN( image_age_t, anz_images );
+	uint32 count = 0;
+	for(  image_id n = 0;  n < anz_images;  n++  ) {
+		const imd &image = images[n];
+		if(  image_cache_frame - image.last_used <= 2  ) {
+			continue;
 		}
-		for(  uint8 i = 0;  i < MAX_PLAYER_COUNT;  i++  ) {
-			if(  images[anz_images].data[i] != NULL  ) {
-				free( images[anz_images].data[i] );
-			}
+		if(  image.zoom_data != NULL  &&  (image.recode_flags & FLAG_ZOOMABLE) == 0  ) {
+			// fitted by display_fit_img_to_width(), which cannot be repeated here
+			continue;
 		}
+		bool cached = image.zoom_data != NULL;
+		for(  uint8 i = 0;  i < MAX_PLAYER_COUNT  &&  !cached;  i++  ) {
+			cached = image.data[i] != NULL;
+		}
+		if(  cached  ) {
+			ages[count].last_used = image.last_used;
+			ages[count].n = n;
+			count++;
+		}
+	}
+	std::sort( ages, ages + count, compare_image_age );
+
+	// free a quarter of the limit, so this is not needed every frame
+	const size_t target = limit - limit / 4;
+	for(  uint32 i = 0;  i < count  &&  image_cache_bytes > target;  i++  ) {
+		imd &image = images[ages[i].n];
+		if(  image.zoom_data != NULL  ) {
+			image.recode_flags |= FLAG_REZOOM;
+		}
+		image.player_flags = 0xFFFF; // recode all player colors
+		image_cache_bytes -= free_img_cache( image );
+		image_cache_evictions++;
 	}
+	free( ages );
+}
+
+
+void display_get_image_cache_stats(image_cache_stats_t &stats)
+{
+	uint64 lookups = 0;
+#ifdef MULTI_THREAD
+	for(  int i = 0;  i < MAX_THREADS;  i++  ) {
+		lookups += clips[i].image_cache_lookups;
+	}
+#else
+	lookups = clips.image_cache_lookups;
+#endif
+	stats.misses = image_cache_misses;
+	stats.hits = lookups > image_cache_misses ? lookups - image_cache_misses : 0;
+	stats.evictions = image_cache_evictions;
+	stats.bytes = image_cache_bytes;
 }
 
 
@@ -2694,6 +2816,9 @@ void display_img_aux(const image_id n, scr_coord_val xp, scr_coord_val yp, const
 		// need to go to nightmode and or re-zoomed?
 		PIXVAL *sp;
 
+		images[n].last_used = image_cache_frame;
+		CR.image_cache_lookups++;
+
 		if(  use_player > 0  ) {
 			// player colour images are rezoomed/recoloured in display_color_img
 			sp = images[n].data[use_player];
@@ -3023,6 +3148,7 @@ void display_color_img(const image_id n, scr_coord_val xp, scr_coord_val yp, sin
 	if(  n < anz_images  ) {
 		// do we have to use a player nr?
 		const sint8 player_nr = (images[n].recode_flags & FLAG_HAS_PLAYER_COLOR) * player_nr_raw;
+		images[n].last_used = image_cache_frame;
 		// first: size check
 		if(  (images[n].recode_flags & FLAG_REZOOM)  ) {
 			rezoom_img( n );
@@ -3782,6 +3908,8 @@ static void display_img_alpha_wc(scr_coord_val h, const scr_coord_val xp, const
 void display_rezoomed_img_blend(const image_id n, scr_coord_val xp, scr_coord_val yp, const signed char /*player_nr*/, const FLAGGED_PIXVAL color_index, const bool /*daynight*/, const bool dirty  CLIP_NUM_DEF)
 {
 	if(  n < anz_images  ) {
+		images[n].last_used = image_cache_frame;
+		CR.image_cache_lookups++;
 		// need to go to nightmode and or rezoomed?
 		if(  (images[n].recode_flags & FLAG_REZOOM)  ) {
 			rezoom_img( n );
@@ -3863,6 +3991,9 @@ void display_rezoomed_img_blend(const image_id n, scr_coord_val xp, scr_coord_va
 void display_rezoomed_img_alpha(const image_id n, const image_id alpha_n, const unsigned alpha_flags, scr_coord_val xp, scr_coord_val yp, const sint8 /*player_nr*/, const FLAGGED_PIXVAL color_index, const bool /*daynight*/, const bool dirty  CLIP_NUM_DEF)
 {
 	if(  n < anz_images  &&  alpha_n < anz_images  ) {
+		images[n].last_used = image_cache_frame;
+		images[alpha_n].last_used = image_cache_frame;
+		CR.image_cache_lookups++;
 		// need to go to nightmode and or rezoomed?
 		if(  (images[n].recode_flags & FLAG_REZOOM)  ) {
 			rezoom_img( n );
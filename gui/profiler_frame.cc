@@ -0,0 +1,145 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "profiler_frame.h"
+
+#include "simwin.h"
+#include "messagebox.h"
+#include "components/gui_table.h"
+#include "../macros.h"
+#include "../dataobj/translator.h"
+#include "../sys/simsys.h"
+#include "../display/simgraph.h"
+#include "../utils/cbuffer_t.h"
+#include "../utils/simprofiler.h"
+
+
+#define PROFILE_CSV_FILE "profile.csv"
+
+
+static void add_stats_row(gui_aligned_container_t &cont, const char *name, const profiler_t::stats_t &stats)
+{
+	gui_table_cell_buf_t *th = cont.new_component<gui_table_cell_buf_t>("", SYSCOL_TH_BACKGROUND_LEFT, gui_label_t::left, true);
+	th->buf().append(name);
+	th->set_color(SYSCOL_TH_TEXT_LEFT);
+	th->set_flexible(true, false);
+	th->update();
+
+	const uint32 values[] = { stats.last, stats.mean, stats.p50, stats.p90, stats.p99, stats.max };
+	for(  uint8 i = 0;  i < lengthof(values);  i++  ) {
+		gui_table_cell_buf_t *td = cont.new_component<gui_table_cell_buf_t>("", SYSCOL_TD_BACKGROUND, gui_label_t::right, true);
+		td->buf().printf("%.2f", values[i] / 1000.0);
+		td->set_flexible(true, false);
+		td->update();
+	}
+}
+
+
+profiler_frame_t::profiler_frame_t() :
+	gui_frame_t( translator::translate("Performance profile") ),
+	scrolly(&cont_stats, true, true),
+	last_update(0)
+{
+	set_table_layout(1,0);
+
+	add_table(2,1);
+	{
+		bt_export.init(button_t::roundbox, "Export CSV");
+		bt_export.set_tooltip(PROFILE_CSV_FILE);
+		bt_export.add_listener(this);
+		add_component(&bt_export);
+
+		bt_reset.init(button_t::roundbox, "Reset");
+		bt_reset.add_listener(this);
+		add_component(&bt_reset);
+	}
+	end_table();
+
+	cont_stats.set_table_layout(1,0);
+	update_stats();
+	add_component(&scrolly);
+
+	set_resizemode(diagonal_resize);
+	scrolly.set_maximize(true);
+	reset_min_windowsize();
+	set_windowsize(scr_size(get_min_windowsize().w, D_TITLEBAR_HEIGHT + D_MARGINS_Y + 20 * (LINESPACE + 4)));
+}
+
+
+void profiler_frame_t::update_stats()
+{
+	last_update = dr_time();
+	cont_stats.remove_all();
+
+	// times in milliseconds
+	gui_aligned_container_t *tbl = cont_stats.add_table(7,0);
+	tbl->set_spacing(scr_size(1,1));
+	tbl->set_table_frame(true, true);
+	{
+		cont_stats.new_component<gui_table_header_t>("")->set_flexible(true, false);
+		cont_stats.new_component<gui_table_header_t>("last ms")->set_flexible(true, false);
+		cont_stats.new_component<gui_table_header_t>("mean")->set_flexible(true, false);
+		cont_stats.new_component<gui_table_header_t>("50%")->set_flexible(true, false);
+		cont_stats.new_component<gui_table_header_t>("90%")->set_flexible(true, false);
+		cont_stats.new_component<gui_table_header_t>("99%")->set_flexible(true, false);
+		cont_stats.new_component<gui_table_header_t>("max")->set_flexible(true, false);
+
+		profiler_t::stats_t stats;
+		for(  uint32 p = 0;  p < profiler_t::MAX_PHASES;  p++  ) {
+			if(  profiler_t::get_phase_stats( (profiler_t::phase_t)p, stats )  ) {
+				add_stats_row( cont_stats, profiler_t::get_phase_name( (profiler_t::phase_t)p ), stats );
+			}
+		}
+
+		for(  uint32 w = 0;  w < profiler_t::MAX_WORKERS;  w++  ) {
+			for(  uint32 t = 0;  t < MAX_THREADS;  t++  ) {
+				if(  profiler_t::get_worker_stats( (profiler_t::worker_t)w, t, stats )  ) {
+					cbuffer_t buf;
+					buf.printf( "%s %u", profiler_t::get_worker_name( (profiler_t::worker_t)w ), t );
+					add_stats_row( cont_stats, buf, stats );
+				}
+			}
+		}
+	}
+	cont_stats.end_table();
+
+	image_cache_stats_t cache;
+	display_get_image_cache_stats( cache );
+	const uint64 lookups = cache.hits + cache.misses;
+	gui_label_buf_t *lb = cont_stats.new_component<gui_label_buf_t>();
+	lb->buf().printf( translator::translate("Image cache: %.1f MiB, %.1f%% hits, %u freed"), cache.bytes / 1048576.0, lookups ? (cache.hits * 100.0) / lookups : 100.0, (unsigned)cache.evictions );
+	lb->update();
+
+	cont_stats.set_size(cont_stats.get_min_size());
+}
+
+
+bool profiler_frame_t::action_triggered(gui_action_creator_t *comp, value_t)
+{
+	if(  comp == &bt_export  ) {
+		cbuffer_t buf;
+		if(  profiler_t::write_csv( PROFILE_CSV_FILE )  ) {
+			buf.printf( translator::translate("Profile written to %s"), PROFILE_CSV_FILE );
+		}
+		else {
+			buf.printf( translator::translate("Cannot write %s"), PROFILE_CSV_FILE );
+		}
+		create_win( new news_img(buf), w_time_delete, magic_none );
+	}
+	else if(  comp == &bt_reset  ) {
+		profiler_t::reset();
+		update_stats();
+	}
+	return true;
+}
+
+
+void profiler_frame_t::draw(scr_coord pos, scr_size size)
+{
+	if(  dr_time() - last_update > 1000  ) {
+		update_stats();
+	}
+	gui_frame_t::draw(pos, size);
+}
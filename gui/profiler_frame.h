@@ -0,0 +1,39 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef GUI_PROFILER_FRAME_H
+#define GUI_PROFILER_FRAME_H
+
+
+#include "gui_frame.h"
+#include "components/action_listener.h"
+#include "components/gui_aligned_container.h"
+#include "components/gui_button.h"
+#include "components/gui_scrollpane.h"
+
+
+/**
+ * Shows the timings collected by profiler_t: the phases of the world steps
+ * and the work of the worker threads, refreshed every second. Below them
+ * the use of the image cache.
+ */
+class profiler_frame_t : public gui_frame_t, private action_listener_t
+{
+	gui_aligned_container_t cont_stats;
+	gui_scrollpane_t scrolly;
+	button_t bt_export, bt_reset;
+	uint32 last_update;
+
+	void update_stats();
+
+public:
+	profiler_frame_t();
+
+	bool action_triggered(gui_action_creator_t*, value_t) OVERRIDE;
+
+	void draw(scr_coord pos, scr_size size) OVERRIDE;
+};
+
+#endif
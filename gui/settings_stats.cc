@@ -146,7 +146,8 @@ static const char *revision_ex[] =
 	"60",
 	"61",
 	"62",
-	"63"
+	"63",
+	"64"
 };
 
 
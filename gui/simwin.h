@@ -132,6 +132,7 @@ enum magic_numbers {
 	magic_pier_rotation_select,
 	magic_depot, // only used to load/save
 	magic_replace_line,
+	magic_profiler,
 	magic_max
 };
 
@@ -1187,52 +1187,51 @@ void way_info_t::update_way_info()
 		weg_t *road = way1->get_waytype() == road_wt ? way1 : way2;
 		uint32 cities_count = 0;
 		building_list.clear();
-		for(uint8 i=0;i<5;i++) {
-			for(uint32 j=0;j<road->private_car_routes[road->private_car_routes_currently_reading_element][i].get_count();j++){
-				const koord dest = road->private_car_routes[road->private_car_routes_currently_reading_element][i][j];
-				const grund_t* gr_temp = welt->lookup_kartenboden(dest);
-
-				if( gr_temp && gr_temp->get_building() ){
-					building_list.append(dest);
-					continue;
-				}
-				else {
-					dbg->message("way_info_t::update_way_info()", "Building that is a destination of a road route not found");
-				}
-
-				const stadt_t* dest_city = welt->get_city(dest);
-				if (dest_city && dest == dest_city->get_townhall_road())
-				{
-					cities_count++;
-					button_t *b = cont_road_routes.new_component<button_t>();
-					b->set_typ(button_t::posbutton_automatic);
-					b->set_targetpos(dest_city->get_pos());
-
-					cont_road_routes.new_component<gui_label_t>(dest_city->get_name());
-
-					// region
-					if (!welt->get_settings().regions.empty()) {
-						gui_label_buf_t *lb_region = cont_road_routes.new_component<gui_label_buf_t>();
-						lb_region->buf().printf(" (%s)", translator::translate(welt->get_region_name(dest_city->get_pos()).c_str()));
-						lb_region->update();
-					}
+		vector_tpl<koord> destinations;
+		road->get_private_car_route_destinations(destinations);
+		FOR(vector_tpl<koord>, const dest, destinations) {
+			const grund_t* gr_temp = welt->lookup_kartenboden(dest);
+
+			if( gr_temp && gr_temp->get_building() ){
+				building_list.append(dest);
+				continue;
+			}
+			else {
+				dbg->message("way_info_t::update_way_info()", "Building that is a destination of a road route not found");
+			}
 
-					// distance
-					const uint32 distance = shortest_distance(gr->get_pos().get_2d(), dest_city->get_pos()) * welt->get_settings().get_meters_per_tile();
-					gui_label_buf_t *lb_city = cont_road_routes.new_component<gui_label_buf_t>();
-					if (distance < 1000) {
-						lb_city->buf().printf("%um", distance);
-					}
-					else if (distance < 20000) {
-						lb_city->buf().printf("%.1fkm", (double)distance / 1000.0);
-					}
-					else {
-						lb_city->buf().printf("%ukm", distance / 1000);
-					}
-					lb_city->update();
+			const stadt_t* dest_city = welt->get_city(dest);
+			if (dest_city && dest == dest_city->get_townhall_road())
+			{
+				cities_count++;
+				button_t *b = cont_road_routes.new_component<button_t>();
+				b->set_typ(button_t::posbutton_automatic);
+				b->set_targetpos(dest_city->get_pos());
+
+				cont_road_routes.new_component<gui_label_t>(dest_city->get_name());
+
+				// region
+				if (!welt->get_settings().regions.empty()) {
+					gui_label_buf_t *lb_region = cont_road_routes.new_component<gui_label_buf_t>();
+					lb_region->buf().printf(" (%s)", translator::translate(welt->get_region_name(dest_city->get_pos()).c_str()));
+					lb_region->update();
 				}
 
+				// distance
+				const uint32 distance = shortest_distance(gr->get_pos().get_2d(), dest_city->get_pos()) * welt->get_settings().get_meters_per_tile();
+				gui_label_buf_t *lb_city = cont_road_routes.new_component<gui_label_buf_t>();
+				if (distance < 1000) {
+					lb_city->buf().printf("%um", distance);
+				}
+				else if (distance < 20000) {
+					lb_city->buf().printf("%.1fkm", (double)distance / 1000.0);
+				}
+				else {
+					lb_city->buf().printf("%ukm", distance / 1000);
+				}
+				lb_city->update();
 			}
+
 		}
 		lb_city_count.buf().printf(translator::translate("%u cities"), cities_count);
 		lb_city_count.update();
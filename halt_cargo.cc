@@ -0,0 +1,167 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "halt_cargo.h"
+
+#include "utils/for.h"
+
+
+halt_cargo_t::bucket_t *halt_cargo_t::get_or_create_bucket(halthandle_t via, uint8 g_class)
+{
+	const uint32 key = get_bucket_key( via, g_class );
+	bucket_t *bucket = bucket_index.get( key );
+	if(  bucket == NULL  ) {
+		bucket = new bucket_t( via, g_class );
+		buckets.append( bucket );
+		bucket_index.put( key, bucket );
+	}
+	return bucket;
+}
+
+
+void halt_cargo_t::add_to_sums(const ware_t &ware, uint32 menge)
+{
+	const uint32 key = get_sum_key( ware.get_index(), ware.get_class(), ware.is_commuting_trip );
+	uint32 *sum = sums.access( key );
+	if(  sum  ) {
+		*sum += menge;
+	}
+	else {
+		sums.put( key, menge );
+	}
+}
+
+
+void halt_cargo_t::remove_from_sums(const ware_t &ware, uint32 menge)
+{
+	uint32 *sum = sums.access( get_sum_key( ware.get_index(), ware.get_class(), ware.is_commuting_trip ) );
+	assert( sum  &&  *sum >= menge );
+	if(  sum  ) {
+		*sum -= menge;
+	}
+}
+
+
+void halt_cargo_t::add(const ware_t &ware, bool reuse_empty)
+{
+	bucket_t *bucket = get_or_create_bucket( ware.get_zwischenziel(), ware.get_class() );
+	bucket->sum += ware.menge;
+	bucket->ziel_mask |= get_ziel_bit( ware.get_ziel() );
+	add_to_sums( ware, ware.menge );
+
+	if(  reuse_empty  ) {
+		FOR(vector_tpl<ware_t>, &w, bucket->wares) {
+			if(  w.menge == 0  ) {
+				w = ware;
+				return;
+			}
+		}
+	}
+	bucket->wares.append( ware );
+	count++;
+}
+
+
+void halt_cargo_t::take(ware_t &ware, uint32 menge)
+{
+	assert( menge <= ware.menge );
+	bucket_t *bucket = get_bucket( ware.get_zwischenziel(), ware.get_class() );
+	assert( bucket );
+	if(  bucket  ) {
+		bucket->sum -= menge;
+	}
+	remove_from_sums( ware, menge );
+	ware.menge -= menge;
+}
+
+
+void halt_cargo_t::set_via(ware_t &ware, halthandle_t via)
+{
+	bucket_t *old_bucket = get_bucket( ware.get_zwischenziel(), ware.get_class() );
+	assert( old_bucket );
+	if(  old_bucket  ) {
+		old_bucket->sum -= ware.menge;
+	}
+	bucket_t *bucket = get_or_create_bucket( via, ware.get_class() );
+	bucket->sum += ware.menge;
+	bucket->ziel_mask |= get_ziel_bit( ware.get_ziel() );
+	ware.set_zwischenziel( via );
+}
+
+
+void halt_cargo_t::tidy(bucket_t *bucket)
+{
+	vector_tpl<ware_t> moved;
+	vector_tpl<ware_t> &wares = bucket->wares;
+	uint32 kept = 0;
+	bucket->ziel_mask = 0;
+	for(  uint32 i = 0;  i < wares.get_count();  i++  ) {
+		const ware_t &ware = wares[i];
+		if(  ware.menge == 0  ) {
+			continue;
+		}
+		if(  ware.get_zwischenziel() != bucket->via  ) {
+			moved.append( ware );
+			continue;
+		}
+		bucket->ziel_mask |= get_ziel_bit( ware.get_ziel() );
+		if(  kept != i  ) {
+			wares[kept] = ware;
+		}
+		kept++;
+	}
+	count -= wares.get_count() - kept;
+	wares.set_count( kept );
+
+	// the sums were already moved by set_via()
+	FOR(vector_tpl<ware_t>, const &ware, moved) {
+		bucket_t *target = get_or_create_bucket( ware.get_zwischenziel(), ware.get_class() );
+		target->wares.append( ware );
+		target->ziel_mask |= get_ziel_bit( ware.get_ziel() );
+		count++;
+	}
+}
+
+
+void halt_cargo_t::tidy()
+{
+	// tidy() may add buckets, which are tidy already
+	const uint32 bucket_count = buckets.get_count();
+	for(  uint32 i = 0;  i < bucket_count;  i++  ) {
+		tidy( buckets[i] );
+	}
+}
+
+
+void halt_cargo_t::rebuild()
+{
+	vector_tpl<ware_t> wares( count );
+	get_all( wares );
+	clear();
+	FOR(vector_tpl<ware_t>, const &ware, wares) {
+		add( ware, false );
+	}
+}
+
+
+void halt_cargo_t::get_all(vector_tpl<ware_t> &wares) const
+{
+	FOR(vector_tpl<bucket_t *>, const bucket, buckets) {
+		FOR(vector_tpl<ware_t>, const &ware, bucket->wares) {
+			if(  ware.menge > 0  ) {
+				wares.append( ware );
+			}
+		}
+	}
+}
+
+
+void halt_cargo_t::clear()
+{
+	clear_ptr_vector( buckets );
+	bucket_index.clear();
+	sums.clear();
+	count = 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef HALT_CARGO_H
+#define HALT_CARGO_H
+
+
+#include "simtypes.h"
+#include "macros.h"
+#include "halthandle_t.h"
+#include "simware.h"
+
+#include "tpl/vector_tpl.h"
+#include "tpl/inthashtable_tpl.h"
+
+
+/**
+ * The goods of one category waiting at a stop.
+ *
+ * The packets are kept in buckets of the same next transfer and class, so a
+ * loading convoy only needs to look at the buckets of the stops it serves.
+ * The amounts are summed up per bucket and per goods type and class while
+ * the packets are added and taken, hence these sums cost nothing to query.
+ *
+ * All changes of the amount or the next transfer of a stored packet must
+ * therefore go through this class. Other fields may be changed directly.
+ */
+class halt_cargo_t
+{
+public:
+	/// all packets with the same next transfer and class
+	class bucket_t
+	{
+	public:
+		halthandle_t via;
+		uint8 g_class;
+
+		/// sum of the amounts of the packets
+		uint32 sum;
+
+		/**
+		 * Bit (id % 64) is set for the destinations of the packets. Bits are
+		 * only cleared by tidy(), so this may tell of destinations which are
+		 * no longer here, but never misses one.
+		 */
+		uint64 ziel_mask;
+
+		/// may contain empty packets until tidied
+		vector_tpl<ware_t> wares;
+
+		bucket_t(halthandle_t via, uint8 g_class) : via(via), g_class(g_class), sum(0), ziel_mask(0) {}
+	};
+
+	static uint64 get_ziel_bit(halthandle_t halt) { return (uint64)1 << (halt.get_id() & 63); }
+
+private:
+	/// in order of creation, which is the same on all clients
+	vector_tpl<bucket_t *> buckets;
+
+	inthashtable_tpl<uint32, bucket_t *, N_BAGS_SMALL> bucket_index;
+
+	/// sums of the amounts per goods type, class and commuting trips
+	inthashtable_tpl<uint32, uint32, N_BAGS_SMALL> sums;
+
+	/// number of packets, including empty ones
+	uint32 count;
+
+	static uint32 get_bucket_key(halthandle_t via, uint8 g_class) { return ((uint32)via.get_id() << 8) | g_class; }
+
+	static uint32 get_sum_key(uint8 index, uint8 g_class, bool commuting) { return ((uint32)index << 9) | ((uint32)g_class << 1) | (commuting ? 1 : 0); }
+
+	bucket_t *get_or_create_bucket(halthandle_t via, uint8 g_class);
+
+	void add_to_sums(const ware_t &ware, uint32 menge);
+	void remove_from_sums(const ware_t &ware, uint32 menge);
+
+public:
+	halt_cargo_t() : count(0) {}
+	~halt_cargo_t() { clear(); }
+
+	const vector_tpl<bucket_t *> &get_buckets() const { return buckets; }
+
+	/// @return NULL if there were never goods for this next transfer and class
+	bucket_t *get_bucket(halthandle_t via, uint8 g_class) const { return bucket_index.get( get_bucket_key( via, g_class ) ); }
+
+	/// number of packets, including empty ones
+	uint32 get_count() const { return count; }
+
+	bool empty() const { return count == 0; }
+
+	/**
+	 * Stores a copy of the packet in the bucket of its next transfer.
+	 * @param reuse_empty if true, an empty packet of the bucket is overwritten
+	 */
+	void add(const ware_t &ware, bool reuse_empty);
+
+	/**
+	 * Reduces the amount of a stored packet. Empty packets are kept, so
+	 * pointers to packets stay valid until the next add() or tidy().
+	 */
+	void take(ware_t &ware, uint32 menge);
+
+	/**
+	 * Changes the next transfer of a stored packet. The packet is accounted
+	 * for in its new bucket at once, but stays in the vector of the old one
+	 * until that is tidied, so pointers to packets stay valid.
+	 */
+	void set_via(ware_t &ware, halthandle_t via);
+
+	/// removes the empty packets and moves those with a changed next transfer to their bucket
+	void tidy(bucket_t *bucket);
+	void tidy();
+
+	/**
+	 * Sorts all packets into buckets anew and sums them up again.
+	 * For when the next transfers or amounts were changed directly, like
+	 * during loading.
+	 */
+	void rebuild();
+
+	/// @return sum of the amounts of this goods type and class
+	uint32 get_sum(uint8 index, uint8 g_class) const { return sums.get( get_sum_key( index, g_class, false ) ) + sums.get( get_sum_key( index, g_class, true ) ); }
+
+	/// @return sum of the amounts of commuters of this goods type and class
+	uint32 get_commuter_sum(uint8 index, uint8 g_class) const { return sums.get( get_sum_key( index, g_class, true ) ); }
+
+	/// appends all non-empty packets
+	void get_all(vector_tpl<ware_t> &wares) const;
+
+	void clear();
+};
+
+#endif
@@ -41,6 +41,13 @@ public:
 
 	// return the cost of a single step upwards
 	virtual uint32 get_cost_upslope() const { return 0; } // Standard is 25
+
+	/**
+	 * Drivers with the same key find the same routes between the same tiles,
+	 * as long as the ways do not change. route_t::calc_route() then shares them.
+	 * @return false if the routes of this driver must not be shared
+	 */
+	virtual bool get_route_cache_key(uint64 &) const { return false; }
 };
 
 #endif
@@ -26,6 +26,15 @@ public:
 	 */
 	virtual sync_result sync_step(uint32 delta_t) = 0;
 
+	/**
+	 * Called in list order before the objects are stepped in parallel.
+	 * If the next sync_step() will only change this object itself (and
+	 * returns SYNC_OK), this returns the map row (y) of the object and
+	 * takes care of everything else, like marking the image dirty.
+	 * Otherwise -1: then sync_step() is called in list order as usual.
+	 */
+	virtual sint16 prepare_parallel_sync_step(uint32 /*delta_t*/) { return -1; }
+
 	virtual ~sync_steppable() {}
 };
 
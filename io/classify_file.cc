@@ -6,6 +6,7 @@
 #include "classify_file.h"
 
 #include "rdwr/bzip2_file_rdwr_stream.h"
+#include "rdwr/chunked_file_rdwr_stream.h"
 #include "rdwr/raw_file_rdwr_stream.h"
 #include "rdwr/zlib_file_rdwr_stream.h"
 #if USE_ZSTD
@@ -30,8 +31,8 @@ bool classify_as_bmp(FILE *f, file_info_t *info);
 bool classify_as_ppm(FILE *f, file_info_t *info);
 bool classify_as_zstd(FILE *f, file_info_t *info);
 bool classify_as_bzip2(FILE *f, file_info_t *info);
+bool classify_as_chunked(FILE *f, file_info_t *info);
 bool classify_as_zip(FILE *f, file_info_t *info);
-bool classify_file_data(rdwr_stream_t *stream, file_info_t *info);
 
 
 file_info_t::file_info_t() :
@@ -86,6 +87,20 @@ file_classify_status_t classify_file(const char *path, file_info_t *info)
 		return FILE_CLASSIFY_OK;
 	}
 
+	fseek(f, 0, SEEK_SET);
+	if (classify_as_chunked(f, info)) {
+		fclose(f);
+
+		chunked_file_rdwr_stream_t s(path, false, 0);
+		if (!classify_file_data(&s, info)) {
+			info->file_type = file_info_t::TYPE_RAW;
+			info->ext_version = extended_version_t::INVALID;
+			info->header_size = 0;
+		}
+
+		return FILE_CLASSIFY_OK;
+	}
+
 	fseek(f, 0, SEEK_SET);
 	if (classify_as_bzip2(f, info)) {
 		fclose(f);
@@ -237,6 +252,22 @@ bool classify_as_bzip2(FILE *f, file_info_t *info)
 }
 
 
+bool classify_as_chunked(FILE *f, file_info_t *info)
+{
+	char buf[80];
+	if (fread(buf, 1, 2, f) != 2) {
+		return false;
+	}
+
+	if(  memcmp(buf, "CK", 2) != 0) {
+		return false; // not chunked
+	}
+
+	info->file_type = file_info_t::TYPE_CHUNKED;
+	return true;
+}
+
+
 bool classify_as_zstd(FILE *f, file_info_t *info)
 {
 	char buf[80];
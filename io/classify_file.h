@@ -11,6 +11,9 @@
 #include "../simtypes.h"
 
 
+class rdwr_stream_t;
+
+
 enum file_classify_status_t {
 	FILE_CLASSIFY_OK = 0,
 	FILE_CLASSIFY_INVALID_ARGS,
@@ -43,6 +46,7 @@ struct file_info_t
 		TYPE_ZIPPED,  // zipped save
 		TYPE_BZIP2,   // bzip2 compressed save
 		TYPE_ZSTD,    // zstd compressed save
+		TYPE_CHUNKED, // save of zlib compressed blocks
 
 		TYPE_PNG,     // PNG image
 		TYPE_BMP,
@@ -53,7 +57,8 @@ struct file_info_t
 		// Combined file formats
 		TYPE_XML_ZIPPED = TYPE_XML | TYPE_ZIPPED,
 		TYPE_XML_BZIP2  = TYPE_XML | TYPE_BZIP2,
-		TYPE_XML_ZSTD   = TYPE_XML | TYPE_ZSTD
+		TYPE_XML_ZSTD   = TYPE_XML | TYPE_ZSTD,
+		TYPE_XML_CHUNKED = TYPE_XML | TYPE_CHUNKED
 	};
 
 public:
@@ -87,5 +92,13 @@ file_classify_status_t classify_file(const char *path, file_info_t *info);
  */
 file_classify_status_t classify_image_file(const char *path, file_info_t *info);
 
+/**
+ * Classify the uncompressed data of a savegame by its header.
+ * @param stream positioned at the start of the data; the header is consumed.
+ * @param info file_type must be set before, TYPE_XML is added for XML data.
+ * @returns true iff this is a Simutrans savegame with a valid version.
+ */
+bool classify_file_data(rdwr_stream_t *stream, file_info_t *info);
+
 
 #endif
@@ -0,0 +1,350 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "chunked_file_rdwr_stream.h"
+
+#include "../../dataobj/environment.h"
+#include "../../simconst.h"
+#include "../../simdebug.h"
+#include "../../simmem.h"
+#include "../../macros.h"
+
+#ifdef MULTI_THREAD
+#include "../../utils/simthread.h"
+#endif
+
+#include <zlib.h>
+#include <string.h>
+
+
+#define CHUNKED_BLOCK_SIZE (1 << 20) // 1MiB of raw data per block
+#define CHUNKED_MAX_BLOCKS (1 << 16) // sanity check for the table of contents
+
+
+static void put_uint32(char *p, uint32 v)
+{
+	for(  int i = 0;  i < 4;  i++  ) {
+		p[i] = (char)(v >> (8 * i));
+	}
+}
+
+
+static uint32 get_uint32(const char *p)
+{
+	uint32 v = 0;
+	for(  int i = 0;  i < 4;  i++  ) {
+		v |= (uint32)(uint8)p[i] << (8 * i);
+	}
+	return v;
+}
+
+
+static void put_uint64(char *p, uint64 v)
+{
+	put_uint32( p, (uint32)v );
+	put_uint32( p + 4, (uint32)(v >> 32) );
+}
+
+
+static uint64 get_uint64(const char *p)
+{
+	return (uint64)get_uint32( p ) | ((uint64)get_uint32( p + 4 ) << 32);
+}
+
+
+static void *pack_block(void *ptr)
+{
+	chunked_file_rdwr_stream_t::block_t *block = (chunked_file_rdwr_stream_t::block_t *)ptr;
+	uLongf len = block->packed_size;
+	block->ok = compress2( (Bytef *)block->packed, &len, (const Bytef *)block->raw, block->raw_len, block->level ) == Z_OK;
+	block->packed_len = (uint32)len;
+	return NULL;
+}
+
+
+static void *unpack_block(void *ptr)
+{
+	chunked_file_rdwr_stream_t::block_t *block = (chunked_file_rdwr_stream_t::block_t *)ptr;
+	uLongf len = block->raw_len;
+	block->ok = uncompress( (Bytef *)block->raw, &len, (const Bytef *)block->packed, block->packed_len ) == Z_OK  &&  len == block->raw_len;
+	return NULL;
+}
+
+
+/// calls func for the first count blocks, each in its own thread
+static void process_blocks(vector_tpl<chunked_file_rdwr_stream_t::block_t> &blocks, uint32 count, void *(*func)(void *))
+{
+#ifdef MULTI_THREAD
+	pthread_t threads[MAX_THREADS];
+	bool started[MAX_THREADS];
+	for(  uint32 i = 1;  i < count;  i++  ) {
+		started[i] = pthread_create( &threads[i], NULL, func, &blocks[i] ) == 0;
+		if(  !started[i]  ) {
+			func( &blocks[i] );
+		}
+	}
+	if(  count > 0  ) {
+		func( &blocks[0] );
+	}
+	for(  uint32 i = 1;  i < count;  i++  ) {
+		if(  started[i]  ) {
+			pthread_join( threads[i], NULL );
+		}
+	}
+#else
+	for(  uint32 i = 0;  i < count;  i++  ) {
+		func( &blocks[i] );
+	}
+#endif
+}
+
+
+chunked_file_rdwr_stream_t::chunked_file_rdwr_stream_t(const std::string &filename, bool writing, int compression) :
+	raw_file_rdwr_stream_t(filename, writing),
+	batch_count(0),
+	current(0),
+	pos(0),
+	file_pos(0),
+	next_block(0),
+	finished(false)
+{
+	if(  status != STATUS_OK  ||  file == NULL  ) {
+		status = STATUS_ERR_NOT_EXISTING;
+		return; // Could not open file
+	}
+
+#ifdef MULTI_THREAD
+	const uint32 threads = clamp( (uint32)env_t::num_threads, 1u, (uint32)MAX_THREADS );
+#else
+	const uint32 threads = 1;
+#endif
+	batch.resize( threads );
+	for(  uint32 i = 0;  i < threads;  i++  ) {
+		block_t block;
+		block.raw = (char *)xmalloc( CHUNKED_BLOCK_SIZE );
+		block.raw_len = 0;
+		block.packed_size = (uint32)compressBound( CHUNKED_BLOCK_SIZE );
+		block.packed = (char *)xmalloc( block.packed_size );
+		block.packed_len = 0;
+		block.level = clamp( compression, 1, 9 );
+		block.ok = true;
+		batch.append( block );
+	}
+
+	if(  writing  ) {
+		// the additional magic for chunked files
+		if(  raw_file_rdwr_stream_t::write( "CK", 2 ) != 2  ) {
+			return;
+		}
+		file_pos = 2;
+	}
+	else {
+		char buf[16];
+		if(  raw_file_rdwr_stream_t::read( buf, 2 ) != 2  ||  buf[0] != 'C'  ||  buf[1] != 'K'  ) {
+			status = STATUS_ERR_CORRUPT;
+			return;
+		}
+
+		// read the table of contents from the end
+		if(  fseek( file, -12, SEEK_END ) != 0  ||  raw_file_rdwr_stream_t::read( buf, 12 ) != 12  ||  memcmp( buf + 8, "CKIX", 4 ) != 0  ) {
+			dbg->error( "chunked_file_rdwr_stream_t::chunked_file_rdwr_stream_t", "No table of contents, file truncated?" );
+			status = STATUS_ERR_CORRUPT;
+			return;
+		}
+		const uint64 toc_offset = get_uint64( buf );
+		if(  fseek( file, (long)toc_offset, SEEK_SET ) != 0  ||  raw_file_rdwr_stream_t::read( buf, 4 ) != 4  ) {
+			status = STATUS_ERR_CORRUPT;
+			return;
+		}
+		const uint32 count = get_uint32( buf );
+		if(  count > CHUNKED_MAX_BLOCKS  ) {
+			status = STATUS_ERR_CORRUPT;
+			return;
+		}
+		toc.resize( count );
+		for(  uint32 i = 0;  i < count;  i++  ) {
+			if(  raw_file_rdwr_stream_t::read( buf, 16 ) != 16  ) {
+				status = STATUS_ERR_CORRUPT;
+				return;
+			}
+			toc_entry_t entry;
+			entry.offset     = get_uint64( buf );
+			entry.packed_len = get_uint32( buf + 8 );
+			entry.raw_len    = get_uint32( buf + 12 );
+			if(  entry.raw_len > CHUNKED_BLOCK_SIZE  ||  entry.packed_len > batch[0].packed_size  ) {
+				status = STATUS_ERR_CORRUPT;
+				return;
+			}
+			toc.append( entry );
+		}
+	}
+
+	status = STATUS_OK;
+}
+
+
+chunked_file_rdwr_stream_t::~chunked_file_rdwr_stream_t()
+{
+	for(  uint32 i = 0;  i < batch.get_count();  i++  ) {
+		free( batch[i].raw );
+		free( batch[i].packed );
+	}
+}
+
+
+void chunked_file_rdwr_stream_t::finish()
+{
+	if(  !is_writing()  ||  finished  ||  file == NULL  ||  batch.empty()  ||  status != STATUS_OK  ) {
+		return;
+	}
+	finished = true;
+
+	if(  batch_count < batch.get_count()  &&  batch[batch_count].raw_len > 0  ) {
+		batch_count++;
+	}
+	if(  !write_batch()  ) {
+		return; // status is already set
+	}
+
+	// end of data
+	char buf[16];
+	put_uint32( buf, 0 );
+	put_uint32( buf + 4, 0 );
+	bool ok = raw_file_rdwr_stream_t::write( buf, 8 ) == 8;
+	const uint64 toc_offset = file_pos + 8;
+
+	put_uint32( buf, toc.get_count() );
+	ok = ok  &&  raw_file_rdwr_stream_t::write( buf, 4 ) == 4;
+	for(  uint32 i = 0;  ok  &&  i < toc.get_count();  i++  ) {
+		put_uint64( buf, toc[i].offset );
+		put_uint32( buf + 8, toc[i].packed_len );
+		put_uint32( buf + 12, toc[i].raw_len );
+		ok = raw_file_rdwr_stream_t::write( buf, 16 ) == 16;
+	}
+
+	put_uint64( buf, toc_offset );
+	memcpy( buf + 8, "CKIX", 4 );
+	ok = ok  &&  raw_file_rdwr_stream_t::write( buf, 12 ) == 12;
+
+	// the data must be on the disk before the status is reported
+	if(  ok  &&  fflush( file ) != 0  ) {
+		status = STATUS_ERR_FULL;
+	}
+}
+
+
+bool chunked_file_rdwr_stream_t::write_batch()
+{
+	process_blocks( batch, batch_count, pack_block );
+
+	for(  uint32 i = 0;  i < batch_count;  i++  ) {
+		block_t &block = batch[i];
+		if(  !block.ok  ) {
+			dbg->error( "chunked_file_rdwr_stream_t::write_batch", "Error during compression" );
+			status = STATUS_ERR_CORRUPT;
+			return false;
+		}
+
+		char buf[8];
+		put_uint32( buf, block.packed_len );
+		put_uint32( buf + 4, block.raw_len );
+		toc_entry_t entry;
+		entry.offset     = file_pos;
+		entry.packed_len = block.packed_len;
+		entry.raw_len    = block.raw_len;
+		toc.append( entry );
+
+		if(  raw_file_rdwr_stream_t::write( buf, 8 ) != 8  ||  raw_file_rdwr_stream_t::write( block.packed, block.packed_len ) != block.packed_len  ) {
+			return false; // status is already set
+		}
+		file_pos += 8 + block.packed_len;
+		block.raw_len = 0;
+	}
+	batch_count = 0;
+	return true;
+}
+
+
+bool chunked_file_rdwr_stream_t::read_batch()
+{
+	batch_count = 0;
+	current = 0;
+	pos = 0;
+
+	while(  batch_count < batch.get_count()  &&  next_block < toc.get_count()  ) {
+		const toc_entry_t &entry = toc[next_block];
+		block_t &block = batch[batch_count];
+		char buf[8];
+		if(  fseek( file, (long)entry.offset, SEEK_SET ) != 0  ||  raw_file_rdwr_stream_t::read( buf, 8 ) != 8  ||
+			get_uint32( buf ) != entry.packed_len  ||  get_uint32( buf + 4 ) != entry.raw_len  ||
+			raw_file_rdwr_stream_t::read( block.packed, entry.packed_len ) != entry.packed_len  ) {
+			dbg->error( "chunked_file_rdwr_stream_t::read_batch", "Block %u does not match table of contents", next_block );
+			status = STATUS_ERR_CORRUPT;
+			return false;
+		}
+		block.packed_len = entry.packed_len;
+		block.raw_len    = entry.raw_len;
+		batch_count++;
+		next_block++;
+	}
+
+	process_blocks( batch, batch_count, unpack_block );
+
+	for(  uint32 i = 0;  i < batch_count;  i++  ) {
+		if(  !batch[i].ok  ) {
+			dbg->error( "chunked_file_rdwr_stream_t::read_batch", "Error during decompression" );
+			status = STATUS_ERR_CORRUPT;
+			return false;
+		}
+	}
+	return batch_count > 0;
+}
+
+
+size_t chunked_file_rdwr_stream_t::read(void *buf, size_t len)
+{
+	size_t done = 0;
+	while(  done < len  ) {
+		if(  current >= batch_count  ) {
+			if(  !read_batch()  ) {
+				if(  status == STATUS_OK  ) {
+					status = STATUS_EOF;
+				}
+				return done;
+			}
+		}
+		const block_t &block = batch[current];
+		const size_t n = min( len - done, (size_t)(block.raw_len - pos) );
+		memcpy( (char *)buf + done, block.raw + pos, n );
+		done += n;
+		pos += (uint32)n;
+		if(  pos == block.raw_len  ) {
+			current++;
+			pos = 0;
+		}
+	}
+	status = STATUS_OK;
+	return done;
+}
+
+
+size_t chunked_file_rdwr_stream_t::write(const void *buf, size_t len)
+{
+	size_t done = 0;
+	while(  done < len  ) {
+		block_t &block = batch[batch_count];
+		const size_t n = min( len - done, (size_t)(CHUNKED_BLOCK_SIZE - block.raw_len) );
+		memcpy( block.raw + block.raw_len, (const char *)buf + done, n );
+		block.raw_len += (uint32)n;
+		done += n;
+		if(  block.raw_len == CHUNKED_BLOCK_SIZE  ) {
+			batch_count++;
+			if(  batch_count == batch.get_count()  &&  !write_batch()  ) {
+				return 0;
+			}
+		}
+	}
+	return len;
+}
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef IO_RDWR_CHUNKED_FILE_RDWR_STREAM_H
+#define IO_RDWR_CHUNKED_FILE_RDWR_STREAM_H
+
+
+#include "raw_file_rdwr_stream.h"
+
+#include "../../tpl/vector_tpl.h"
+
+
+/**
+ * Reads/writes data from/to a file made of independently deflated blocks,
+ * so all threads can compress and decompress at the same time.
+ *
+ * Layout: "CK", then per block its packed and raw length (uint32, little
+ * endian) and the packed data, a block of length zero, the table of
+ * contents (number of blocks, then offset, packed and raw length of each)
+ * and finally the offset of the table of contents and "CKIX".
+ */
+class chunked_file_rdwr_stream_t : public raw_file_rdwr_stream_t
+{
+public:
+	chunked_file_rdwr_stream_t(const std::string &filename, bool writing, int compression);
+	~chunked_file_rdwr_stream_t();
+
+public:
+	/// @copydoc rdwr_stream_t::read
+	size_t read(void *buf, size_t len) OVERRIDE;
+
+	/// @copydoc rdwr_stream_t::write
+	size_t write(const void *buf, size_t len) OVERRIDE;
+
+	/// Writes the last blocks, the table of contents and the footer.
+	void finish() OVERRIDE;
+
+public:
+	struct block_t
+	{
+		char *raw;
+		uint32 raw_len;
+		char *packed;
+		uint32 packed_len;
+		uint32 packed_size; ///< allocated size of packed
+		int level;          ///< compression level, when writing
+		bool ok;
+	};
+
+	struct toc_entry_t
+	{
+		uint64 offset;
+		uint32 packed_len;
+		uint32 raw_len;
+	};
+
+private:
+	/// blocks handled at the same time, one per thread
+	vector_tpl<block_t> batch;
+	/// when writing: blocks filled; when reading: blocks decompressed
+	uint32 batch_count;
+	/// current block in batch and position in it
+	uint32 current;
+	uint32 pos;
+
+	vector_tpl<toc_entry_t> toc;
+	/// when writing: bytes written so far; when reading: next block in toc
+	uint64 file_pos;
+	uint32 next_block;
+
+	/// when writing: finish() was called
+	bool finished;
+
+	/// compresses the filled blocks and writes them
+	bool write_batch();
+
+	/// reads and decompresses the next blocks
+	bool read_batch();
+};
+
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "memory_rdwr_stream.h"
+
+#include <cassert>
+#include <cstring>
+
+
+memory_rdwr_stream_t::memory_rdwr_stream_t(std::string &target) :
+	rdwr_stream_t(true),
+	target(&target),
+	data(NULL),
+	len(0),
+	pos(0)
+{
+	status = STATUS_OK;
+}
+
+
+memory_rdwr_stream_t::memory_rdwr_stream_t(const char *data, size_t len) :
+	rdwr_stream_t(false),
+	target(NULL),
+	data(data),
+	len(len),
+	pos(0)
+{
+	status = data ? STATUS_OK : STATUS_ERR_NOT_EXISTING;
+}
+
+
+size_t memory_rdwr_stream_t::read(void *buf, size_t len)
+{
+	assert(!is_writing());
+	const size_t available = this->len - pos;
+
+	if (len <= available) {
+		memcpy(buf, data + pos, len);
+		pos += len;
+		status = STATUS_OK;
+		return len;
+	}
+	else {
+		memcpy(buf, data + pos, available);
+		pos += available;
+		status = STATUS_EOF;
+		return available;
+	}
+}
+
+
+size_t memory_rdwr_stream_t::write(const void *buf, size_t len)
+{
+	assert(is_writing());
+	target->append((const char *)buf, len);
+	status = STATUS_OK;
+	return len;
+}
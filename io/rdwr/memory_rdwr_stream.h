@@ -0,0 +1,40 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef IO_RDWR_MEMORY_RDWR_STREAM_H
+#define IO_RDWR_MEMORY_RDWR_STREAM_H
+
+
+#include "rdwr_stream.h"
+
+#include <string>
+
+
+/// Reads/writes raw data from/to memory, e.g. for the savegame snapshots of network games.
+class memory_rdwr_stream_t : public rdwr_stream_t
+{
+public:
+	/// Appends all data written to @p target, which must outlive the stream.
+	explicit memory_rdwr_stream_t(std::string &target);
+
+	/// Reads @p len bytes from @p data, which must outlive the stream.
+	memory_rdwr_stream_t(const char *data, size_t len);
+
+public:
+	/// @copydoc rdwr_stream_t::read
+	size_t read(void *buf, size_t len) OVERRIDE;
+
+	/// @copydoc rdwr_stream_t::write
+	size_t write(const void *buf, size_t len) OVERRIDE;
+
+private:
+	std::string *target;
+	const char *data;
+	size_t len;
+	size_t pos;
+};
+
+
+#endif
@@ -31,7 +31,7 @@ public:
 	/// @copydoc rdwr_stream_t::write
 	size_t write(const void *buf, size_t len) OVERRIDE;
 
-private:
+protected:
 	FILE *file;
 };
 
@@ -61,6 +61,10 @@ public:
 	/// @returns Undefined (but not @p len), if an error occurred.
 	virtual size_t write(const void *buf, size_t len) = 0;
 
+	/// Writes what is still pending, like trailers; must be called once before the status is
+	/// checked for the last time, since errors of the destructor cannot be reported.
+	virtual void finish() {}
+
 protected:
 	/// @warning This must be updated to the correct value when @p read() or @p write() or the constructor fails.
 	status_t status;
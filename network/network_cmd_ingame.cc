@@ -694,6 +694,22 @@ void nwc_sync_t::rdwr()
 
 
 // save, load, pause, if server send game
+// writes a savegame kept in memory to disk; a partly written file is removed
+static bool write_game_file(const char *fn, const std::string &game)
+{
+	FILE *f = dr_fopen( fn, "wb" );
+	if(  f == NULL  ) {
+		return false;
+	}
+	const bool written = fwrite( game.data(), 1, game.size(), f ) == game.size();
+	if(  fclose( f ) != 0  ||  !written  ) {
+		dr_remove( fn );
+		return false;
+	}
+	return true;
+}
+
+
 void nwc_sync_t::do_command(karte_t *welt)
 {
 	dbg->warning("nwc_sync_t::do_command", "sync_steps %d", get_sync_step());
@@ -713,8 +729,12 @@ void nwc_sync_t::do_command(karte_t *welt)
 		}
 	}
 	// transfer game, all clients need to sync (save, reload, and pause)
-	// now save and send
+	// The reload brings everyone to the state the new client gets from the savegame,
+	// including everything rebuilt on loading. It is done from an uncompressed
+	// snapshot in memory, since writing and reading compressed files took far longer.
+	// Everyone must reload from the same bytes as the new client, or the state may differ.
 	dr_chdir( env_t::user_dir );
+	const uint32 sync_start = dr_time();
 	if(  !env_t::server  ) {
 		char fn[256];
 		sprintf( fn, "client%i-network.sve", network_get_client_id() );
@@ -722,10 +742,16 @@ void nwc_sync_t::do_command(karte_t *welt)
 		bool old_restore_UI = env_t::restore_UI;
 		env_t::restore_UI = true;
 
-		welt->save( fn, true, SERVER_SAVEGAME_VER_NR, EXTENDED_VER_NR, EXTENDED_REVISION_NR, false );
+		std::string snapshot;
+		const bool in_memory = welt->save_snapshot( snapshot, SERVER_SAVEGAME_VER_NR, EXTENDED_VER_NR, EXTENDED_REVISION_NR );
+		if(  !in_memory  ) {
+			dbg->warning("nwc_sync_t::do_command", "Could not save game to memory, saving it to %s", fn );
+			welt->save( fn, false, SERVER_SAVEGAME_VER_NR, EXTENDED_VER_NR, EXTENDED_REVISION_NR, false );
+		}
 		uint32 old_sync_steps = welt->get_sync_steps();
-		welt->load( fn );
+		welt->load( fn, in_memory ? &snapshot : NULL );
 		env_t::restore_UI = old_restore_UI;
+		dbg->message("nwc_sync_t::do_command", "saved and reloaded the game in %u ms", dr_time() - sync_start );
 
 		// pause clients, restore steps
 		welt->network_game_set_pause( true, old_sync_steps);
@@ -768,11 +794,32 @@ void nwc_sync_t::do_command(karte_t *welt)
 		sprintf( fn, "server%d-network.sve", env_t::server );
 		bool old_restore_UI = env_t::restore_UI;
 		env_t::restore_UI = true;
-		welt->save( fn, false, SERVER_SAVEGAME_VER_NR, EXTENDED_VER_NR, EXTENDED_REVISION_NR, false );
+		std::string snapshot, game;
+		const bool in_memory = welt->save_snapshot( snapshot, SERVER_SAVEGAME_VER_NR, EXTENDED_VER_NR, EXTENDED_REVISION_NR );
+		const char *err;
+		if(  !in_memory  ) {
+			// send it the old way instead, and reload from that file below
+			dbg->warning("nwc_sync_t::do_command", "Could not save game to memory, saving it to %s", fn );
+			welt->save( fn, false, SERVER_SAVEGAME_VER_NR, EXTENDED_VER_NR, EXTENDED_REVISION_NR, false );
+			// this sends nwc_game_t
+			err = network_send_file( client_id, fn );
+		}
+		else if(  !loadsave_t::zip_memory( snapshot, game )  ) {
+			// send the snapshot uncompressed, so the client loads the same bytes as we do
+			dbg->warning("nwc_sync_t::do_command", "Could not compress game, sending it uncompressed" );
+			// this sends nwc_game_t
+			err = write_game_file( fn, snapshot ) ? network_send_file( client_id, fn ) : "Could not write game";
+		}
+		else {
+			// still keep the game on disk, to recover it after a restart of the server
+			if(  !write_game_file( fn, game )  ) {
+				dbg->warning("nwc_sync_t::do_command", "Could not write %s", fn );
+			}
 
-		// ok, now sending game
-		// this sends nwc_game_t
-		const char *err = network_send_file( client_id, fn );
+			// ok, now sending game
+			// this sends nwc_game_t
+			err = network_send_game( client_id, game );
+		}
 		if (err) {
 			dbg->warning("nwc_sync_t::do_command","send game failed with: %s", err);
 		}
@@ -786,8 +833,9 @@ void nwc_sync_t::do_command(karte_t *welt)
 		}
 
 		uint32 old_sync_steps = welt->get_sync_steps();
-		welt->load( fn );
+		welt->load( fn, in_memory ? &snapshot : NULL );
 		env_t::restore_UI = old_restore_UI;
+		dbg->message("nwc_sync_t::do_command", "saved, sent and reloaded the game in %u ms", dr_time() - sync_start );
 
 		// restore steps
 		welt->network_game_set_pause( false, old_sync_steps);
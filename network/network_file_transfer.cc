@@ -324,6 +324,35 @@ error:
 	return "Client closed connection during transfer";
 }
 
+const char *network_send_game( uint32 client_id, const std::string &game )
+{
+	const sint32 length = (sint32)game.size();
+
+	// send size of file
+	nwc_game_t nwc(length);
+	SOCKET s = socket_list_t::get_socket(client_id);
+	if (s==INVALID_SOCKET  ||  !nwc.send(s)) {
+		return "Client closed connection during transfer";
+	}
+
+	// good place to show a progress bar
+	loadingscreen_t ls( translator::translate("Transferring game ..."), length, true, true );
+	sint32 bytes_sent = 0;
+	while(  bytes_sent < length  ) {
+		const int bytes = min( length - bytes_sent, 1024 );
+		uint16 dummy;
+		if( !network_send_data(s, game.data() + bytes_sent, bytes, dummy, 250) ) {
+			socket_list_t::remove_client(s);
+			return "Client closed connection during transfer";
+		}
+		bytes_sent += bytes;
+		ls.set_progress( bytes_sent );
+	}
+
+	// ok, new client has savegame
+	return NULL;
+}
+
 /// POST a message (poststr) to an HTTP server at the specified address and relative path (name)
 /// Optionally: Receive response to file localname
 const char *network_http_post( const char *address, const char *name, const char *poststr, const char *localname )
@@ -14,6 +14,8 @@
 
 #include "network.h"
 
+#include <string>
+
 class cbuffer_t;
 class karte_t;
 class gameinfo_t;
@@ -27,6 +29,9 @@ const char* network_connect(const char *cp, karte_t *world);
 // sending file over network
 const char *network_send_file( uint32 client_id, const char *filename );
 
+// sending savegame from memory
+const char *network_send_game( uint32 client_id, const std::string &game );
+
 // receive file (directly to disk)
 char const* network_receive_file(SOCKET const s, char const* const save_as, const sint32 length, const sint32 timeout=10000 );
 
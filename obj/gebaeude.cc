@@ -79,6 +79,8 @@ void gebaeude_t::init()
 	mail_delivery_success_percent_last_year = 65535;
 	is_in_world_list = 0;
 	loaded_passenger_and_mail_figres = false;
+	nearby_halts = NULL;
+	nearby_halts_stale = false;
 }
 
 
@@ -227,6 +229,8 @@ stadt_t* gebaeude_t::get_stadt() const
  */
 gebaeude_t::~gebaeude_t()
 {
+	delete nearby_halts;
+
 	if (welt->is_destroying())
 	{
 		return;
@@ -1855,6 +1859,45 @@ void gebaeude_t::set_building_tiles()
 			}
 		}
 	}
+
+	delete nearby_halts;
+	nearby_halts = NULL;
+	update_nearby_halts();
+}
+
+
+void gebaeude_t::update_nearby_halts()
+{
+	if (building_tiles.get_count() <= 1)
+	{
+		// The list of the only tile is as good.
+		return;
+	}
+
+	if (nearby_halts && !nearby_halts_stale)
+	{
+		return;
+	}
+
+	if (nearby_halts)
+	{
+		nearby_halts->clear();
+	}
+	else
+	{
+		nearby_halts = new vector_tpl<nearby_halt_t>();
+	}
+
+	// The same order as karte_t::get_nearby_halts_of_tiles() visits them
+	FOR(minivec_tpl<const planquadrat_t*>, const& plan, building_tiles)
+	{
+		const nearby_halt_t* halt_list = plan->get_haltlist();
+		for (int h = plan->get_haltlist_count() - 1; h >= 0; h--)
+		{
+			nearby_halts->append(halt_list[h]);
+		}
+	}
+	nearby_halts_stale = false;
 }
 
 
@@ -150,6 +150,16 @@ private:
 
 	minivec_tpl<const planquadrat_t*> building_tiles;
 
+	/**
+	 * The halts near the tiles of a multi-tile building, collected from all
+	 * tiles in the order of building_tiles, so the passenger generation finds
+	 * them in one list. NULL for single tile buildings.
+	 */
+	vector_tpl<nearby_halt_t> *nearby_halts;
+
+	/// the halts near one of the tiles changed since nearby_halts were collected
+	bool nearby_halts_stale;
+
 #ifdef INLINE_OBJ_TYPE
 protected:
 	gebaeude_t(obj_t::typ type);
@@ -366,6 +376,24 @@ public:
 	const minivec_tpl<const planquadrat_t*> &get_tiles() { return building_tiles; }
 	void set_building_tiles();
 
+	/**
+	 * Collects the halts near the tiles of a multi-tile building anew if those
+	 * of any tile changed since. Must not run during the passenger generation.
+	 */
+	void update_nearby_halts();
+
+	/// Called on the first tile when the halts near any tile of the building change
+	void nearby_halts_changed() { nearby_halts_stale = true; }
+
+	/**
+	 * @return the halts near all tiles in the order of get_tiles(), or NULL if
+	 * they must be looked up on the tiles themselves.
+	 */
+	const vector_tpl<nearby_halt_t> *get_nearby_halts() const
+	{
+		return nearby_halts_stale ? NULL : nearby_halts;
+	}
+
 	const minivec_tpl<koord>* get_rectangular_neighbor_koords();
 	const minivec_tpl<koord>* get_diagonal_neighbor_koords();
 
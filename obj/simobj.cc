@@ -8,6 +8,7 @@
 #include "baum.h"
 
 #include "../boden/grund.h"
+#include "../boden/wege/weg.h"
 #include "../dataobj/loadsave.h"
 #include "../dataobj/translator.h"
 #include "../display/simgraph.h"
@@ -130,6 +131,10 @@ void obj_t::set_owner(player_t *player)
 	int i = welt->sp2num(player);
 	assert(i>=0);
 	owner_n = (uint8)i;
+	if(  get_typ()==obj_t::way  ) {
+		// the owner decides who may use the way
+		weg_t::network_changed();
+	}
 }
 
 
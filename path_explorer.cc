@@ -43,6 +43,11 @@ bool path_explorer_t::must_refresh_on_loading;
 #ifdef MULTI_THREAD
 bool thread_local path_explorer_t::allow_path_explorer_on_this_thread = false;
 #endif
+#ifdef MULTI_THREAD_PATH_EXPLORER
+uint32 path_explorer_t::worker_count = 0;
+path_explorer_t::compartment_t *path_explorer_t::parallel_compartment = NULL;
+uint16 path_explorer_t::parallel_via = 0;
+#endif
 
 void path_explorer_t::initialise(karte_t *welt)
 {
@@ -270,6 +275,15 @@ void path_explorer_t::step()
 		return;
 	}
 #endif
+	// patch the finished paths with any changed lines and lineless convoys first
+	for (uint8 ca = 0; ca < max_categories; ++ca)
+	{
+		for (uint8 cl = 0; cl < max_classes; ++cl)
+		{
+			goods_compartment[ca][cl].apply_incremental_linkages();
+		}
+	}
+
 	// at most check all goods categories once
 	const uint8 max_runs = (max_categories - 2) + goods_manager_t::passengers->get_number_of_classes() + goods_manager_t::mail->get_number_of_classes();
 	for (uint8 i = 0; i < max_runs; ++i)
@@ -436,6 +450,44 @@ void path_explorer_t::refresh_class_category(uint8 category, uint8 g_class)
 	goods_compartment[category][g_class].set_refresh();
 }
 
+#ifdef MULTI_THREAD_PATH_EXPLORER
+void path_explorer_t::explore_segments_parallel(compartment_t *compartment, const uint16 via)
+{
+	parallel_compartment = compartment;
+	parallel_via = via;
+
+	// start the workers, explore the first share on this thread and wait for the workers to finish theirs
+	simthread_barrier_wait(&karte_t::path_explorer_workers_barrier);
+	compartment->explore_segments_share(via, 0, worker_count + 1);
+	simthread_barrier_wait(&karte_t::path_explorer_workers_barrier);
+
+	parallel_compartment = NULL;
+}
+#endif
+
+void path_explorer_t::refresh_linkage(const uint8 category, linehandle_t line, convoihandle_t convoy)
+{
+#ifdef MULTI_THREAD
+	world->await_path_explorer();
+#endif
+
+	if ( category == category_empty || (!line.is_bound() && !convoy.is_bound()) )
+	{
+		return;
+	}
+
+	compartment_t::linkage_t linkage;
+	linkage.line = line;
+	linkage.convoy = line.is_bound() ? convoihandle_t() : convoy;
+
+	// eligibility for each class is checked when the linkage is applied
+	const uint8 number_of_classes = goods_manager_t::get_classes_catg_index(category);
+	for (uint8 i = 0; i < number_of_classes; i++)
+	{
+		goods_compartment[category][i].add_incremental_linkage(linkage);
+	}
+}
+
 ///////////////////////////////////////////////
 
 // compartment_t
@@ -453,6 +505,8 @@ const char *const path_explorer_t::compartment_t::phase_name[] =
 
 path_explorer_t::compartment_t::connexion_list_entry_t path_explorer_t::compartment_t::connexion_list[65536];
 
+vector_tpl<path_explorer_t::compartment_t::explore_segment_t> path_explorer_t::compartment_t::explore_segments;
+
 bool path_explorer_t::compartment_t::use_limits = true;
 
 uint32 path_explorer_t::compartment_t::limit_rebuild_connexions = default_rebuild_connexions;
@@ -492,6 +546,8 @@ path_explorer_t::compartment_t::compartment_t()
 
 	linkages = NULL;
 
+	incremental_applied_count = 0;
+
 	transfer_list = NULL;
 	transfer_count = 0;
 
@@ -529,11 +585,7 @@ path_explorer_t::compartment_t::~compartment_t()
 {
 	if (finished_matrix)
 	{
-		for (uint16 i = 0; i < finished_halt_count; ++i)
-		{
-			delete[] finished_matrix[i];
-		}
-		delete[] finished_matrix;
+		delete finished_matrix;
 	}
 	if (finished_halt_index_map)
 	{
@@ -543,11 +595,7 @@ path_explorer_t::compartment_t::~compartment_t()
 
 	if (working_matrix)
 	{
-		for (uint16 i = 0; i < working_halt_count; ++i)
-		{
-			delete[] working_matrix[i];
-		}
-		delete[] working_matrix;
+		delete working_matrix;
 	}
 	if (transport_index_map)
 	{
@@ -555,11 +603,7 @@ path_explorer_t::compartment_t::~compartment_t()
 	}
 	if (transport_matrix)
 	{
-		for (uint16 i = 0; i < working_halt_count; ++i)
-		{
-			delete[] transport_matrix[i];
-		}
-		delete[] transport_matrix;
+		delete transport_matrix;
 	}
 	if (working_halt_index_map)
 	{
@@ -611,11 +655,7 @@ void path_explorer_t::compartment_t::reset(const bool reset_finished_set)
 	{
 		if (finished_matrix)
 		{
-			for (uint16 i = 0; i < finished_halt_count; ++i)
-			{
-				delete[] finished_matrix[i];
-			}
-			delete[] finished_matrix;
+			delete finished_matrix;
 			finished_matrix = NULL;
 		}
 		if (finished_halt_index_map)
@@ -629,11 +669,7 @@ void path_explorer_t::compartment_t::reset(const bool reset_finished_set)
 
 	if (working_matrix)
 	{
-		for (uint16 i = 0; i < working_halt_count; ++i)
-		{
-			delete[] working_matrix[i];
-		}
-		delete[] working_matrix;
+		delete working_matrix;
 		working_matrix = NULL;
 	}
 	if (transport_index_map)
@@ -643,11 +679,7 @@ void path_explorer_t::compartment_t::reset(const bool reset_finished_set)
 	}
 	if (transport_matrix)
 	{
-		for (uint16 i = 0; i < working_halt_count; ++i)
-		{
-			delete[] transport_matrix[i];
-		}
-		delete[] transport_matrix;
+		delete transport_matrix;
 		transport_matrix = NULL;
 	}
 	if (working_halt_index_map)
@@ -677,6 +709,9 @@ void path_explorer_t::compartment_t::reset(const bool reset_finished_set)
 		linkages = NULL;
 	}
 
+	incremental_linkages.clear();
+	incremental_applied_count = 0;
+
 
 	if (transfer_list)
 	{
@@ -772,6 +807,9 @@ void path_explorer_t::compartment_t::step()
 				refresh_completed = false;	// indicate that processing is at work
 				//refresh_start_time = dr_time();
 				refresh_start_time = world->get_ticks(); // Possibly more network safe than the original (commented out above)
+				// this refresh will include all changes made so far
+				incremental_linkages.clear();
+				incremental_applied_count = 0;
 				current_phase = phase_init_prepare;	// proceed to next phase
 				// no return statement here, as we want to fall through to the next phase
 			}
@@ -884,10 +922,10 @@ void path_explorer_t::compartment_t::step()
 			for (vector_tpl<convoihandle_t>::const_iterator i = world->convoys().begin(), end = world->convoys().end(); i != end; i++)
 			{
 				current_convoy = *i;
+				temp_linkage.convoy = current_convoy;
 				// only consider lineless convoys which support this compartment's goods catetory which are not in the depot
-				if (!current_convoy->in_depot() && !current_convoy->get_line().is_bound() && (catg >= 2 || current_convoy->carries_this_or_lower_class(catg, g_class)) && current_convoy->get_goods_catg_index().is_contained(catg) )
+				if ( is_linkage_eligible(temp_linkage) )
 				{
-					temp_linkage.convoy = current_convoy;
 					linkages->append(temp_linkage);
 					transport_index_map[ 65536u + current_convoy.get_id() ] = linkages->get_count();
 				}
@@ -909,10 +947,10 @@ void path_explorer_t::compartment_t::step()
 					 end = current_player->simlinemgmt.get_all_lines().end(); j != end; j++)
 				{
 					current_line = *j;
+					temp_linkage.line = current_line;
 					// only consider lines which support this compartment's goods category and, where applicable, class
-					if ( current_line->get_goods_catg_index().is_contained(catg) && (catg >= 2 || current_line->carries_this_or_lower_class(catg, g_class)) && current_line->count_convoys() > 0)
+					if ( is_linkage_eligible(temp_linkage) )
 					{
-						temp_linkage.line = current_line;
 						linkages->append(temp_linkage);
 						transport_index_map[ current_line.get_id() ] = linkages->get_count();
 					}
@@ -947,15 +985,7 @@ void path_explorer_t::compartment_t::step()
 
 			printf("\t\tCurrent Step : %lu \n", step_count);
 #endif
-			const goods_desc_t *const ware_type = goods_manager_t::get_info_catg_index(catg);
-
-			linkage_t current_linkage;
-			schedule_t *current_schedule;
-			player_t *current_owner;
-			uint32 current_average_speed;
-
 			uint8 entry_count;
-			halthandle_t current_halt;
 
 			minivec_tpl<halthandle_t> halt_list(64);
 			minivec_tpl<uint32> journey_time_list(64);
@@ -970,112 +1000,15 @@ void path_explorer_t::compartment_t::step()
 			// for each schedule of line / lineless convoy
 			while (phase_counter < linkages->get_count())
 			{
-				current_linkage = (*linkages)[phase_counter];
+				const linkage_t &current_linkage = (*linkages)[phase_counter];
 
-				// determine schedule, owner and average speed
-				if ( current_linkage.line.is_bound() && current_linkage.line->get_schedule() && current_linkage.line->count_convoys() )
-				{
-					// Case : a line
-					current_schedule = current_linkage.line->get_schedule();
-					current_owner = current_linkage.line->get_owner();
-					current_average_speed = (uint32) ( current_linkage.line->get_finance_history(1, LINE_AVERAGE_SPEED) > 0 ?
-													   current_linkage.line->get_finance_history(1, LINE_AVERAGE_SPEED) :
-													   ( speed_to_kmh(current_linkage.line->get_convoy(0)->get_min_top_speed()) >> 1 ) );
-				}
-				else if ( current_linkage.convoy.is_bound() && current_linkage.convoy->get_schedule() )
-				{
-					// Case : a lineless convoy
-					current_schedule = current_linkage.convoy->get_schedule();
-					current_owner = current_linkage.convoy->get_owner();
-					current_average_speed = (uint32) ( current_linkage.convoy->get_finance_history(1, convoi_t::CONVOI_AVERAGE_SPEED) > 0 ?
-													   current_linkage.convoy->get_finance_history(1, convoi_t::CONVOI_AVERAGE_SPEED) :
-													   ( speed_to_kmh(current_linkage.convoy->get_min_top_speed()) >> 1 ) );
-				}
-				else
+				if ( !prepare_linkage_halts(current_linkage, refresh_start_time, halt_list, journey_time_list, recurrence_list) )
 				{
 					// Case : nothing is bound -> just ignore
 					++phase_counter;
 					continue;
 				}
-
-				// create a list of reachable halts
-				bool reverse = false;
-				entry_count = current_schedule->is_mirrored() ? (current_schedule->get_count() * 2) - 2 : current_schedule->get_count();
-				halt_list.clear();
-				recurrence_list.clear();
-
-				uint8 index = 0;
-
-				while (entry_count-- && index < current_schedule->get_count())
-				{
-					current_halt = haltestelle_t::get_halt(current_schedule->entries[index].pos, current_owner);
-
-					// Make sure that the halt found was built before refresh started and that it supports current goods category
-					if ( current_halt.is_bound() && current_halt->get_inauguration_time() < refresh_start_time && current_halt->is_enabled(ware_type) )
-					{
-						// Assign to halt list only if current halt supports this compartment's goods category
-						halt_list.append(current_halt, 64);
-						// Initialise the corresponding recurrence list entry to false
-						recurrence_list.append(false, 64);
-					}
-
-					current_schedule->increment_index(&index, &reverse);
-				}
-
-				// precalculate journey times between consecutive halts
-				// This is now only a fallback in case the point to point journey time data are not available.
 				entry_count = halt_list.get_count();
-				uint32 journey_time = 0;
-				journey_time_list.clear();
-				journey_time_list.append(0);	// reserve the first entry for the last journey time from last halt to first halt
-
-
-				for (uint8 i = 0; i < entry_count; ++i)
-				{
-					journey_time = 0;
-					const id_pair pair(halt_list[i].get_id(), halt_list[(i+1)%entry_count].get_id());
-
-					if ( current_linkage.line.is_bound() && current_linkage.line->get_average_journey_times().is_contained(pair) )
-					{
-						if(!halt_list[i].is_bound() || ! halt_list[(i+1)%entry_count].is_bound())
-						{
-							current_linkage.line->get_average_journey_times().remove(pair);
-							continue;
-						}
-						else
-						{
-							journey_time = current_linkage.line->get_average_journey_times().access(pair)->reduce();
-						}
-					}
-					else if ( current_linkage.convoy.is_bound() && current_linkage.convoy->get_average_journey_times().is_contained(pair) )
-					{
-						if(!halt_list[i].is_bound() || ! halt_list[(i+1)%entry_count].is_bound())
-						{
-							current_linkage.convoy->get_average_journey_times().remove(pair);
-							continue;
-						}
-						else
-						{
-							journey_time = current_linkage.convoy->get_average_journey_times().access(pair)->reduce();
-						}
-					}
-
-					if(journey_time == 0)
-					{
-						// Zero here means that there are no journey time data even if the hashtable entry exists.
-						// Fallback to convoy's general average speed if a point-to-point average is not available.
-						const uint32 distance = shortest_distance(halt_list[i]->get_basis_pos(), halt_list[(i+1)%entry_count]->get_basis_pos());
-						journey_time = world->travel_time_tenths_from_distance(distance, current_average_speed);
-					}
-
-					// journey time from halt 0 to halt 1 is stored in journey_time_list[1]
-					journey_time_list.append(journey_time, 64);
-
-				}
-
-				journey_time_list[0] = journey_time_list[entry_count];	// copy the last entry to the first entry
-				journey_time_list.remove_at(entry_count);	// remove the last entry
-
 
 				// rebuild connexions for all halts in halt list
 				// for each origin halt
@@ -1113,40 +1046,7 @@ void path_explorer_t::compartment_t::step()
 						// Case : suitable halt
 						accumulated_journey_time += journey_time_list[t];
 
-						// Check the journey times to the connexion
-						id_pair halt_pair(halt_list[h].get_id(), halt_list[t].get_id());
-						new_connexion = new haltestelle_t::connexion;
-						new_connexion->waiting_time = halt_list[h]->get_average_waiting_time(halt_list[t], catg, g_class);
-						new_connexion->transfer_time = catg != goods_manager_t::passengers->get_catg_index() ? halt_list[h]->get_transshipment_time() : halt_list[h]->get_transfer_time();
-						if(current_linkage.line.is_bound())
-						{
-							average_tpl<uint32>* ave = current_linkage.line->get_average_journey_times().access(halt_pair);
-							if(ave && ave->count > 0)
-							{
-								new_connexion->journey_time = ave->reduce();
-							}
-							else
-							{
-								// Fallback - use the old method. This will be an estimate, and a somewhat generous one at that.
-								new_connexion->journey_time = accumulated_journey_time;
-							}
-						}
-						else if(current_linkage.convoy.is_bound())
-						{
-							average_tpl<uint32>* ave = current_linkage.convoy->get_average_journey_times().access(halt_pair);
-							if(ave && ave->count > 0)
-							{
-								new_connexion->journey_time = ave->reduce();
-							}
-							else
-							{
-								// Fallback - use the old method. This will be an estimate, and a somewhat generous one at that.
-								new_connexion->journey_time = accumulated_journey_time;
-							}
-						}
-						new_connexion->best_convoy = current_linkage.convoy;
-						new_connexion->best_line = current_linkage.line;
-						new_connexion->alternative_seats = 0;
+						new_connexion = create_connexion(current_linkage, halt_list[h], halt_list[t], accumulated_journey_time);
 
 						// Check whether this is the best connexion so far, and, if so, add it.
 						if( !catg_connexions->put(halt_list[t], new_connexion) )
@@ -1390,18 +1290,10 @@ void path_explorer_t::compartment_t::step()
 				if (working_halt_count > 0)
 				{
 					// build working matrix
-					working_matrix = new path_element_t*[working_halt_count];
-					for (uint16 i = 0; i < working_halt_count; ++i)
-					{
-						working_matrix[i] = new path_element_t[working_halt_count];
-					}
+					working_matrix = new path_matrix_t(working_halt_count);
 
 					// build transport matrix
-					transport_matrix = new transport_element_t*[working_halt_count];
-					for (uint16 i = 0; i < working_halt_count; ++i)
-					{
-						transport_matrix[i] = new transport_element_t[working_halt_count];
-					}
+					transport_matrix = new square_matrix_t<transport_element_t>(working_halt_count, transport_element_t());
 
 					// build transfer list
 					transfer_list = new uint16[working_halt_count];
@@ -1479,18 +1371,18 @@ void path_explorer_t::compartment_t::step()
 					}
 
 					// update corresponding matrix element
-					working_matrix[phase_counter][reachable_halt_index].next_transfer = reachable_halt;
-					working_matrix[phase_counter][reachable_halt_index].aggregate_time = current_connexion->waiting_time + current_connexion->journey_time + current_connexion->transfer_time;
-					transport_matrix[phase_counter][reachable_halt_index].first_transport
-						= transport_matrix[phase_counter][reachable_halt_index].last_transport
+					working_matrix->next_transfer[phase_counter][reachable_halt_index] = reachable_halt;
+					working_matrix->aggregate_time[phase_counter][reachable_halt_index] = current_connexion->waiting_time + current_connexion->journey_time + current_connexion->transfer_time;
+					(*transport_matrix)[phase_counter][reachable_halt_index].first_transport
+						= (*transport_matrix)[phase_counter][reachable_halt_index].last_transport
 						= transport_idx;
 
 					// Debug journey times
-					// printf("\n%s -> %s : %lu \n",current_halt->get_name(), reachable_halt->get_name(), working_matrix[phase_counter][reachable_halt_index].journey_time);
+					// printf("\n%s -> %s : %lu \n",current_halt->get_name(), reachable_halt->get_name(), working_matrix->aggregate_time[phase_counter][reachable_halt_index]);
 				}
 
 				// Special case
-				working_matrix[phase_counter][phase_counter].aggregate_time = 0;
+				working_matrix->aggregate_time[phase_counter][phase_counter] = 0;
 
 				++phase_counter;
 
@@ -1565,6 +1457,10 @@ void path_explorer_t::compartment_t::step()
 
 #ifdef DEBUG_COMPARTMENT_STEP
 				printf("\tTransfer Count :  %lu \n", transfer_count);
+				if (working_matrix)
+				{
+					printf("\tMatrix Memory :  %lu bytes \n", (unsigned long)(working_matrix->get_memory_size() + transport_matrix->get_memory_size()));
+				}
 #endif
 			}
 
@@ -1586,9 +1482,8 @@ void path_explorer_t::compartment_t::step()
 			printf("\t\tCurrent Step : %lu \n", step_count);
 #endif
 			// temporary variables
-			uint32 combined_time;
-			uint32 target_member_index;
 			uint64 iterations_processed = 0;
+			bool limit_reached = false;
 
 			// initialize only when not resuming
 			if ( via_index == 0 && origin_cluster_index == 0 && target_cluster_index == 0 && origin_member_index == 0 )
@@ -1613,10 +1508,10 @@ void path_explorer_t::compartment_t::step()
 					// identify halts which are connected with the current transfer halt
 					for ( uint16 idx = 0; idx < working_halt_count; ++idx )
 					{
-						if ( working_matrix[via][idx].aggregate_time != UINT32_MAX_VALUE && via != idx )
+						if ( working_matrix->aggregate_time[via][idx] != UINT32_MAX_VALUE && via != idx )
 						{
-							inbound_connections->register_connection( transport_matrix[idx][via].last_transport, idx );
-							outbound_connections->register_connection( transport_matrix[via][idx].first_transport, idx );
+							inbound_connections->register_connection( (*transport_matrix)[idx][via].last_transport, idx );
+							outbound_connections->register_connection( (*transport_matrix)[via][idx].first_transport, idx );
 						}
 					}
 
@@ -1625,57 +1520,68 @@ void path_explorer_t::compartment_t::step()
 					total_iterations += (uint32)working_halt_count + ( inbound_connections->get_total_member_count() << 1 );
 				}
 
+				// Determine the origin cluster members which are explored through this transfer in this step,
+				// stopping exactly where the iteration limit stops the exploration.
+				explore_segments.clear();
+				uint64 relaxations = 0;
+
 				// for each origin cluster
 				while ( origin_cluster_index < inbound_connections->get_cluster_count() )
 				{
-					const connection_t::connection_cluster_t &origin_cluster = (*inbound_connections)[origin_cluster_index];
-					const uint16 inbound_transport = origin_cluster.transport;
-					const vector_tpl<uint16> &origin_halt_list = origin_cluster.connected_halts;
+					const uint16 inbound_transport = (*inbound_connections)[origin_cluster_index].transport;
+					const uint32 origin_member_count = (*inbound_connections)[origin_cluster_index].connected_halts.get_count();
 
 					// for each target cluster
 					while ( target_cluster_index < outbound_connections->get_cluster_count() )
 					{
 						const connection_t::connection_cluster_t &target_cluster = (*outbound_connections)[target_cluster_index];
-						const uint16 outbound_transport = target_cluster.transport;
-						if ( inbound_transport == outbound_transport && inbound_transport != 0u )
+						if ( inbound_transport == target_cluster.transport && inbound_transport != 0u )
 						{
 							++target_cluster_index;
 							continue;
 						}
-						const vector_tpl<uint16> &target_halt_list = target_cluster.connected_halts;
-
-						// for each origin cluster member
-						while ( origin_member_index < origin_halt_list.get_count() )
+						const uint32 target_member_count = target_cluster.connected_halts.get_count();
+						if ( target_member_count == 0u )
 						{
-							const uint16 origin = origin_halt_list[origin_member_index];
+							// nothing to explore towards it, and the limit below divides by its size
+							origin_member_index = 0;
+							++target_cluster_index;
+							continue;
+						}
 
-							// for each target cluster member
-							for ( target_member_index = 0; target_member_index < target_halt_list.get_count(); ++target_member_index )
+						if ( origin_member_index < origin_member_count )
+						{
+							// the iteration limit is checked after each origin cluster member
+							uint32 member_count = origin_member_count - origin_member_index;
+							if ( use_limits )
 							{
-								const uint16 target = target_halt_list[target_member_index];
-
-								if ( ( combined_time = working_matrix[origin][via].aggregate_time
-													 + working_matrix[via][target].aggregate_time )
-											< working_matrix[origin][target].aggregate_time			   )
+								const uint64 members_to_limit = iterations_processed >= limit_explore_paths ? 1 :
+									( limit_explore_paths - iterations_processed + target_member_count - 1 ) / target_member_count;
+								if ( members_to_limit <= member_count )
 								{
-									working_matrix[origin][target].aggregate_time = combined_time;
-									working_matrix[origin][target].next_transfer = working_matrix[origin][via].next_transfer;
-									transport_matrix[origin][target].first_transport = transport_matrix[origin][via].first_transport;
-									transport_matrix[origin][target].last_transport = transport_matrix[via][target].last_transport;
+									member_count = (uint32)members_to_limit;
+									limit_reached = true;
 								}
-							}	// loop : target cluster member
+							}
 
-							++origin_member_index;
+							explore_segment_t segment;
+							segment.origin_cluster = origin_cluster_index;
+							segment.target_cluster = target_cluster_index;
+							segment.first_member = origin_member_index;
+							segment.last_member = origin_member_index + member_count;
+							explore_segments.append(segment);
+
+							origin_member_index += member_count;
 
 							// iteration control
-							iterations_processed += target_halt_list.get_count();
-							total_iterations += target_halt_list.get_count();
-							if ( use_limits && iterations_processed >= limit_explore_paths )
+							iterations_processed += (uint64)member_count * target_member_count;
+							total_iterations += member_count * target_member_count;
+							relaxations += (uint64)member_count * target_member_count;
+							if ( limit_reached )
 							{
-								goto loop_termination;
+								break;
 							}
-
-						}	// loop : origin cluster member
+						}
 
 						origin_member_index = 0;
 
@@ -1683,12 +1589,35 @@ void path_explorer_t::compartment_t::step()
 
 					}	// loop : target cluster
 
+					if ( limit_reached )
+					{
+						break;
+					}
+
 					target_cluster_index = 0;
 
 					++origin_cluster_index;
 
 				}	// loop : origin cluster
 
+				// Every origin only updates its own row, and neither the row nor the column of the transfer
+				// changes while exploring through it, so the members can be explored in any order.
+#ifdef MULTI_THREAD_PATH_EXPLORER
+				if ( worker_count > 0 && relaxations >= parallel_relaxation_threshold )
+				{
+					explore_segments_parallel(this, via);
+				}
+				else
+#endif
+				{
+					explore_segments_share(via, 0, 1);
+				}
+
+				if ( limit_reached )
+				{
+					goto loop_termination;
+				}
+
 				origin_cluster_index = 0;
 
 				// clear the inbound/outbound connections
@@ -1751,11 +1680,7 @@ void path_explorer_t::compartment_t::step()
 				// path search completed -> delete old path info
 				if (finished_matrix)
 				{
-					for (uint16 i = 0; i < finished_halt_count; ++i)
-					{
-						delete[] finished_matrix[i];
-					}
-					delete[] finished_matrix;
+					delete finished_matrix;
 					finished_matrix = NULL;
 				}
 				if (finished_halt_index_map)
@@ -1775,11 +1700,7 @@ void path_explorer_t::compartment_t::step()
 				// path search completed -> delete auxilliary data structures
 				if (transport_matrix)
 				{
-					for (uint16 i = 0; i < working_halt_count; ++i)
-					{
-						delete[] transport_matrix[i];
-					}
-					delete[] transport_matrix;
+					delete transport_matrix;
 					transport_matrix = NULL;
 				}
 				working_halt_count = 0;
@@ -1814,6 +1735,10 @@ void path_explorer_t::compartment_t::step()
 				origin_member_index = 0;
 
 				paths_available = true;
+
+				// changes made while this refresh was running are not included in its results
+				incremental_applied_count = 0;
+				apply_incremental_linkages();
 			}
 
 			iterations = 0;	// reset iteration counter // desync debug
@@ -1943,7 +1868,54 @@ void path_explorer_t::compartment_t::step()
 }
 
 
-void path_explorer_t::compartment_t::enumerate_all_paths(const path_element_t *const *const matrix, const halthandle_t *const halt_list,
+void path_explorer_t::compartment_t::explore_segments_share(const uint16 via, const uint32 share, const uint32 share_count)
+{
+	uint32 combined_time;
+
+	// the row of the transfer does not change while exploring through it
+	const uint32 *const via_times = working_matrix->aggregate_time[via];
+	const transport_element_t *const via_transports = (*transport_matrix)[via];
+
+	FOR(vector_tpl<explore_segment_t>, const& segment, explore_segments)
+	{
+		const vector_tpl<uint16> &origin_halt_list = (*inbound_connections)[segment.origin_cluster].connected_halts;
+		const vector_tpl<uint16> &target_halt_list = (*outbound_connections)[segment.target_cluster].connected_halts;
+		const uint32 target_count = target_halt_list.get_count();
+
+		// for each origin cluster member
+		for ( uint32 origin_member = segment.first_member; origin_member < segment.last_member; ++origin_member )
+		{
+			// each origin row belongs to one share, so no two threads ever write the same row
+			const uint16 origin = origin_halt_list[origin_member];
+			if ( origin % share_count != share )
+			{
+				continue;
+			}
+
+			uint32 *const origin_times = working_matrix->aggregate_time[origin];
+			halthandle_t *const origin_transfers = working_matrix->next_transfer[origin];
+			transport_element_t *const origin_transports = (*transport_matrix)[origin];
+			const uint32 origin_via_time = origin_times[via];
+
+			// for each target cluster member
+			for ( uint32 target_member_index = 0; target_member_index < target_count; ++target_member_index )
+			{
+				const uint16 target = target_halt_list[target_member_index];
+
+				if ( ( combined_time = origin_via_time + via_times[target] ) < origin_times[target] )
+				{
+					origin_times[target] = combined_time;
+					origin_transfers[target] = origin_transfers[via];
+					origin_transports[target].first_transport = origin_transports[via].first_transport;
+					origin_transports[target].last_transport = via_transports[target].last_transport;
+				}
+			}	// loop : target cluster member
+		}	// loop : origin cluster member
+	}
+}
+
+
+void path_explorer_t::compartment_t::enumerate_all_paths(const path_matrix_t *const matrix, const halthandle_t *const halt_list,
 														 const uint16 *const halt_map, const uint16 halt_count)
 {
 	// Debugging code : Enumerate all paths for validation
@@ -1958,9 +1930,9 @@ void path_explorer_t::compartment_t::enumerate_all_paths(const path_element_t *c
 				// print origin
 				printf("\n\nOrigin :  %s\n", halt_list[x]->get_name());
 
-				transfer_halt = matrix[x][y].next_transfer;
+				transfer_halt = matrix->next_transfer[x][y];
 
-				if (matrix[x][y].aggregate_time == UINT32_MAX_VALUE)
+				if (matrix->aggregate_time[x][y] == UINT32_MAX_VALUE)
 				{
 					printf("\t\t\t\t******** No Route ********\n");
 				}
@@ -1972,7 +1944,7 @@ void path_explorer_t::compartment_t::enumerate_all_paths(const path_element_t *c
 
 						if ( halt_map[transfer_halt.get_id()] != 65535)
 						{
-							transfer_halt = matrix[ halt_map[transfer_halt.get_id()] ][y].next_transfer;
+							transfer_halt = matrix->next_transfer[ halt_map[transfer_halt.get_id()] ][y];
 						}
 						else
 						{
@@ -1990,6 +1962,401 @@ void path_explorer_t::compartment_t::enumerate_all_paths(const path_element_t *c
 }
 
 
+bool path_explorer_t::compartment_t::is_linkage_eligible(const linkage_t &linkage) const
+{
+	if ( linkage.line.is_bound() )
+	{
+		// only consider lines which support this compartment's goods category and, where applicable, class
+		return linkage.line->get_goods_catg_index().is_contained(catg) && (catg >= 2 || linkage.line->carries_this_or_lower_class(catg, g_class)) && linkage.line->count_convoys() > 0;
+	}
+	if ( linkage.convoy.is_bound() )
+	{
+		// only consider lineless convoys which support this compartment's goods catetory which are not in the depot
+		return !linkage.convoy->in_depot() && !linkage.convoy->get_line().is_bound() && (catg >= 2 || linkage.convoy->carries_this_or_lower_class(catg, g_class)) && linkage.convoy->get_goods_catg_index().is_contained(catg);
+	}
+	return false;
+}
+
+
+bool path_explorer_t::compartment_t::prepare_linkage_halts(const linkage_t &linkage, const sint64 inauguration_limit, minivec_tpl<halthandle_t> &halt_list,
+														   minivec_tpl<uint32> &journey_time_list, minivec_tpl<bool> &recurrence_list) const
+{
+	const goods_desc_t *const ware_type = goods_manager_t::get_info_catg_index(catg);
+
+	schedule_t *current_schedule;
+	player_t *current_owner;
+	uint32 current_average_speed;
+
+	// determine schedule, owner and average speed
+	if ( linkage.line.is_bound() && linkage.line->get_schedule() && linkage.line->count_convoys() )
+	{
+		// Case : a line
+		current_schedule = linkage.line->get_schedule();
+		current_owner = linkage.line->get_owner();
+		current_average_speed = (uint32) ( linkage.line->get_finance_history(1, LINE_AVERAGE_SPEED) > 0 ?
+										   linkage.line->get_finance_history(1, LINE_AVERAGE_SPEED) :
+										   ( speed_to_kmh(linkage.line->get_convoy(0)->get_min_top_speed()) >> 1 ) );
+	}
+	else if ( linkage.convoy.is_bound() && linkage.convoy->get_schedule() )
+	{
+		// Case : a lineless convoy
+		current_schedule = linkage.convoy->get_schedule();
+		current_owner = linkage.convoy->get_owner();
+		current_average_speed = (uint32) ( linkage.convoy->get_finance_history(1, convoi_t::CONVOI_AVERAGE_SPEED) > 0 ?
+										   linkage.convoy->get_finance_history(1, convoi_t::CONVOI_AVERAGE_SPEED) :
+										   ( speed_to_kmh(linkage.convoy->get_min_top_speed()) >> 1 ) );
+	}
+	else
+	{
+		return false;
+	}
+
+	// create a list of reachable halts
+	bool reverse = false;
+	uint8 entry_count = current_schedule->is_mirrored() ? (current_schedule->get_count() * 2) - 2 : current_schedule->get_count();
+	halt_list.clear();
+	recurrence_list.clear();
+
+	uint8 index = 0;
+
+	while (entry_count-- && index < current_schedule->get_count())
+	{
+		const halthandle_t current_halt = haltestelle_t::get_halt(current_schedule->entries[index].pos, current_owner);
+
+		// Make sure that the halt found was built before refresh started and that it supports current goods category
+		if ( current_halt.is_bound() && current_halt->get_inauguration_time() < inauguration_limit && current_halt->is_enabled(ware_type) )
+		{
+			// Assign to halt list only if current halt supports this compartment's goods category
+			halt_list.append(current_halt, 64);
+			// Initialise the corresponding recurrence list entry to false
+			recurrence_list.append(false, 64);
+		}
+
+		current_schedule->increment_index(&index, &reverse);
+	}
+
+	// precalculate journey times between consecutive halts
+	// This is now only a fallback in case the point to point journey time data are not available.
+	entry_count = halt_list.get_count();
+	uint32 journey_time = 0;
+	journey_time_list.clear();
+	journey_time_list.append(0);	// reserve the first entry for the last journey time from last halt to first halt
+
+
+	for (uint8 i = 0; i < entry_count; ++i)
+	{
+		journey_time = 0;
+		const id_pair pair(halt_list[i].get_id(), halt_list[(i+1)%entry_count].get_id());
+
+		if ( linkage.line.is_bound() && linkage.line->get_average_journey_times().is_contained(pair) )
+		{
+			if(!halt_list[i].is_bound() || ! halt_list[(i+1)%entry_count].is_bound())
+			{
+				linkage.line->get_average_journey_times().remove(pair);
+				continue;
+			}
+			else
+			{
+				journey_time = linkage.line->get_average_journey_times().access(pair)->reduce();
+			}
+		}
+		else if ( linkage.convoy.is_bound() && linkage.convoy->get_average_journey_times().is_contained(pair) )
+		{
+			if(!halt_list[i].is_bound() || ! halt_list[(i+1)%entry_count].is_bound())
+			{
+				linkage.convoy->get_average_journey_times().remove(pair);
+				continue;
+			}
+			else
+			{
+				journey_time = linkage.convoy->get_average_journey_times().access(pair)->reduce();
+			}
+		}
+
+		if(journey_time == 0)
+		{
+			// Zero here means that there are no journey time data even if the hashtable entry exists.
+			// Fallback to convoy's general average speed if a point-to-point average is not available.
+			const uint32 distance = shortest_distance(halt_list[i]->get_basis_pos(), halt_list[(i+1)%entry_count]->get_basis_pos());
+			journey_time = world->travel_time_tenths_from_distance(distance, current_average_speed);
+		}
+
+		// journey time from halt 0 to halt 1 is stored in journey_time_list[1]
+		journey_time_list.append(journey_time, 64);
+
+	}
+
+	journey_time_list[0] = journey_time_list[entry_count];	// copy the last entry to the first entry
+	journey_time_list.remove_at(entry_count);	// remove the last entry
+
+	return true;
+}
+
+
+haltestelle_t::connexion *path_explorer_t::compartment_t::create_connexion(const linkage_t &linkage, const halthandle_t origin_halt, const halthandle_t target_halt,
+																		   const uint32 accumulated_journey_time) const
+{
+	// Check the journey times to the connexion
+	id_pair halt_pair(origin_halt.get_id(), target_halt.get_id());
+	haltestelle_t::connexion *new_connexion = new haltestelle_t::connexion;
+	new_connexion->waiting_time = origin_halt->get_average_waiting_time(target_halt, catg, g_class);
+	new_connexion->transfer_time = catg != goods_manager_t::passengers->get_catg_index() ? origin_halt->get_transshipment_time() : origin_halt->get_transfer_time();
+	if(linkage.line.is_bound())
+	{
+		average_tpl<uint32>* ave = linkage.line->get_average_journey_times().access(halt_pair);
+		if(ave && ave->count > 0)
+		{
+			new_connexion->journey_time = ave->reduce();
+		}
+		else
+		{
+			// Fallback - use the old method. This will be an estimate, and a somewhat generous one at that.
+			new_connexion->journey_time = accumulated_journey_time;
+		}
+	}
+	else if(linkage.convoy.is_bound())
+	{
+		average_tpl<uint32>* ave = linkage.convoy->get_average_journey_times().access(halt_pair);
+		if(ave && ave->count > 0)
+		{
+			new_connexion->journey_time = ave->reduce();
+		}
+		else
+		{
+			// Fallback - use the old method. This will be an estimate, and a somewhat generous one at that.
+			new_connexion->journey_time = accumulated_journey_time;
+		}
+	}
+	new_connexion->best_convoy = linkage.convoy;
+	new_connexion->best_line = linkage.line;
+	new_connexion->alternative_seats = 0;
+	return new_connexion;
+}
+
+
+void path_explorer_t::compartment_t::add_incremental_linkage(const linkage_t &linkage)
+{
+	// Only the linkages added since the current refresh has started need to be remembered:
+	// the refresh itself will pick up the changes of earlier ones.
+	for ( uint32 i = 0; i < incremental_linkages.get_count(); ++i )
+	{
+		if ( incremental_linkages[i].line == linkage.line && incremental_linkages[i].convoy == linkage.convoy )
+		{
+			// Already queued; if it has been applied, apply it again as its data may have changed.
+			incremental_applied_count = min(incremental_applied_count, i);
+			return;
+		}
+	}
+	incremental_linkages.append(linkage);
+}
+
+
+void path_explorer_t::compartment_t::apply_incremental_linkages()
+{
+	while ( incremental_applied_count < incremental_linkages.get_count() )
+	{
+		apply_incremental_linkage(incremental_linkages[incremental_applied_count]);
+		++incremental_applied_count;
+	}
+}
+
+
+void path_explorer_t::compartment_t::apply_incremental_linkage(const linkage_t &linkage)
+{
+	// This only ever shortens paths: connexions which a schedule change has removed
+	// remain in the finished matrix until the full refresh which was requested
+	// alongside this update has completed.
+	if ( !paths_available || !finished_matrix || !finished_halt_index_map || !is_linkage_eligible(linkage) )
+	{
+		return;
+	}
+
+	minivec_tpl<halthandle_t> halt_list(64);
+	minivec_tpl<uint32> journey_time_list(64);
+	minivec_tpl<bool> recurrence_list(64);
+
+	if ( !prepare_linkage_halts(linkage, world->get_ticks() + 1, halt_list, journey_time_list, recurrence_list) )
+	{
+		return;
+	}
+	const uint8 entry_count = halt_list.get_count();
+
+	// Collect the distinct stops of this linkage which are present in the finished matrix.
+	// Stops which are not in the matrix cannot be added without resizing it, so they
+	// have to wait for the full refresh.
+	vector_tpl<uint16> stops(entry_count);
+	for ( uint8 i = 0; i < entry_count; ++i )
+	{
+		const uint16 index = finished_halt_index_map[ halt_list[i].get_id() ];
+		if ( index != 65535 )
+		{
+			stops.append_unique(index);
+		}
+	}
+	const uint32 stop_count = stops.get_count();
+	if ( stop_count < 2 )
+	{
+		return;
+	}
+
+	// Build the sub-matrix of best paths between the stops, seeded from the finished matrix
+	vector_tpl<path_element_t> sub_matrix(stop_count * stop_count);
+	for ( uint32 s = 0; s < stop_count; ++s )
+	{
+		for ( uint32 t = 0; t < stop_count; ++t )
+		{
+			path_element_t element;
+			element.aggregate_time = finished_matrix->aggregate_time[ stops[s] ][ stops[t] ];
+			element.next_transfer = finished_matrix->next_transfer[ stops[s] ][ stops[t] ];
+			sub_matrix.append(element);
+		}
+	}
+
+	// Add this linkage's connexions, exactly as phase_rebuild_connexions would create them
+	bool improved = false;
+	for ( uint8 h = 0; h < entry_count; ++h )
+	{
+		const uint16 origin_index = finished_halt_index_map[ halt_list[h].get_id() ];
+		if ( recurrence_list[h] || origin_index == 65535 )
+		{
+			continue;
+		}
+		const uint32 s = stops.index_of(origin_index);
+
+		uint32 accumulated_journey_time = 0;
+		for (uint8 i = 1,		t = (h + 1) % entry_count;
+			 i < entry_count;
+			 ++i,				t = (t + 1) % entry_count)
+		{
+			if ( halt_list[t] == halt_list[h] )
+			{
+				accumulated_journey_time = 0;
+				recurrence_list[t] = true;
+				continue;
+			}
+
+			accumulated_journey_time += journey_time_list[t];
+
+			const uint16 target_index = finished_halt_index_map[ halt_list[t].get_id() ];
+			if ( target_index == 65535 )
+			{
+				continue;
+			}
+
+			const haltestelle_t::connexion *const new_connexion = create_connexion(linkage, halt_list[h], halt_list[t], accumulated_journey_time);
+			const uint32 aggregate_time = new_connexion->waiting_time + new_connexion->journey_time + new_connexion->transfer_time;
+			delete new_connexion;
+
+			path_element_t &element = sub_matrix[ s * stop_count + stops.index_of(target_index) ];
+			if ( aggregate_time < element.aggregate_time )
+			{
+				element.aggregate_time = aggregate_time;
+				element.next_transfer = halt_list[t];
+				improved = true;
+			}
+		}
+	}
+
+	if ( !improved )
+	{
+		return;
+	}
+
+	// Close the sub-matrix so that it also holds paths which use several of the new connexions
+	for ( uint32 via = 0; via < stop_count; ++via )
+	{
+		for ( uint32 s = 0; s < stop_count; ++s )
+		{
+			const path_element_t &to_via = sub_matrix[ s * stop_count + via ];
+			if ( to_via.aggregate_time == UINT32_MAX_VALUE || s == via )
+			{
+				continue;
+			}
+			for ( uint32 t = 0; t < stop_count; ++t )
+			{
+				const path_element_t &from_via = sub_matrix[ via * stop_count + t ];
+				if ( from_via.aggregate_time == UINT32_MAX_VALUE )
+				{
+					continue;
+				}
+				path_element_t &element = sub_matrix[ s * stop_count + t ];
+				if ( to_via.aggregate_time + from_via.aggregate_time < element.aggregate_time )
+				{
+					element.aggregate_time = to_via.aggregate_time + from_via.aggregate_time;
+					element.next_transfer = to_via.next_transfer;
+				}
+			}
+		}
+	}
+
+	// Every path that improves must enter the stops of this linkage at some stop and leave
+	// them at another. Hence only rows which can reach a stop faster than before are touched,
+	// and within them only the columns reachable from the stops that became faster to reach.
+	vector_tpl<path_element_t> best_to_stop(stop_count);
+	vector_tpl<bool> stop_improved(stop_count);
+	for ( uint16 origin = 0; origin < finished_halt_count; ++origin )
+	{
+		uint32 *const row_times = finished_matrix->aggregate_time[origin];
+		halthandle_t *const row_transfers = finished_matrix->next_transfer[origin];
+
+		best_to_stop.clear();
+		stop_improved.clear();
+		bool row_improved = false;
+		for ( uint32 t = 0; t < stop_count; ++t )
+		{
+			path_element_t best;
+			best.aggregate_time = row_times[ stops[t] ];
+			best.next_transfer = row_transfers[ stops[t] ];
+			for ( uint32 s = 0; s < stop_count; ++s )
+			{
+				const path_element_t &from_stop = sub_matrix[ s * stop_count + t ];
+				if ( row_times[ stops[s] ] == UINT32_MAX_VALUE || from_stop.aggregate_time == UINT32_MAX_VALUE )
+				{
+					continue;
+				}
+				const uint32 combined_time = row_times[ stops[s] ] + from_stop.aggregate_time;
+				if ( combined_time < best.aggregate_time )
+				{
+					best.aggregate_time = combined_time;
+					best.next_transfer = origin == stops[s] ? from_stop.next_transfer : row_transfers[ stops[s] ];
+				}
+			}
+			stop_improved.append(best.aggregate_time < row_times[ stops[t] ]);
+			row_improved |= stop_improved.back();
+			best_to_stop.append(best);
+		}
+
+		if ( !row_improved )
+		{
+			continue;
+		}
+
+		for ( uint32 t = 0; t < stop_count; ++t )
+		{
+			if ( !stop_improved[t] )
+			{
+				continue;
+			}
+			const path_element_t &best = best_to_stop[t];
+			const uint32 *const stop_times = finished_matrix->aggregate_time[ stops[t] ];
+			for ( uint16 target = 0; target < finished_halt_count; ++target )
+			{
+				if ( stop_times[target] == UINT32_MAX_VALUE || target == origin )
+				{
+					continue;
+				}
+				const uint32 combined_time = best.aggregate_time + stop_times[target];
+				if ( combined_time < row_times[target] )
+				{
+					row_times[target] = combined_time;
+					row_transfers[target] = best.next_transfer;
+				}
+			}
+		}
+	}
+}
+
+
 bool path_explorer_t::compartment_t::get_path_between(const halthandle_t origin_halt, const halthandle_t target_halt,
 													  uint32 &aggregate_time, halthandle_t &next_transfer)
 {
@@ -1999,10 +2366,10 @@ bool path_explorer_t::compartment_t::get_path_between(const halthandle_t origin_
 	if ( paths_available /*&& origin_halt.is_bound() && target_halt.is_bound()*/
 			&& ( origin_index = finished_halt_index_map[ origin_halt.get_id() ] ) != 65535
 			&& ( target_index = finished_halt_index_map[ target_halt.get_id() ] ) != 65535
-			&& finished_matrix[origin_index][target_index].next_transfer.is_bound() )
+			&& finished_matrix->next_transfer[origin_index][target_index].is_bound() )
 	{
-		aggregate_time = finished_matrix[origin_index][target_index].aggregate_time;
-		next_transfer = finished_matrix[origin_index][target_index].next_transfer;
+		aggregate_time = finished_matrix->aggregate_time[origin_index][target_index];
+		next_transfer = finished_matrix->next_transfer[origin_index][target_index];
 		return true;
 	}
 
@@ -2013,6 +2380,78 @@ bool path_explorer_t::compartment_t::get_path_between(const halthandle_t origin_
 }
 
 
+uint32 path_explorer_t::route_t::apply_to(ware_t &ware, const uint32 previous_journey_time) const
+{
+	if ( !has_target )
+	{
+		// no target station found
+		ware.set_ziel( halthandle_t() );
+		ware.set_zwischenziel( halthandle_t() );
+		return UINT32_MAX_VALUE;
+	}
+
+	if ( aggregate_time < previous_journey_time )
+	{
+		ware.set_ziel( target );
+		ware.set_zwischenziel( next_transfer );
+		return aggregate_time;
+	}
+	return previous_journey_time;
+}
+
+
+void path_explorer_t::compartment_t::get_paths(const halthandle_t *origin_halts, const uint32 origin_count, const vector_tpl<halthandle_t> &target_halts,
+											   const vector_tpl<uint32> &target_times, route_t *routes)
+{
+	// resolve the targets to matrix columns only once for all origins
+	static thread_local vector_tpl<uint16> target_columns;
+	target_columns.clear();
+	const uint32 target_count = target_halts.get_count();
+	for ( uint32 t = 0; t < target_count; ++t )
+	{
+		const halthandle_t target_halt = target_halts[t];
+		target_columns.append( paths_available && target_halt.is_bound() ? finished_halt_index_map[ target_halt.get_id() ] : 65535 );
+	}
+
+	for ( uint32 o = 0; o < origin_count; ++o )
+	{
+		const halthandle_t origin_halt = origin_halts[o];
+		route_t &route = routes[o];
+		route.aggregate_time = UINT32_MAX_VALUE;
+		route.target = halthandle_t();
+		route.next_transfer = halthandle_t();
+		route.has_target = false;
+
+		const uint16 origin_index = paths_available && origin_halt.is_bound() ? finished_halt_index_map[ origin_halt.get_id() ] : 65535;
+		const uint32 *const row_times = origin_index != 65535 ? finished_matrix->aggregate_time[origin_index] : NULL;
+		const halthandle_t *const row_transfers = origin_index != 65535 ? finished_matrix->next_transfer[origin_index] : NULL;
+
+		for ( uint32 t = 0; t < target_count; ++t )
+		{
+			const halthandle_t target_halt = target_halts[t];
+			if ( !target_halt.is_bound() || target_halt == origin_halt )
+			{
+				continue;
+			}
+			route.has_target = true;
+
+			const uint16 target_index = target_columns[t];
+			if ( !row_times || target_index == 65535 || row_times[target_index] == UINT32_MAX_VALUE )
+			{
+				continue;
+			}
+			const uint32 test_time = row_times[target_index] + target_times[t];
+			if ( test_time < route.aggregate_time && row_transfers[target_index].is_bound() )
+			{
+				route.aggregate_time = test_time;
+				route.target = target_halt;
+				route.next_transfer = row_transfers[target_index];
+			}
+		}
+	}
+}
+
+
 void path_explorer_t::compartment_t::set_category(uint8 category)
 {
 	catg = category;
@@ -2124,8 +2563,8 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 				//  This is a 2 dimensional array
 				for (uint32 j = 0; j < finished_halt_count; j++)
 				{
-					file->rdwr_long(finished_matrix[i][j].aggregate_time);
-					tmp_idx = finished_matrix[i][j].next_transfer.get_id();
+					file->rdwr_long(finished_matrix->aggregate_time[i][j]);
+					tmp_idx = finished_matrix->next_transfer[i][j].get_id();
 					file->rdwr_short(tmp_idx);
 				}
 			}
@@ -2137,20 +2576,16 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 			{
 				// Build the (empty) finished matrix
 				uint16 tmp_idx;
-				finished_matrix = new path_element_t*[finished_halt_count];
-				for (uint16 i = 0; i < finished_halt_count; ++i)
-				{
-					finished_matrix[i] = new path_element_t[finished_halt_count];
-				}
+				finished_matrix = new path_matrix_t(finished_halt_count);
 
 				// Now load them. These are 2 dimensional arrays.
 				for (uint16 i = 0; i < finished_halt_count; i++)
 				{
 					for (uint32 j = 0; j < finished_halt_count; j++)
 					{
-						file->rdwr_long(finished_matrix[i][j].aggregate_time);
+						file->rdwr_long(finished_matrix->aggregate_time[i][j]);
 						file->rdwr_short(tmp_idx);
-						finished_matrix[i][j].next_transfer.set_id(tmp_idx);
+						finished_matrix->next_transfer[i][j].set_id(tmp_idx);
 					}
 				}
 			}
@@ -2172,12 +2607,12 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 			{
 				for (uint32 j = 0; j < working_halt_count; j++)
 				{
-					file->rdwr_long(working_matrix[i][j].aggregate_time);
-					tmp_idx = working_matrix[i][j].next_transfer.get_id();
+					file->rdwr_long(working_matrix->aggregate_time[i][j]);
+					tmp_idx = working_matrix->next_transfer[i][j].get_id();
 					file->rdwr_short(tmp_idx);
 
-					file->rdwr_short(transport_matrix[i][j].first_transport);
-					file->rdwr_short(transport_matrix[i][j].last_transport);
+					file->rdwr_short((*transport_matrix)[i][j].first_transport);
+					file->rdwr_short((*transport_matrix)[i][j].last_transport);
 				}
 			}
 		}
@@ -2189,31 +2624,22 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 			{
 				// build working matrix
 				uint16 tmp_idx;
-				working_matrix = new path_element_t*[working_halt_count];
-				for (uint16 i = 0; i < working_halt_count; ++i)
-				{
-					working_matrix[i] = new path_element_t[working_halt_count];
-
-				}
+				working_matrix = new path_matrix_t(working_halt_count);
 
 				// build transport matrix
-				transport_matrix = new transport_element_t*[working_halt_count];
-				for (uint16 i = 0; i < working_halt_count; ++i)
-				{
-					transport_matrix[i] = new transport_element_t[working_halt_count];
-				}
+				transport_matrix = new square_matrix_t<transport_element_t>(working_halt_count, transport_element_t());
 
 				// Now load them. These are 2 dimensional arrays.
 				for (uint16 i = 0; i < working_halt_count; i++)
 				{
 					for (uint32 j = 0; j < working_halt_count; j++)
 					{
-						file->rdwr_long(working_matrix[i][j].aggregate_time);
+						file->rdwr_long(working_matrix->aggregate_time[i][j]);
 						file->rdwr_short(tmp_idx);
-						working_matrix[i][j].next_transfer.set_id(tmp_idx);
+						working_matrix->next_transfer[i][j].set_id(tmp_idx);
 
-						file->rdwr_short(transport_matrix[i][j].first_transport);
-						file->rdwr_short(transport_matrix[i][j].last_transport);
+						file->rdwr_short((*transport_matrix)[i][j].first_transport);
+						file->rdwr_short((*transport_matrix)[i][j].last_transport);
 					}
 				}
 			}
@@ -2416,6 +2842,35 @@ void path_explorer_t::compartment_t::rdwr(loadsave_t* file)
 
 	file->rdwr_long(statistic_duration);
 	file->rdwr_long(statistic_iteration);
+
+	if (file->is_version_ex_atleast(14, 64))
+	{
+		uint32 incremental_linkages_count = incremental_linkages.get_count();
+		file->rdwr_long(incremental_linkages_count);
+
+		uint16 cnv_id;
+		uint16 line_id;
+		for (uint32 i = 0; i < incremental_linkages_count; i++)
+		{
+			if (file->is_saving())
+			{
+				cnv_id = incremental_linkages[i].convoy.get_id();
+				line_id = incremental_linkages[i].line.get_id();
+			}
+
+			file->rdwr_short(cnv_id);
+			file->rdwr_short(line_id);
+
+			if (file->is_loading())
+			{
+				linkage_t tmp;
+				tmp.convoy.set_id(cnv_id);
+				tmp.line.set_id(line_id);
+				incremental_linkages.append(tmp);
+			}
+		}
+		file->rdwr_long(incremental_applied_count);
+	}
 }
 
 void path_explorer_t::compartment_t::connection_t::rdwr(loadsave_t* file)
@@ -109,6 +109,18 @@ public:
 
 	static void rdwr(loadsave_t* file);
 
+	// quickest path from one origin halt, as found by get_catg_paths()
+	struct route_t
+	{
+		uint32 aggregate_time;      // including the time added for the target; UINT32_MAX_VALUE if there is no path
+		halthandle_t target;
+		halthandle_t next_transfer;
+		bool has_target;            // whether there was any bound target other than the origin itself
+
+		// reroutes the ware along this route if it beats previous_journey_time; returns the journey time like haltestelle_t::find_route()
+		uint32 apply_to(ware_t &ware, const uint32 previous_journey_time) const;
+	};
+
 private:
 
 	class compartment_t
@@ -125,7 +137,7 @@ private:
 
 	private:
 
-		// element used during path search and for storing calculated paths
+		// element used for handling the path between a single pair of halts
 		struct path_element_t
 		{
 			uint32 aggregate_time;
@@ -136,6 +148,52 @@ private:
 			{}
 		};
 
+		// square matrix stored row by row in a single contiguous block
+		template<class T> class square_matrix_t
+		{
+			T *data;
+			uint16 size;
+
+		public:
+			square_matrix_t(const uint16 matrix_size, const T &initial_value) :
+				data(new T[(uint32)matrix_size * matrix_size]),
+				size(matrix_size)
+			{
+				const uint32 cell_count = (uint32)matrix_size * matrix_size;
+				for ( uint32 i = 0; i < cell_count; ++i )
+				{
+					data[i] = initial_value;
+				}
+			}
+
+			~square_matrix_t() { delete[] data; }
+
+			uint16 get_size() const { return size; }
+			size_t get_memory_size() const { return (size_t)size * size * sizeof(T); }
+
+			T *operator[](const uint16 row) { return data + (uint32)row * size; }
+			const T *operator[](const uint16 row) const { return data + (uint32)row * size; }
+
+		private:
+			square_matrix_t(const square_matrix_t &);
+			square_matrix_t &operator=(const square_matrix_t &);
+		};
+
+		// calculated paths; aggregate times and next transfers are stored as separate matrices,
+		// so that path searching streams only the times and a cell takes 6 bytes instead of a padded 8
+		struct path_matrix_t
+		{
+			square_matrix_t<uint32> aggregate_time;
+			square_matrix_t<halthandle_t> next_transfer;
+
+			explicit path_matrix_t(const uint16 size) :
+				aggregate_time(size, UINT32_MAX_VALUE),
+				next_transfer(size, halthandle_t())
+			{}
+
+			size_t get_memory_size() const { return aggregate_time.get_memory_size() + next_transfer.get_memory_size(); }
+		};
+
 		// element used during path search only for storing best lines/convoys
 		struct transport_element_t
 		{
@@ -268,18 +326,27 @@ private:
 			convoihandle_t convoy;
 		};
 
+		// a run of origin cluster members to be explored against a target cluster through the current transfer
+		struct explore_segment_t
+		{
+			uint32 origin_cluster;
+			uint32 target_cluster;
+			uint32 first_member;
+			uint32 last_member;
+		};
+
 		// store the start time of refresh
 		sint64 refresh_start_time;
 
 		// set of variables for finished path data
-		path_element_t **finished_matrix;
+		path_matrix_t *finished_matrix;
 		uint16 *finished_halt_index_map;
 		uint16 finished_halt_count;
 
 		// set of variables for working path data
-		path_element_t **working_matrix;
+		path_matrix_t *working_matrix;
 		uint16 *transport_index_map;
-		transport_element_t **transport_matrix;
+		square_matrix_t<transport_element_t> *transport_matrix;
 		uint16 *working_halt_index_map;
 		halthandle_t *working_halt_list;
 		uint16 working_halt_count;
@@ -291,6 +358,11 @@ private:
 		// a vector for storing lines and lineless convoys
 		vector_tpl<linkage_t> *linkages;
 
+		// lines and lineless convoys whose schedules changed since the current refresh started,
+		// together with the number of them already patched into the finished matrix
+		vector_tpl<linkage_t> incremental_linkages;
+		uint32 incremental_applied_count;
+
 		// set of variables for transfer list
 		uint16 *transfer_list;
 		uint16 transfer_count;
@@ -325,6 +397,9 @@ private:
 		connection_t *outbound_connections;		// relative to the current transfer
 		bool process_next_transfer;
 
+		// segments to be explored through the current transfer; only one compartment explores paths at a time
+		static vector_tpl<explore_segment_t> explore_segments;
+
 		// statistics for determining limits
 		uint32 statistic_duration;
 		uint32 statistic_iteration;
@@ -394,9 +469,21 @@ private:
 		static const uint32 percent_lower_limit = 100 - percent_deviation;
 		static const uint32 percent_upper_limit = 100 + percent_deviation;
 
-		void enumerate_all_paths(const path_element_t *const *const matrix, const halthandle_t *const halt_list,
+		void enumerate_all_paths(const path_matrix_t *const matrix, const halthandle_t *const halt_list,
 								 const uint16 *const halt_map, const uint16 halt_count);
 
+		bool is_linkage_eligible(const linkage_t &linkage) const;
+
+		// builds the list of halts served by a linkage and the journey times between consecutive halts
+		bool prepare_linkage_halts(const linkage_t &linkage, const sint64 inauguration_limit, minivec_tpl<halthandle_t> &halt_list,
+								   minivec_tpl<uint32> &journey_time_list, minivec_tpl<bool> &recurrence_list) const;
+
+		haltestelle_t::connexion *create_connexion(const linkage_t &linkage, const halthandle_t origin_halt, const halthandle_t target_halt,
+												   const uint32 accumulated_journey_time) const;
+
+		// shortens the paths in the finished matrix using the connexions of a single linkage
+		void apply_incremental_linkage(const linkage_t &linkage);
+
 	public:
 
 		compartment_t();
@@ -412,6 +499,9 @@ private:
 		void step();
 		void reset(const bool reset_finished_set);
 
+		// explores the collected segments for the origin halts with index % share_count == share
+		void explore_segments_share(const uint16 via, const uint32 share, const uint32 share_count);
+
 		bool are_paths_available() const { return paths_available; }
 		bool is_refresh_completed() const { return refresh_completed; }
 		bool is_refresh_requested() const { return refresh_requested; }
@@ -428,9 +518,15 @@ private:
 		void set_class(uint8 value);
 		void set_refresh() { refresh_requested = true; }
 
+		void add_incremental_linkage(const linkage_t &linkage);
+		void apply_incremental_linkages();
+
 		bool get_path_between(const halthandle_t origin_halt, const halthandle_t target_halt,
 							  uint32 &aggregate_time, halthandle_t &next_transfer);
 
+		void get_paths(const halthandle_t *origin_halts, const uint32 origin_count, const vector_tpl<halthandle_t> &target_halts,
+					   const vector_tpl<uint32> &target_times, route_t *routes);
+
 		const char *get_category_name() const { return ( catg_name ? catg_name : "" ); }
 		const char *get_class_name() const { return ( class_name ? class_name : "" );  }
 		const char *get_current_phase_name() const { return phase_name[current_phase]; }
@@ -498,10 +594,26 @@ private:
 	static uint8 current_compartment_class;
 	static bool processing;
 
+#ifdef MULTI_THREAD_PATH_EXPLORER
+	// worker threads which share the path exploration through large transfers with the path explorer thread
+	static uint32 worker_count;
+	static compartment_t *parallel_compartment;
+	static uint16 parallel_via;
+
+	// below this number of relaxations through a transfer, waking the workers costs more than it saves
+	static const uint64 parallel_relaxation_threshold = 0x8000;
+
+	static void explore_segments_parallel(compartment_t *compartment, const uint16 via);
+#endif
+
 public:
 #ifdef MULTI_THREAD
 	static thread_local bool allow_path_explorer_on_this_thread;
 	friend void *path_explorer_threaded(void* args);
+#endif
+#ifdef MULTI_THREAD_PATH_EXPLORER
+	friend void *path_explorer_worker_threaded(void* args);
+	static void set_worker_count(const uint32 count) { worker_count = count; }
 #endif
 	static void initialise(karte_t *welt);
 	static void finalise();
@@ -512,12 +624,31 @@ public:
 	static void refresh_all_categories(const bool reset_working_set);
 	static void refresh_category(const uint8 category);
 	static void refresh_class_category(const uint8 category, const uint8 g_class);
+
+	/**
+	 * Patches the finished paths of a category with the connexions of a changed line or lineless convoy,
+	 * so that new services can be used before the full refresh of the category has completed.
+	 * Connexions which have been removed are only dropped by the full refresh.
+	 */
+	static void refresh_linkage(const uint8 category, linehandle_t line, convoihandle_t convoy);
 	static bool get_catg_path_between(const uint8 category, const halthandle_t origin_halt, const halthandle_t target_halt,
 									  uint32 &aggregate_time, halthandle_t &next_transfer, uint8 g_class = 0)
 	{
 		return goods_compartment[category][g_class].get_path_between(origin_halt, target_halt, aggregate_time, next_transfer);
 	}
 
+	/**
+	 * Finds for each origin halt the quickest path to any of the target halts in a single pass
+	 * over the matrix row of the origin. target_times[t] is added to the time of a path ending
+	 * at target_halts[t], e.g. for walking to the final destination. Of equally quick paths the
+	 * one to the first target is taken, as with repeated calls of get_catg_path_between().
+	 */
+	static void get_catg_paths(const uint8 category, const uint8 g_class, const halthandle_t *origin_halts, const uint32 origin_count,
+							   const vector_tpl<halthandle_t> &target_halts, const vector_tpl<uint32> &target_times, route_t *routes)
+	{
+		goods_compartment[category][g_class].get_paths(origin_halts, origin_count, target_halts, target_times, routes);
+	}
+
 	static karte_t *get_world() { return world; }
 	static bool are_local_limits_changed() { return compartment_t::are_local_limits_changed(); }
 	static void reset_local_limits_state() { compartment_t::reset_local_limits_state(); }
@@ -1235,6 +1235,13 @@ bool player_t::has_money_or_assets() const
 	return finance->has_money_or_assets();
 }
 
+void player_t::set_allow_access_to(uint8 other_player_nr, bool allow)
+{
+	access[other_player_nr] = allow;
+	// which ways the other player's vehicles may use has changed
+	weg_t::network_changed();
+}
+
 void player_t::set_selected_signalbox(signalbox_t* sb)
 {
 	signalbox_t* old_selected = get_selected_signalbox();
@@ -462,7 +462,7 @@ public:
 	void complete_liquidation();
 
 	bool allows_access_to(uint8 other_player_nr) const { return player_nr == other_player_nr || access[other_player_nr]; }
-	void set_allow_access_to(uint8 other_player_nr, bool allow) { access[other_player_nr] = allow; }
+	void set_allow_access_to(uint8 other_player_nr, bool allow);
 
 	uint16 get_favorite_livery_scheme_index(uint8 linetype = 0) const { assert(linetype<9/*simline_t::MAX_LINE_TYPE*/); return favorite_livery_scheme[linetype]; }
 	void set_favorite_livery_scheme_index(uint8 linetype = 0, uint16 livery_scheme_index = UINT16_MAX)
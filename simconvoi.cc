@@ -76,11 +76,11 @@
 #ifdef MULTI_THREAD
 #include "utils/simthread.h"
 static pthread_mutex_t step_convois_mutex = PTHREAD_MUTEX_INITIALIZER;
-static vector_tpl<pthread_t> unreserve_threads;
-waytype_t convoi_t::current_waytype = road_wt;
-uint16 convoi_t::current_unreserver = 0;
 #endif
 
+// define to compare the reserved ways of a convoy with all ways of the map when releasing them
+//#define CHECK_RESERVATION_INDEX
+
 //#if _MSC_VER
 //#define snprintf _snprintf
 //#endif
@@ -306,6 +306,9 @@ DBG_MESSAGE("convoi_t::~convoi_t()", "destroying %d, %p", self.get_id(), this);
 		if (!line.is_bound()) {
 			unregister_stops();
 		}
+
+		// the ways must not refer to this convoy any more
+		unreserve_route();
 	}
 
 	// force asynchronous recalculation
@@ -359,59 +362,49 @@ bool convoi_t::is_waypoint( koord3d ziel ) const
 	return !haltestelle_t::get_halt(ziel,get_owner()).is_bound();
 }
 
-#ifdef MULTI_THREAD
-
-void convoi_t::unreserve_route_range(route_range_specification range)
-{
-	const vector_tpl<weg_t *> &all_ways = weg_t::get_alle_wege();
-	for (uint32 i = range.start; i <= range.end; i++)
-	{
-		weg_t* const way = all_ways[i];
-		//schiene_t* const sch = obj_cast<schiene_t>(way);
-		schiene_t* const sch = way->is_rail_type() || way->get_waytype() == air_wt ? (schiene_t*)way : NULL;
-		if (sch && sch->get_reserved_convoi().get_id() == convoi_t::current_unreserver)
-		{
-			convoihandle_t ch;
-			ch.set_id(convoi_t::current_unreserver);
-			sch->unreserve(ch);
-		}
-	}
-}
-
-#endif
-
 /**
  * unreserves the whole remaining route
  */
 void convoi_t::unreserve_route()
 {
-	// Clears all reserved tiles on the whole map belonging to this convoy.
-#ifdef MULTI_THREAD_ROUTE_UNRESERVER
-
-	current_unreserver = self.get_id();
-	current_waytype = front()->get_waytype();
-
-	simthread_barrier_wait(&karte_t::unreserve_route_barrier);
-	simthread_barrier_wait(&karte_t::unreserve_route_barrier);
-
-	current_unreserver = 0;
-	current_waytype = invalid_wt;
-
-#else
+#ifdef CHECK_RESERVATION_INDEX
+	uint32 count = 0;
 	FOR(vector_tpl<weg_t*>, const way, weg_t::get_alle_wege())
 	{
-		if(way->get_waytype() == front()->get_waytype())
+		schiene_t* const sch = way->is_rail_type() || way->get_waytype() == air_wt ? (schiene_t*)way : NULL;
+		if(sch && sch->get_reserved_convoi() == self)
 		{
-			//schiene_t* const sch = obj_cast<schiene_t>(way);
-			schiene_t* const sch = way->is_rail_type() ? (schiene_t*)way : NULL;
-			if(sch && sch->get_reserved_convoi() == self)
+			count++;
+			if(!reserved_ways.is_contained(sch))
 			{
-				sch->unreserve(front());
+				dbg->error("convoi_t::unreserve_route()", "%s reserved %s, but did not list it", get_name(), sch->get_pos().get_str());
 			}
 		}
 	}
+	if(count != reserved_ways.get_count())
+	{
+		dbg->error("convoi_t::unreserve_route()", "%s listed %u reserved ways, but reserved %u", get_name(), reserved_ways.get_count(), count);
+	}
 #endif
 
+	// Clears all reserved tiles on the whole map belonging to this convoy.
+	// Each release takes the way off the list; the list shrinks in every pass anyway,
+	// so a stale entry cannot stall this.
+	while(!reserved_ways.empty())
+	{
+		schiene_t* const sch = reserved_ways.back();
+		const uint32 count = reserved_ways.get_count();
+		if(sch->get_reserved_convoi() == self)
+		{
+			sch->unreserve(self);
+		}
+		if(reserved_ways.get_count() == count)
+		{
+			dbg->error("convoi_t::unreserve_route()", "%s listed %s, but did not reserve it", get_name(), sch->get_pos().get_str());
+			reserved_ways.pop_back();
+		}
+	}
+
 	set_needs_full_route_flush(false);
 }
 
@@ -2017,7 +2010,7 @@ end_loop:
 						else
 						{
 							// refresh only those categories which are either removed or added to the category list
-							haltestelle_t::refresh_routing(schedule, catg_differences, &passenger_class_differences, &mail_class_differences, owner);
+							haltestelle_t::refresh_routing(schedule, catg_differences, &passenger_class_differences, &mail_class_differences, owner, linehandle_t(), self);
 						}
 					}
 
@@ -2742,7 +2735,7 @@ void convoi_t::start(depot_t* dep)
 			// New method - recalculate as necessary
 
 			// Added by : Knightly
-			haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, owner);
+			haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, owner, linehandle_t(), self);
 		}
 		wait_lock = 0;
 
@@ -3156,7 +3149,7 @@ bool convoi_t::set_schedule(schedule_t * sch)
 			if ( !old_schedule->matches(welt, schedule) )
 			{
 				haltestelle_t::refresh_routing(old_schedule, goods_catg_index, NULL, NULL, owner);
-				haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, owner);
+				haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, owner, linehandle_t(), self);
 			}
 		}
 		else
@@ -3165,7 +3158,7 @@ bool convoi_t::set_schedule(schedule_t * sch)
 			{
 				haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, owner);
 			}
-			haltestelle_t::refresh_routing(sch, goods_catg_index, NULL, NULL, owner);
+			haltestelle_t::refresh_routing(sch, goods_catg_index, NULL, NULL, owner, linehandle_t(), self);
 		}
 	}
 
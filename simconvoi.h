@@ -39,6 +39,7 @@
 #define MAX_MONTHS               12 // Max history
 
 class weg_t;
+class schiene_t;
 class depot_t;
 class karte_ptr_t;
 class player_t;
@@ -56,14 +57,6 @@ class departure_point_t;
 */
 typedef koordhashtable_tpl<id_pair, average_tpl<uint32>, N_BAGS_SMALL> journey_times_map;
 
-#ifdef MULTI_THREAD
-struct route_range_specification
-{
-	uint32 start;
-	uint32 end;
-};
-#endif
-
 /**
  * Base class for all vehicle consists. Convoys can be referenced by handles, see halthandle_t.
  */
@@ -785,14 +778,16 @@ public:
 	*/
 	void hat_gehalten(halthandle_t halt);
 
-#ifdef MULTI_THREAD
 private:
-	static void unreserve_route_range(route_range_specification range);
-	friend void *unreserve_route_threaded(void* args);
-	static waytype_t current_waytype;
-	static uint16 current_unreserver;
+	/**
+	 * All ways reserved by this convoy. schiene_t keeps this up to date
+	 * whenever a way is reserved or released.
+	 */
+	vector_tpl<schiene_t *> reserved_ways;
+	friend class schiene_t;
+
 public:
-#endif
+	const vector_tpl<schiene_t *> &get_reserved_ways() const { return reserved_ways; }
 
 	/**
 	 * remove all track reservations (trains only)
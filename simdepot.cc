@@ -56,6 +56,7 @@ depot_t::depot_t(loadsave_t *file) : gebaeude_t()
 		set_yoff(0);
 	}
 	all_depots.append(this);
+	weg_t::network_changed();
 	last_selected_line = linehandle_t();
 	command_pending = false;
 }
@@ -70,6 +71,7 @@ depot_t::depot_t(koord3d pos, player_t *player, const building_tile_desc_t *t) :
 #endif
 {
 	all_depots.append(this);
+	weg_t::network_changed();
 	last_selected_line = linehandle_t();
 	command_pending = false;
 	strcpy(name, "unnamed");
@@ -81,6 +83,7 @@ depot_t::~depot_t()
 {
 	destroy_win((ptrdiff_t)this);
 	all_depots.remove(this);
+	weg_t::network_changed();
 	const grund_t* gr = welt->lookup(get_pos());
 	if(gr)
 	{
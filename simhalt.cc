@@ -390,7 +390,7 @@ haltestelle_t::haltestelle_t(loadsave_t* file)
 	const uint8 max_categories = goods_manager_t::get_max_catg_index();
 	const uint8 max_classes = max(goods_manager_t::passengers->get_number_of_classes(), goods_manager_t::mail->get_number_of_classes());
 
-	cargo = (vector_tpl<ware_t> **)calloc( max_categories, sizeof(vector_tpl<ware_t> *) );
+	cargo = (halt_cargo_t **)calloc( max_categories, sizeof(halt_cargo_t *) );
 
 	non_identical_schedules.set_count(max_categories * max_classes);
 	// CHECK: Do we need the below in light of the above? Does the above auto-initialise the values to zero?
@@ -467,7 +467,7 @@ haltestelle_t::haltestelle_t(koord k, player_t* player)
 	const uint8 max_categories = goods_manager_t::get_max_catg_index();
 	const uint8 max_classes = max(goods_manager_t::passengers->get_number_of_classes(), goods_manager_t::mail->get_number_of_classes());
 
-	cargo = (vector_tpl<ware_t> **)calloc( max_categories, sizeof(vector_tpl<ware_t> *) );
+	cargo = (halt_cargo_t **)calloc( max_categories, sizeof(halt_cargo_t *) );
 
 	non_identical_schedules.set_count(max_categories * max_classes);
 	// CHECK: Do we need the below in light of the above? Does the above auto-initialise the values to zero?
@@ -509,6 +509,8 @@ haltestelle_t::haltestelle_t(koord k, player_t* player)
 
 	check_waiting = 0;
 
+	service_frequencies_outdated = false;
+
 	check_nearby_halts();
 
 	// Added by : Knightly
@@ -641,8 +643,10 @@ haltestelle_t::~haltestelle_t()
 
 	for(uint8 i = 0; i < max_categories; i++) {
 		if (cargo[i]) {
-			FOR(vector_tpl<ware_t>, const &w, *cargo[i]) {
-				fabrik_t::update_transit(w, false);
+			FOR(vector_tpl<halt_cargo_t::bucket_t *>, const bucket, cargo[i]->get_buckets()) {
+				FOR(vector_tpl<ware_t>, const &w, bucket->wares) {
+					fabrik_t::update_transit(w, false);
+				}
 			}
 			delete cargo[i];
 			cargo[i] = NULL;
@@ -689,18 +693,15 @@ void haltestelle_t::rotate90( const sint16 y_size )
 	// iterate over all different categories
 	for(uint8 i=0; i<goods_manager_t::get_max_catg_index(); i++) {
 		if(cargo[i]) {
-			vector_tpl<ware_t>& warray = *cargo[i];
-			for (size_t j = warray.get_count(); j-- > 0;) {
-				ware_t& ware = warray[j];
-				if(ware.menge>0) {
-					ware.rotate90(y_size);
-				}
-				else
-				{
-					// empty => remove
-					warray.remove_at(j);
+			FOR(vector_tpl<halt_cargo_t::bucket_t *>, const bucket, cargo[i]->get_buckets()) {
+				FOR(vector_tpl<ware_t>, & ware, bucket->wares) {
+					if(ware.menge>0) {
+						ware.rotate90(y_size);
+					}
 				}
 			}
+			// empty => remove
+			cargo[i]->tidy();
 		}
 	}
 
@@ -1278,6 +1279,11 @@ void haltestelle_t::step()
 	}
 	categories_to_refresh_next_step.clear();
 
+	if(service_frequencies_outdated)
+	{
+		calc_service_frequencies();
+	}
+
 	check_transferring_cargoes();
 
 	recalc_status();
@@ -1292,7 +1298,7 @@ void haltestelle_t::step()
 	// Will overflow at 255.
 	if(++ check_waiting == 0)
 	{
-		vector_tpl<ware_t> *warray;
+		halt_cargo_t *warray;
 		for(uint16 j = 0; j < goods_manager_t::get_max_catg_index(); j ++)
 		{
 			warray = cargo[j];
@@ -1300,159 +1306,162 @@ void haltestelle_t::step()
 			{
 				continue;
 			}
-			for(uint32 i = 0; i < warray->get_count(); i++)
+			FOR(vector_tpl<halt_cargo_t::bucket_t *>, const bucket, warray->get_buckets())
 			{
-				ware_t &tmp = (*warray)[i];
-
-				// skip empty entries
-				if(tmp.menge == 0)
-				{
-					continue;
-				}
-
-				// Check whether these goods/passengers are waiting to go to a factory that has been deleted.
-				const grund_t* gr = welt->lookup_kartenboden(tmp.get_zielpos());
-				const gebaeude_t* const gb = gr ? gr->get_building() : NULL;
-				fabrik_t* const fab = gb ? gb->get_fabrik() : NULL;
-				if(!gb || (tmp.is_freight() && !fab))
+				for(uint32 i = 0; i < bucket->wares.get_count(); i++)
 				{
-					// The goods/passengers leave.  We must record the lower "in transit" count on factories.
-					fabrik_t::update_transit(tmp, false);
-					tmp.menge = 0;
+					ware_t &tmp = bucket->wares[i];
 
-					// No need to record waiting times if the goods are discarded because their destination
-					// does not exist.
-					continue;
-				}
+					// skip empty entries
+					if(tmp.menge == 0)
+					{
+						continue;
+					}
 
-				uint32 waiting_tenths = convoi_t::get_waiting_minutes(welt->get_ticks() - tmp.arrival_time);
+					// Check whether these goods/passengers are waiting to go to a factory that has been deleted.
+					const grund_t* gr = welt->lookup_kartenboden(tmp.get_zielpos());
+					const gebaeude_t* const gb = gr ? gr->get_building() : NULL;
+					fabrik_t* const fab = gb ? gb->get_fabrik() : NULL;
+					if(!gb || (tmp.is_freight() && !fab))
+					{
+						// The goods/passengers leave.  We must record the lower "in transit" count on factories.
+						fabrik_t::update_transit(tmp, false);
+						warray->take(tmp, tmp.menge);
 
-				// Checks to see whether the freight has been waiting too long.
-				// If so, discard it.
+						// No need to record waiting times if the goods are discarded because their destination
+						// does not exist.
+						continue;
+					}
 
-				if(tmp.get_desc()->get_speed_bonus() > 0u) // TODO: Consider what to do about this now that speed boni are deprecated. Should the base data for speed boni be retained just for this?
-				{
-					// Only consider for discarding if the goods (ever) care about their timings.
-					// Use 32-bit math; it's very easy to overflow 16 bits.
-					const uint32 max_wait = welt->get_settings().get_passenger_max_wait();
-					const uint32 max_wait_minutes = max_wait / tmp.get_desc()->get_speed_bonus();
-					uint32 max_wait_tenths = max_wait_minutes * 10u;
+					uint32 waiting_tenths = convoi_t::get_waiting_minutes(welt->get_ticks() - tmp.arrival_time);
 
-					// Passengers' maximum waiting times were formerly limited to thrice their estimated
-					// journey time, but this is no longer so from version 11.14 onwards.
+					// Checks to see whether the freight has been waiting too long.
+					// If so, discard it.
 
-					if(waiting_tenths > max_wait_tenths)
+					if(tmp.get_desc()->get_speed_bonus() > 0u) // TODO: Consider what to do about this now that speed boni are deprecated. Should the base data for speed boni be retained just for this?
 					{
-						bool passengers_walked = false;
-						// Waiting too long: discard
-						if(tmp.is_passenger())
-						{
-							// Check to see whether they can walk to their ultimate destination or next transfer first.
-							const uint16 max_walking_distance = welt->get_settings().get_station_coverage() / 2;
-							if(shortest_distance(get_next_pos(tmp.get_zielpos()), tmp.get_zielpos()) <= max_walking_distance)
-							{
-								// Passengers can walk to their ultimate destination.
-								add_to_waiting_list(tmp, calc_ready_time(tmp, false));
-								passengers_walked = true;
-							}
+						// Only consider for discarding if the goods (ever) care about their timings.
+						// Use 32-bit math; it's very easy to overflow 16 bits.
+						const uint32 max_wait = welt->get_settings().get_passenger_max_wait();
+						const uint32 max_wait_minutes = max_wait / tmp.get_desc()->get_speed_bonus();
+						uint32 max_wait_tenths = max_wait_minutes * 10u;
 
-							uint32 distance_to_transfer = 0;
+						// Passengers' maximum waiting times were formerly limited to thrice their estimated
+						// journey time, but this is no longer so from version 11.14 onwards.
 
-							if (tmp.get_zwischenziel().is_bound())
+						if(waiting_tenths > max_wait_tenths)
+						{
+							bool passengers_walked = false;
+							// Waiting too long: discard
+							if(tmp.is_passenger())
 							{
-								distance_to_transfer = shortest_distance(get_next_pos(tmp.get_zwischenziel()->get_basis_pos()), get_next_pos(tmp.get_zwischenziel()->get_basis_pos()));
-
-								if (distance_to_transfer <= max_walking_distance)
+								// Check to see whether they can walk to their ultimate destination or next transfer first.
+								const uint16 max_walking_distance = welt->get_settings().get_station_coverage() / 2;
+								if(shortest_distance(get_next_pos(tmp.get_zielpos()), tmp.get_zielpos()) <= max_walking_distance)
 								{
-									// Passengers can walk to their next transfer.
-									const uint32 walking_time = welt->walking_time_tenths_from_distance(distance_to_transfer);
-									pedestrian_t::generate_pedestrians_at(get_basis_pos3d(), tmp.menge, world()->get_seconds_to_ticks(walking_time * 6));
-									tmp.set_last_transfer(self);
-									tmp.get_zwischenziel()->liefere_an(tmp, 1);
+									// Passengers can walk to their ultimate destination.
+									add_to_waiting_list(tmp, calc_ready_time(tmp, false));
 									passengers_walked = true;
 								}
-							}
 
-							// Passengers - use unhappy graph. Even passengers able to walk to their destination or
-							// next transfer are not happy about it if they expected to be able to take a ride there.
-							add_pax_too_waiting(tmp.menge);
-						}
+								uint32 distance_to_transfer = 0;
 
-						// If they are discarded, a refund is due.
-						convoihandle_t account_convoy = get_preferred_convoy(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
-						if(!passengers_walked && tmp.get_origin().is_bound() && get_owner()->get_finance()->get_account_balance() > 0)
-						{
-							// Cannot refund unless we know the origin.
-							// Also, ought not refund unless the player is solvent.
-							// Players ought not be put out of business by refunds, as this makes gameplay too unpredictable,
-							// especially in online games, where joining one player's network to another might lead to a large
-							// influx of passengers which one of the networks cannot cope with.
-							const uint16 distance = shortest_distance(get_basis_pos(), tmp.get_origin()->get_basis_pos());
-
-							if(distance > 0) // No point in calculating refund if passengers/goods are discarded from their origin stop.
-							{
-								const uint32 distance_meters = (uint32) distance * welt->get_settings().get_meters_per_tile();
-								// Refund is approximation: 2x distance at standard rate with no adjustments.
-								const sint64 refund_amount = (tmp.menge * tmp.get_desc()->get_refund(distance_meters) + 2048ll) / 4096ll;
-
-								// Find the line the pasenger was *trying to go on* -- make it pay the refund
-								linehandle_t account_line = get_preferred_line(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
-								if(account_line.is_bound())
+								if (tmp.get_zwischenziel().is_bound())
 								{
-									account_line->book(-refund_amount, LINE_PROFIT);
-									account_line->book(-refund_amount, LINE_REFUNDS);
-									account_line->get_owner()->book_revenue(-refund_amount, get_basis_pos(), simline_t::linetype_to_waytype(account_line->get_linetype()), ATV_REVENUE_PASSENGER);
+									distance_to_transfer = shortest_distance(get_next_pos(tmp.get_zwischenziel()->get_basis_pos()), get_next_pos(tmp.get_zwischenziel()->get_basis_pos()));
+
+									if (distance_to_transfer <= max_walking_distance)
+									{
+										// Passengers can walk to their next transfer.
+										const uint32 walking_time = welt->walking_time_tenths_from_distance(distance_to_transfer);
+										pedestrian_t::generate_pedestrians_at(get_basis_pos3d(), tmp.menge, world()->get_seconds_to_ticks(walking_time * 6));
+										tmp.set_last_transfer(self);
+										tmp.get_zwischenziel()->liefere_an(tmp, 1);
+										passengers_walked = true;
+									}
 								}
-								else
+
+								// Passengers - use unhappy graph. Even passengers able to walk to their destination or
+								// next transfer are not happy about it if they expected to be able to take a ride there.
+								add_pax_too_waiting(tmp.menge);
+							}
+
+							// If they are discarded, a refund is due.
+							convoihandle_t account_convoy = get_preferred_convoy(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
+							if(!passengers_walked && tmp.get_origin().is_bound() && get_owner()->get_finance()->get_account_balance() > 0)
+							{
+								// Cannot refund unless we know the origin.
+								// Also, ought not refund unless the player is solvent.
+								// Players ought not be put out of business by refunds, as this makes gameplay too unpredictable,
+								// especially in online games, where joining one player's network to another might lead to a large
+								// influx of passengers which one of the networks cannot cope with.
+								const uint16 distance = shortest_distance(get_basis_pos(), tmp.get_origin()->get_basis_pos());
+
+								if(distance > 0) // No point in calculating refund if passengers/goods are discarded from their origin stop.
 								{
-									if(account_convoy.is_bound())
+									const uint32 distance_meters = (uint32) distance * welt->get_settings().get_meters_per_tile();
+									// Refund is approximation: 2x distance at standard rate with no adjustments.
+									const sint64 refund_amount = (tmp.menge * tmp.get_desc()->get_refund(distance_meters) + 2048ll) / 4096ll;
+
+									// Find the line the pasenger was *trying to go on* -- make it pay the refund
+									linehandle_t account_line = get_preferred_line(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
+									if(account_line.is_bound())
 									{
-										account_convoy->book(-refund_amount, convoi_t::CONVOI_PROFIT);
-										account_convoy->book(-refund_amount, convoi_t::CONVOI_REFUNDS);
-										account_convoy->get_owner()->book_revenue(-refund_amount, get_basis_pos(), account_convoy->front()->get_waytype(), ATV_REVENUE_PASSENGER);
+										account_line->book(-refund_amount, LINE_PROFIT);
+										account_line->book(-refund_amount, LINE_REFUNDS);
+										account_line->get_owner()->book_revenue(-refund_amount, get_basis_pos(), simline_t::linetype_to_waytype(account_line->get_linetype()), ATV_REVENUE_PASSENGER);
 									}
 									else
 									{
-										// no line or convoy found -> charge the stop owner
-										owner->book_revenue(-refund_amount, get_basis_pos(), ignore_wt, ATV_REVENUE_PASSENGER);
+										if(account_convoy.is_bound())
+										{
+											account_convoy->book(-refund_amount, convoi_t::CONVOI_PROFIT);
+											account_convoy->book(-refund_amount, convoi_t::CONVOI_REFUNDS);
+											account_convoy->get_owner()->book_revenue(-refund_amount, get_basis_pos(), account_convoy->front()->get_waytype(), ATV_REVENUE_PASSENGER);
+										}
+										else
+										{
+											// no line or convoy found -> charge the stop owner
+											owner->book_revenue(-refund_amount, get_basis_pos(), ignore_wt, ATV_REVENUE_PASSENGER);
+										}
 									}
 								}
 							}
+
+							// If goods/passengers leave, then they must register a waiting time, or else
+							// overcrowded stops would have excessively low waiting times. Because they leave
+							// before they have got transport, the waiting time registered must be increased
+							// by 4x to reflect an estimate of how long that they would likely have had to
+							// have waited to get transport.
+							waiting_tenths *= 4;
+							linehandle_t account_line = get_preferred_line(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
+							const uint16 airport_wait = (account_convoy.is_bound() && account_convoy->front()->get_typ() == obj_t::air_vehicle) ||
+								(account_line.is_bound() && account_line->get_convoy(0).is_bound() && account_line->get_convoy(0)->front()->get_typ() == obj_t::air_vehicle) ?
+								welt->get_settings().get_min_wait_airport() : 0;
+							add_waiting_time(max(airport_wait, waiting_tenths), tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
+
+							// The goods/passengers leave.  We must record the lower "in transit" count on factories.
+							fabrik_t::update_transit(tmp, false);
+							warray->take(tmp, tmp.menge);
+
+							// Normally we record long waits below, but we just did, so don't do it twice.
+							continue;
 						}
+					}
 
-						// If goods/passengers leave, then they must register a waiting time, or else
-						// overcrowded stops would have excessively low waiting times. Because they leave
-						// before they have got transport, the waiting time registered must be increased
-						// by 4x to reflect an estimate of how long that they would likely have had to
-						// have waited to get transport.
-						waiting_tenths *= 4;
+					// Check to see whether these passengers/this freight has been waiting more than 2x as long
+					// as the existing registered waiting times. If so, register the waiting time to prevent an
+					// artificially low time from being recorded if there is a long service interval.
+					if(waiting_tenths > 2 * get_average_waiting_time(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class()))
+					{
 						linehandle_t account_line = get_preferred_line(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
+						convoihandle_t account_convoy = get_preferred_convoy(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
 						const uint16 airport_wait = (account_convoy.is_bound() && account_convoy->front()->get_typ() == obj_t::air_vehicle) ||
 							(account_line.is_bound() && account_line->get_convoy(0).is_bound() && account_line->get_convoy(0)->front()->get_typ() == obj_t::air_vehicle) ?
-							welt->get_settings().get_min_wait_airport() : 0;
-						add_waiting_time(max(airport_wait, waiting_tenths), tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
-
-						// The goods/passengers leave.  We must record the lower "in transit" count on factories.
-						fabrik_t::update_transit(tmp, false);
-						tmp.menge = 0;
-
-						// Normally we record long waits below, but we just did, so don't do it twice.
-						continue;
+								welt->get_settings().get_min_wait_airport() : 0;
+						add_waiting_time(max(waiting_tenths, airport_wait), tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
 					}
 				}
-
-				// Check to see whether these passengers/this freight has been waiting more than 2x as long
-				// as the existing registered waiting times. If so, register the waiting time to prevent an
-				// artificially low time from being recorded if there is a long service interval.
-				if(waiting_tenths > 2 * get_average_waiting_time(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class()))
-				{
-					linehandle_t account_line = get_preferred_line(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
-					convoihandle_t account_convoy = get_preferred_convoy(tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
-					const uint16 airport_wait = (account_convoy.is_bound() && account_convoy->front()->get_typ() == obj_t::air_vehicle) ||
-						(account_line.is_bound() && account_line->get_convoy(0).is_bound() && account_line->get_convoy(0)->front()->get_typ() == obj_t::air_vehicle) ?
-							welt->get_settings().get_min_wait_airport() : 0;
-					add_waiting_time(max(waiting_tenths, airport_wait), tmp.get_zwischenziel(), tmp.get_desc()->get_catg_index(), tmp.get_class());
-				}
 			}
 		}
 	}
@@ -1540,18 +1549,20 @@ uint32 haltestelle_t::reroute_goods(const uint8 catg)
 {
 	if(cargo[catg])
 	{
-		vector_tpl<ware_t> * warray = cargo[catg];
-		const uint32 packet_count = warray->get_count();
-		vector_tpl<ware_t> * new_warray = new vector_tpl<ware_t>(packet_count);
+		const uint32 packet_count = cargo[catg]->get_count();
+		vector_tpl<ware_t> warray(packet_count);
+		cargo[catg]->get_all(warray);
+		// the packets are sorted into their buckets anew
+		cargo[catg]->clear();
 
 		// Hajo:
 		// Step 1: re-route goods now and then to adapt to changes in
 		// world layout, remove all goods which destination was removed from the map
 		// prissi;
 		// also the empty entries of the array are cleared
-		for(int j = packet_count - 1; j  >= 0; j--)
+		for(int j = warray.get_count() - 1; j  >= 0; j--)
 		{
-			ware_t & ware = (*warray)[j];
+			ware_t & ware = warray[j];
 
 			if(ware.menge == 0)
 			{
@@ -1591,11 +1602,11 @@ uint32 haltestelle_t::reroute_goods(const uint8 catg)
 			}
 
 			// add to new array
-			new_warray->append( ware );
+			cargo[catg]->add( ware, false );
 		}
 
 		// delete, if nothing connects here
-		if (new_warray->empty())
+		if (cargo[catg]->empty())
 		{
 			uint32 iterations = goods_manager_t::get_classes_catg_index(catg);
 
@@ -1604,13 +1615,13 @@ uint32 haltestelle_t::reroute_goods(const uint8 catg)
 				if (get_connexions(catg, n)->empty())
 				{
 					// no connections from here => delete
-					delete new_warray;
-					new_warray = NULL;
+					delete cargo[catg];
+					cargo[catg] = NULL;
 					ware_t ware;
 
-					for (uint32 i = 0; i < packet_count; i++)
+					for (uint32 i = 0; i < warray.get_count(); i++)
 					{
-						ware = warray->get_element(i);
+						ware = warray.get_element(i);
 						if (ware.is_freight())
 						{
 							const grund_t* gr = welt->lookup_kartenboden(ware.get_zielpos());
@@ -1629,10 +1640,6 @@ uint32 haltestelle_t::reroute_goods(const uint8 catg)
 			}
 		}
 
-		// replace the array
-		delete cargo[catg];
-		cargo[catg] = new_warray;
-
 		// likely the display must be updated after this
 		resort_freight_info = true;
 
@@ -1873,8 +1880,9 @@ uint32 haltestelle_t::get_service_frequency(halthandle_t destination, uint8 cate
 	spec.x = category;
 	spec.y = destination.get_id();
 
-	if (service_frequencies.is_contained(spec))
+	if (service_frequencies.is_contained(spec) || !service_frequencies_outdated)
 	{
+		// Up to date, all served stops are in there.
 		return service_frequencies.get(spec);
 	}
 
@@ -1887,115 +1895,153 @@ uint32 haltestelle_t::get_service_frequency(halthandle_t destination, uint8 cate
 	return calc_service_frequency(destination, category);
 }
 
-uint32 haltestelle_t::calc_service_frequency(halthandle_t destination, uint8 category) const
+uint32 haltestelle_t::calc_service_interval(linehandle_t line, vector_tpl<halthandle_t> &served_halts) const
 {
-	uint32 service_frequency = 0;
+	if (line->count_convoys() == 0)
+	{
+		// No service at all
+		return 0;
+	}
+
+	const schedule_t *schedule = line->get_schedule();
+	const uint8 schedule_count = schedule->get_count();
 
-	for (uint32 i = 0; i < registered_lines.get_count(); i++)
+	// Look up each stop only once
+	vector_tpl<halthandle_t> halts(schedule_count);
+	for (uint8 n = 0; n < schedule_count; n++)
 	{
-		if (!registered_lines[i]->get_goods_catg_index().is_contained(category))
-		{
-			continue;
-		}
-		uint8 schedule_count = registered_lines[i]->get_schedule()->get_count();
-		uint32 timing = 0;
-		bool line_serves_destination = false;
-		uint32 number_of_calls_at_this_stop = 0;
-		koord3d current_halt_pos;
-		koord3d next_halt_pos;
-		for (uint8 n = 0; n < schedule_count; n++)
+		halts.append(haltestelle_t::get_halt(schedule->entries[n].pos, owner));
+	}
+
+	uint32 timing = 0;
+	uint32 number_of_calls_at_this_stop = 0;
+	for (uint8 n = 0; n < schedule_count; n++)
+	{
+		const uint8 next = n < schedule_count - 2 ? n + 1 : 0;
+		if (n < schedule_count - 1)
 		{
-			current_halt_pos = registered_lines[i]->get_schedule()->entries[n].pos;
-			if (n < schedule_count - 2)
+			const uint32 average_time = line->get_average_journey_times().get(id_pair(halts[n].get_id(), halts[next].get_id())).get_average();
+			if (average_time != 0 && average_time != UINT32_MAX_VALUE)
 			{
-				next_halt_pos = registered_lines[i]->get_schedule()->entries[n + 1].pos;
+				timing += average_time;
 			}
 			else
 			{
-				next_halt_pos = registered_lines[i]->get_schedule()->entries[0].pos;
-			}
-			if (n < schedule_count - 1)
-			{
-				const uint32 average_time = registered_lines[i]->get_average_journey_times().get(id_pair(haltestelle_t::get_halt(current_halt_pos, owner).get_id(), haltestelle_t::get_halt(next_halt_pos, owner).get_id())).get_average();
-				if (average_time != 0 && average_time != UINT32_MAX_VALUE)
-				{
-					timing += average_time;
-				}
-				else
-				{
-					// Fallback to convoy's general average speed if a point-to-point average is not available.
-					const uint32 distance = shortest_distance(current_halt_pos.get_2d(), next_halt_pos.get_2d());
-					const uint32 recorded_average_speed = registered_lines[i]->get_finance_history(1, LINE_AVERAGE_SPEED);
-					const uint32 average_speed = recorded_average_speed > 0 ? recorded_average_speed : speed_to_kmh(registered_lines[i]->get_convoy(0)->get_min_top_speed()) >> 1;
-					const uint32 journey_time = welt->travel_time_tenths_from_distance(distance, average_speed);
+				// Fallback to convoy's general average speed if a point-to-point average is not available.
+				const uint32 distance = shortest_distance(schedule->entries[n].pos.get_2d(), schedule->entries[next].pos.get_2d());
+				const uint32 recorded_average_speed = line->get_finance_history(1, LINE_AVERAGE_SPEED);
+				const uint32 average_speed = recorded_average_speed > 0 ? recorded_average_speed : speed_to_kmh(line->get_convoy(0)->get_min_top_speed()) >> 1;
+				const uint32 journey_time = welt->travel_time_tenths_from_distance(distance, average_speed);
 
-					timing += journey_time;
-				}
-			}
-
-			halthandle_t current_halthandle = haltestelle_t::get_halt(current_halt_pos, owner);
-
-			if (current_halthandle == destination)
-			{
-				// This line serves this destination.
-				line_serves_destination = true;
+				timing += journey_time;
 			}
+		}
 
-			if (current_halthandle == self)
-			{
-				number_of_calls_at_this_stop++;
-			}
+		if (halts[n].is_bound())
+		{
+			// This line serves this destination.
+			served_halts.append_unique(halts[n]);
 		}
 
-		if (!line_serves_destination)
+		if (halts[n] == self)
 		{
-			continue;
+			number_of_calls_at_this_stop++;
 		}
+	}
+
+	// Divide the round trip time by the number of convoys in the line and by the number of times that it calls at this stop in its schedule.
+	timing /= (line->count_convoys() * (number_of_calls_at_this_stop == 0 ? 1 : number_of_calls_at_this_stop));
+
+	if (schedule->get_spacing() > 0)
+	{
+		// Check whether the spacing setting affects things.
+		const sint64 spacing_ticks = welt->ticks_per_world_month / (sint64)schedule->get_spacing();
+		uint32 spacing_time = welt->ticks_to_tenths_of_minutes(spacing_ticks);
+		timing = max(spacing_time, timing);
+	}
 
-		// Divide the round trip time by the number of convoys in the line and by the number of times that it calls at this stop in its schedule.
-		timing /= (registered_lines[i]->count_convoys() * (number_of_calls_at_this_stop == 0 ? 1 : number_of_calls_at_this_stop));
+	return max(1, timing);
+}
+
+uint32 haltestelle_t::combine_service_frequencies(uint32 service_frequency, uint32 timing)
+{
+	if (service_frequency == 0)
+	{
+		// This is the only time that this has been set so far, so compute for single line timing.
+		return max(1, timing);
+	}
 
-		if (registered_lines[i]->get_schedule()->get_spacing() > 0)
+	// There are multiple lines serving this stop, so compute for multiple line timing
+	if (service_frequency == timing)
+	{
+		// Two equally timed lines: halve the service frequency
+		return service_frequency / 2;
+	}
+	else if (service_frequency > timing)
+	{
+		// The new timing is more frequent than the service interval calculated so far
+		uint32 proportion_10 = (service_frequency * 10) / timing; // This is the number of new convoys per old convoy in any given time, * 10
+		proportion_10 += 10; // Adding 10 to add back the original convoy: this is now the total number of convoys per service_frequency, * 10
+		return (service_frequency * 10) / proportion_10;
+	}
+	else
+	{
+		// The new timing is less frequent than the service interval calculated so far
+		uint32 proportion_10 = (timing * 10) / service_frequency; // This is the number of new convoys per old convoy in any given time, * 10
+		proportion_10 += 10; // Adding 10 to add back the original convoy: this is now the total number of convoys per service_frequency, * 10
+		return (timing * 10) / proportion_10;
+	}
+}
+
+uint32 haltestelle_t::calc_service_frequency(halthandle_t destination, uint8 category) const
+{
+	uint32 service_frequency = 0;
+	vector_tpl<halthandle_t> served_halts;
+
+	FOR(vector_tpl<linehandle_t>, const line, registered_lines)
+	{
+		if (!line->get_goods_catg_index().is_contained(category))
+		{
+			continue;
+		}
+		served_halts.clear();
+		const uint32 timing = calc_service_interval(line, served_halts);
+		if (timing > 0 && served_halts.is_contained(destination))
 		{
-			// Check whether the spacing setting affects things.
-			const sint64 spacing_ticks = welt->ticks_per_world_month / (sint64)registered_lines[i]->get_schedule()->get_spacing();
-			uint32 spacing_time = welt->ticks_to_tenths_of_minutes(spacing_ticks);
-			timing = max(spacing_time, timing);
+			service_frequency = combine_service_frequencies(service_frequency, timing);
 		}
+	}
 
-		timing = max(1, timing);
+	return service_frequency;
+}
 
-		if (service_frequency == 0)
+void haltestelle_t::calc_service_frequencies()
+{
+	// The lines are combined in the same order as in calc_service_frequency()
+	service_frequencies.clear();
+	vector_tpl<halthandle_t> served_halts;
+	service_frequency_specifier spec;
+
+	FOR(vector_tpl<linehandle_t>, const line, registered_lines)
+	{
+		served_halts.clear();
+		const uint32 timing = calc_service_interval(line, served_halts);
+		if (timing == 0)
 		{
-			// This is the only time that this has been set so far, so compute for single line timing.
-			service_frequency = max(1, timing);
+			continue;
 		}
-		else
+		FOR(minivec_tpl<uint8>, const category, line->get_goods_catg_index())
 		{
-			// There are multiple lines serving this stop, so compute for multiple line timing
-			if (service_frequency == timing)
+			spec.x = category;
+			FOR(vector_tpl<halthandle_t>, const halt, served_halts)
 			{
-				// Two equally timed lines: halve the service frequency
-				service_frequency /= 2;
-			}
-			else if (service_frequency > timing)
-			{
-				// The new timing is more frequent than the service interval calculated so far
-				uint32 proportion_10 = (service_frequency * 10) / timing; // This is the number of new convoys per old convoy in any given time, * 10
-				proportion_10 += 10; // Adding 10 to add back the original convoy: this is now the total number of convoys per service_frequency, * 10
-				service_frequency = (service_frequency * 10) / proportion_10;
-			}
-			else
-			{
-				// The new timing is less frequent than the service interval calculated so far
-				uint32 proportion_10 = (timing * 10) / service_frequency; // This is the number of new convoys per old convoy in any given time, * 10
-				proportion_10 += 10; // Adding 10 to add back the original convoy: this is now the total number of convoys per service_frequency, * 10
-				service_frequency = (timing * 10) / proportion_10;
+				spec.y = halt.get_id();
+				service_frequencies.set(spec, combine_service_frequencies(service_frequencies.get(spec), timing));
 			}
 		}
 	}
 
-	return service_frequency;
+	service_frequencies_outdated = false;
 }
 
 linehandle_t haltestelle_t::get_preferred_line(halthandle_t transfer, uint8 category, uint8 g_class) const
@@ -2029,7 +2075,8 @@ void haltestelle_t::reset_connexions(uint8 category, uint8 g_class)
 // Adapted from : Jamespetts' code
 // Purpose		: To notify relevant halts to rebuild connexions
 // @jamespetts: modified the code to combine with previous method and provide options about partially delayed refreshes for performance.
-void haltestelle_t::refresh_routing(const schedule_t *const sched, const minivec_tpl<uint8> &categories, const minivec_tpl<uint8> *passenger_classes, const minivec_tpl<uint8> *mail_classes, const player_t *const player)
+void haltestelle_t::refresh_routing(const schedule_t *const sched, const minivec_tpl<uint8> &categories, const minivec_tpl<uint8> *passenger_classes, const minivec_tpl<uint8> *mail_classes, const player_t *const player,
+								   linehandle_t line, convoihandle_t convoy)
 {
 	halthandle_t tmp_halt;
 
@@ -2040,6 +2087,10 @@ void haltestelle_t::refresh_routing(const schedule_t *const sched, const minivec
 		for (uint8 i = 0; i < catg_count; i++)
 		{
 			path_explorer_t::refresh_category(categories[i]);
+			if (line.is_bound() || convoy.is_bound())
+			{
+				path_explorer_t::refresh_linkage(categories[i], line, convoy);
+			}
 		}
 
 		if ((passenger_classes != NULL) && categories.is_contained(goods_manager_t::INDEX_PAS))
@@ -2153,6 +2204,34 @@ void haltestelle_t::get_destination_halts_of_ware(ware_t &ware, vector_tpl<halth
 	}
 }
 
+void haltestelle_t::get_destination_times(const vector_tpl<halthandle_t>& destination_halts_list, const ware_t &ware, const koord destination_pos, vector_tpl<uint32> &times)
+{
+	// Called with a specific destination position (for passenger alternate-destination searches),
+	// otherwise the packet has a specific destination postition.
+	const koord real_destination_pos = destination_pos != koord::invalid ? destination_pos : ware.get_zielpos();
+	const bool is_freight = ware.is_freight();
+
+	times.clear();
+	FOR(vector_tpl<halthandle_t>, const destination_halt, destination_halts_list)
+	{
+		if (!destination_halt.is_bound())
+		{
+			times.append(0);
+			continue;
+		}
+
+		/**
+		* Finding the halt square closest to the real destination (closest exit)
+		* with get_next_pos() is far too computationally expensive. Use the standard halt location instead.
+		*/
+		const uint32 walk_distance = shortest_distance(destination_halt->get_init_pos(), real_destination_pos);
+
+		// Passengers or mail: walking time from destination stop to final destination.
+		// Freight: transshipment time based on a notional 1km/h dispersal speed.
+		times.append(is_freight ? welt->walk_haulage_time_tenths_from_distance(walk_distance) : welt->walking_time_tenths_from_distance(walk_distance));
+	}
+}
+
 uint32 haltestelle_t::find_route(const vector_tpl<halthandle_t>& destination_halts_list, ware_t &ware, const uint32 previous_journey_time, const koord destination_pos) const
 {
 	// ** Beware ** This is the one of the most computationally intensive (taking into account how often that it is called) functions in the game
@@ -2166,114 +2245,15 @@ uint32 haltestelle_t::find_route(const vector_tpl<halthandle_t>& destination_hal
 	//
 	// Authors: Knightly, James Petts, Nathanael Nerode (neroden)
 
-	uint32 best_journey_time = previous_journey_time;
-	halthandle_t best_destination_halt;
-	halthandle_t best_transfer;
-
- 	koord destination_stop_pos = destination_pos;
-
-	bool is_freight;
-	uint8 g_class;
-	uint8 ware_catg;
-
-
 	assert(ware.is_passenger() == (ware.get_desc()->get_catg_index() == goods_manager_t::INDEX_PAS));
 	assert(ware.is_mail() == (ware.get_desc()->get_catg_index() == goods_manager_t::INDEX_MAIL));
 
-	is_freight = ware.is_freight(); //Obvious
-    ware_catg = ware.get_desc()->get_catg_index(); //pax will always return 0 here; mail will always return 1 here
-    g_class = ware.g_class; //In case of freight always 0
-
-
-	bool found_a_halt = false;
-
-	uint32 test_time;
-	halthandle_t test_transfer;
-	koord real_destination_pos;
-
-	FOR(vector_tpl<halthandle_t>, destination_halt, destination_halts_list)
-	{
-		if (!destination_halt.is_bound() || self == destination_halt)
-		{
-			// Either this halt has been deleted recently, or the origin and destination are the same.
-			continue;
-		}
-
-		path_explorer_t::get_catg_path_between(ware_catg, self, destination_halt, test_time, test_transfer, g_class);
-
-		found_a_halt = true;
-
-		if(destination_pos != koord::invalid)
-		{
-			// Called with a specific destination position, not set by ware
-			// Done for passenger alternate-destination searches, I think?
-			real_destination_pos = destination_pos;
-		}
-		else
-		{
-			// Packet has a specific destination postition
-			// Done for real packets
-			real_destination_pos = ware.get_zielpos();
-		}
-
-		/**
-		* The below is far too computationally expensive. Find the standard halt location instead.
-		*
-		// Find the halt square closest to the real destination (closest exit)
-		destination_stop_pos = (*destination_halt)->get_next_pos(real_destination_pos);
-		*/
-
-		destination_stop_pos = (destination_halt)->get_init_pos();
-
-		// And find the shortest walking distance to there.
-		const uint32 walk_distance = shortest_distance(destination_stop_pos, real_destination_pos);
+	static thread_local vector_tpl<uint32> destination_times;
+	get_destination_times(destination_halts_list, ware, destination_pos, destination_times);
 
-		if (test_time < UINT32_MAX_VALUE)
-		{
-			// The above check is necessary or there will be an overflow causing spurious routes to be found.
-			if (!is_freight)
-			{
-				// Passengers or mail.
-				// Calculate walking time from destination stop to final destination; add it.
-				test_time += welt->walking_time_tenths_from_distance(walk_distance);
-			}
-			else
-			{
-				// Freight
-				// Calculate a transshipment time based on a notional 1km/h dispersal speed; add it.
-				test_time += welt->walk_haulage_time_tenths_from_distance(walk_distance);
-			}
-		}
-
-		if(test_time < best_journey_time)
-		{
-			// This is quicker than the last halt we tried.
-			best_destination_halt = destination_halt;
-			best_journey_time = test_time;
-			best_transfer = test_transfer;
-		}
-	}
-
-	if (self == best_destination_halt)
-	{
-		// There is no point in starting and finishing at the same stop.
-		found_a_halt = false;
-	}
-
-	if(!found_a_halt)
-	{
-		//no target station found
-		ware.set_ziel(halthandle_t());
-		ware.set_zwischenziel(halthandle_t());
-		return UINT32_MAX_VALUE;
-	}
-
-	if(best_journey_time < previous_journey_time)
-	{
-		ware.set_ziel(best_destination_halt);
-		ware.set_zwischenziel(best_transfer);
-	}
-	return best_journey_time;
+	path_explorer_t::route_t route;
+	path_explorer_t::get_catg_paths(ware.get_desc()->get_catg_index(), ware.g_class, &self, 1, destination_halts_list, destination_times, &route);
+	return route.apply_to(ware, previous_journey_time);
 }
 
 uint32 haltestelle_t::find_route(ware_t &ware, const uint32 previous_journey_time) const
@@ -2387,31 +2367,26 @@ void haltestelle_t::add_mail_no_route(int n)
 bool haltestelle_t::recall_ware( ware_t& w, uint32 menge )
 {
 	w.menge = 0;
-	vector_tpl<ware_t> *warray = cargo[w.get_desc()->get_catg_index()];
+	halt_cargo_t *warray = cargo[w.get_desc()->get_catg_index()];
 	if(warray!=NULL) {
-		FOR(vector_tpl<ware_t>, & tmp, *warray) {
-			// skip empty entries
-			if(tmp.menge==0  ||  w.get_index()!=tmp.get_index()  ||  w.get_zielpos()!=tmp.get_zielpos()) {
-				continue;
-			}
+		FOR(vector_tpl<halt_cargo_t::bucket_t *>, const bucket, warray->get_buckets()) {
+			FOR(vector_tpl<ware_t>, & tmp, bucket->wares) {
+				// skip empty entries
+				if(tmp.menge==0  ||  w.get_index()!=tmp.get_index()  ||  w.get_zielpos()!=tmp.get_zielpos()) {
+					continue;
+				}
 
-			// not too much?
-			if(tmp.menge > menge) {
-				// not all can be loaded
-				tmp.menge -= menge;
-				w.menge = menge;
-			}
-			else {
+				// not too much?
 				// leave an empty entry => joining will more often work
-				w.menge = tmp.menge;
-				tmp.menge = 0;
-			}
-			assert( (!w.is_passenger() && !w.is_mail()) );
-			book(w.menge*w.get_desc()->get_weight_per_unit()/10, HALT_GOODS_HANDLING_VOLUME);
+				w.menge = min(tmp.menge, menge);
+				warray->take(tmp, w.menge);
+				assert( (!w.is_passenger() && !w.is_mail()) );
+				book(w.menge*w.get_desc()->get_weight_per_unit()/10, HALT_GOODS_HANDLING_VOLUME);
 
-			fabrik_t::update_transit( w, false );
-			resort_freight_info = true;
-			return true;
+				fabrik_t::update_transit( w, false );
+				resort_freight_info = true;
+				return true;
+			}
 		}
 	}
 	// nothing to take out
@@ -2423,35 +2398,56 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 {
 	bool skipped = false;
 	const uint8 catg_index = good_category->get_catg_index();
-	vector_tpl<ware_t> *warray = cargo[catg_index];
-	if(warray && warray->get_count() > 0)
+	halt_cargo_t *warray = cargo[catg_index];
+	if(warray && !warray->empty())
 	{
+		// Only packets whose next transfer or destination is served by this schedule can be loaded,
+		// so only the buckets of these stops need to be looked at.
+		vector_tpl<halthandle_t> schedule_halts(schedule->get_count());
+		uint64 schedule_ziel_mask = 0;
+		for(uint8 i = 0; i < schedule->get_count(); i++)
+		{
+			const halthandle_t halt = haltestelle_t::get_halt(schedule->entries[i].pos, player);
+			if(halt.is_bound() && halt != self)
+			{
+				schedule_halts.append_unique(halt);
+				schedule_ziel_mask |= halt_cargo_t::get_ziel_bit(halt);
+			}
+		}
+
 		binary_heap_tpl<ware_t*> goods_to_check;
-		for(uint32 i = 0;  i < warray->get_count();  )
+		vector_tpl<halt_cargo_t::bucket_t *> checked_buckets;
+		FOR(vector_tpl<halt_cargo_t::bucket_t *>, const bucket, warray->get_buckets())
 		{
+			if(bucket->sum == 0)
+			{
+				continue;
+			}
+			if(bucket->g_class < g_class)
+			{
+				// We know at this stage that we cannot load passengers of a *lower* class into higher class accommodation,
+				// but we cannot yet know whether or not to load passengers of a higher class into lower class accommodation.
+				// Note that this method is called for each class of accommodation in each vehicle in each convoy.
+				other_classes_available = true;
+				continue;
+			}
+
+			const bool served_transfer = schedule_halts.is_contained(bucket->via);
+			if(!served_transfer && (bucket->ziel_mask & schedule_ziel_mask) == 0)
+			{
+				continue;
+			}
+
 			// Load first the goods/passengers/mail that have been waiting the longest.
 			// Do this by adding them all to a binary heap sorted by arrival time.
-			ware_t* const ware = &(*warray)[i];
-			if(ware->menge > 0)
+			FOR(vector_tpl<ware_t>, & ware, bucket->wares)
 			{
-				i++;
-				if (ware->get_class() >= g_class)
-				{
-					// We know at this stage that we cannot load passengers of a *lower* class into higher class accommodation,
-					// but we cannot yet know whether or not to load passengers of a higher class into lower class accommodation.
-					// Note that this method is called for each class of accommodation in each vehicle in each convoy.
-					goods_to_check.insert(ware);
-				}
-				else
+				if(ware.menge > 0 && (served_transfer || schedule_halts.is_contained(ware.get_ziel())))
 				{
-					other_classes_available = true;
+					goods_to_check.insert(&ware);
 				}
 			}
-			else
-			{
-				// There is no need any longer to have empty ware packets hanging around.
-				warray->remove_at(i, false);
-			}
+			checked_buckets.append(bucket);
 		}
 
 		halthandle_t cached_halts[256];
@@ -2681,7 +2677,7 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 					{
 						// The direct route is faster than the planned route:
 						// update the next transfer to reflect this.
-						next_to_load->set_zwischenziel(destination);
+						warray->set_via(*next_to_load, destination);
 					}
 
 					if (next_to_load->is_passenger() && next_to_load->g_class > 0 && cnv->get_classes_carried(goods_manager_t::INDEX_PAS)->get_count() > 1)
@@ -2752,13 +2748,13 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 					{
 						// not all can be loaded
 						neu.menge = requested_amount;
-						next_to_load->menge -= requested_amount;
+						warray->take(*next_to_load, requested_amount);
 						requested_amount = 0;
 					}
 					else
 					{
 						requested_amount -= next_to_load->menge;
-						next_to_load->menge = 0; // leave an empty entry => will be deleted next time for performance
+						warray->take(*next_to_load, next_to_load->menge); // leave an empty entry => will be deleted below
 					}
 					load.insert(neu);
 
@@ -2801,6 +2797,12 @@ bool haltestelle_t::fetch_goods(slist_tpl<ware_t> &load, const goods_desc_t *goo
 				schedule->increment_index(&index, &reverse);
 			}
 		}
+
+		// There is no need any longer to have empty ware packets hanging around.
+		FOR(vector_tpl<halt_cargo_t::bucket_t *>, const bucket, checked_buckets)
+		{
+			warray->tidy(bucket);
+		}
 	}
 	return skipped;
 }
@@ -2903,13 +2905,12 @@ sint64 haltestelle_t::get_overcrowded_proporion(uint8 typ) const
 
 uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp) const
 {
-	int sum = 0;
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
+	uint32 sum = 0;
+	const halt_cargo_t * warray = cargo[wtyp->get_catg_index()];
 	if(warray!=NULL) {
-		FOR(vector_tpl<ware_t>, const& i, *warray) {
-			if (wtyp->get_index() == i.get_index()) {
-				sum += i.menge;
-			}
+		const uint8 classes = max(wtyp->get_number_of_classes(), (uint8)1);
+		for(uint8 i = 0; i < classes; i++) {
+			sum += warray->get_sum(wtyp->get_index(), i);
 		}
 	}
 	return sum;
@@ -2920,17 +2921,14 @@ uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp, uint8 g_class, bo
 	if (g_class >= wtyp->get_number_of_classes()) {
 		return 0;
 	}
-	int sum = 0;
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
-	if (warray != NULL) {
-		FOR(vector_tpl<ware_t>, const& i, *warray) {
-			if (wtyp->get_index() == i.get_index() && g_class == i.get_class()
-				&& (!chk_only_commuter || (chk_only_commuter && wtyp == goods_manager_t::passengers && i.is_commuting_trip))) {
-				sum += i.menge;
-			}
-		}
+	const halt_cargo_t * warray = cargo[wtyp->get_catg_index()];
+	if (warray == NULL) {
+		return 0;
 	}
-	return sum;
+	if (chk_only_commuter) {
+		return wtyp == goods_manager_t::passengers ? warray->get_commuter_sum(wtyp->get_index(), g_class) : 0;
+	}
+	return warray->get_sum(wtyp->get_index(), g_class);
 }
 
 uint32 haltestelle_t::get_transferring_goods_sum(const goods_desc_t *wtyp, uint8 g_class) const
@@ -2989,11 +2987,13 @@ uint32 haltestelle_t::get_leaving_goods_sum(const goods_desc_t *wtyp, uint8 g_cl
 
 uint32 haltestelle_t::get_ware_fuer_zielpos(const goods_desc_t *wtyp, const koord zielpos) const
 {
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
+	const halt_cargo_t * warray = cargo[wtyp->get_catg_index()];
 	if(warray!=NULL) {
-		FOR(vector_tpl<ware_t>, const& ware, *warray) {
-			if(wtyp->get_index()==ware.get_index()  &&  ware.get_zielpos()==zielpos) {
-				return ware.menge;
+		FOR(vector_tpl<halt_cargo_t::bucket_t *>, const bucket, warray->get_buckets()) {
+			FOR(vector_tpl<ware_t>, const& ware, bucket->wares) {
+				if(wtyp->get_index()==ware.get_index()  &&  ware.get_zielpos()==zielpos) {
+					return ware.menge;
+				}
 			}
 		}
 	}
@@ -3005,10 +3005,11 @@ bool haltestelle_t::vereinige_waren(const ware_t &ware) //"unite were" (Google)
 {
 	// pruefen ob die ware mit bereits wartender ware vereinigt werden kann
 	// "examine whether the ware with software already waiting to be united" (Google)
-	vector_tpl<ware_t> * warray = cargo[ware.get_desc()->get_catg_index()];
-	if(warray != NULL)
+	halt_cargo_t * warray = cargo[ware.get_desc()->get_catg_index()];
+	halt_cargo_t::bucket_t * bucket = warray ? warray->get_bucket(ware.get_zwischenziel(), ware.get_class()) : NULL;
+	if(bucket != NULL)
 	{
-		FOR(vector_tpl<ware_t>, & tmp, *warray)
+		FOR(vector_tpl<ware_t>, & tmp, bucket->wares)
 		{
 
 			/*
@@ -3029,20 +3030,20 @@ bool haltestelle_t::vereinige_waren(const ware_t &ware) //"unite were" (Google)
 			// @author: jamespetts
 			if(ware.can_merge_with(tmp))
 			{
-				if(  ware.get_zwischenziel().is_bound()  &&  ware.get_zwischenziel()!=self  )
-				{
-					// update route if there is newer route
-					tmp.set_zwischenziel( ware.get_zwischenziel() );
-				}
+				// the next transfer is the same, as it is the same bucket
+				ware_t merged = tmp;
 
 				// Merge waiting times.
 				if(ware.menge > 0)
 				{
 					//The waiting time for ware will always be zero.
-					tmp.arrival_time = welt->get_ticks() - ((welt->get_ticks() - tmp.arrival_time) * tmp.menge) / (tmp.menge + ware.menge);
+					merged.arrival_time = welt->get_ticks() - ((welt->get_ticks() - tmp.arrival_time) * tmp.menge) / (tmp.menge + ware.menge);
 				}
 
-				tmp.menge += ware.menge;
+				merged.menge += ware.menge;
+				// reuses the emptied entry or another empty one of the bucket
+				warray->take(tmp, tmp.menge);
+				warray->add(merged, true);
 				resort_freight_info = true;
 				return true;
 			}
@@ -3066,26 +3067,16 @@ void haltestelle_t::add_ware_to_halt(ware_t ware, bool from_saved)
 	ware.set_last_transfer(self);
 
 	// now we have to add the ware to the stop
-	vector_tpl<ware_t> * warray = cargo[ware.get_desc()->get_catg_index()];
+	halt_cargo_t * warray = cargo[ware.get_desc()->get_catg_index()];
 	if(warray==NULL)
 	{
 		// this type was not stored here before ...
-		warray = new vector_tpl<ware_t>(4);
+		warray = new halt_cargo_t();
 		cargo[ware.get_desc()->get_catg_index()] = warray;
 	}
 	resort_freight_info = true;
-	if(!from_saved)
-	{
-		// the ware will be put into the first entry with menge==0
-		FOR(vector_tpl<ware_t>, & i, *warray) {
-			if (i.menge == 0) {
-				i = ware;
-				return;
-			}
-		}
-		// here, if no free entries found
-	}
-	warray->append(ware);
+	// the ware will be put into the first entry of its bucket with menge==0
+	warray->add(ware, !from_saved);
 }
 
 void haltestelle_t::add_to_waiting_list(ware_t ware, sint64 ready_time)
@@ -3439,10 +3430,11 @@ void haltestelle_t::get_freight_info(cbuffer_t & buf)
 
 		for (unsigned i = 0; i < goods_manager_t::get_max_catg_index(); i++)
 		{
-			const vector_tpl<ware_t> * warray = cargo[i];
-			if (warray)
+			if (cargo[i])
 			{
-				freight_list_sorter_t::sort_freight(*warray, buf, (freight_list_sorter_t::sort_mode_t)sortierung, NULL, "waiting", 0, 0, NULL);
+				vector_tpl<ware_t> warray(cargo[i]->get_count());
+				cargo[i]->get_all(warray);
+				freight_list_sorter_t::sort_freight(warray, buf, (freight_list_sorter_t::sort_mode_t)sortierung, NULL, "waiting", 0, 0, NULL);
 			}
 		}
 
@@ -3709,9 +3701,10 @@ void haltestelle_t::transfer_goods(halthandle_t halt)
 	}
 	// transfer goods to halt
 	for(uint8 i=0; i<goods_manager_t::get_max_catg_index(); i++) {
-		const vector_tpl<ware_t> * warray = cargo[i];
-		if (warray) {
-			FOR(vector_tpl<ware_t>, const& j, *warray) {
+		if (cargo[i]) {
+			vector_tpl<ware_t> warray(cargo[i]->get_count());
+			cargo[i]->get_all(warray);
+			FOR(vector_tpl<ware_t>, const& j, warray) {
 				halt->add_ware_to_halt(j);
 			}
 			delete cargo[i];
@@ -3988,7 +3981,7 @@ void haltestelle_t::rdwr(loadsave_t *file)
 		const char *s;
 		for(unsigned i=0; i<max_catg_count_file; i++)
 		{
-			vector_tpl<ware_t> *warray = cargo[i];
+			halt_cargo_t *warray = cargo[i];
 			uint32 ware_count = 1;
 
 			if(warray) {
@@ -4013,17 +4006,20 @@ void haltestelle_t::rdwr(loadsave_t *file)
 					file->rdwr_long(count);
 					has_uint16_count = false;
 				}
-				FOR(vector_tpl<ware_t>, & ware, *warray)
+				FOR(vector_tpl<halt_cargo_t::bucket_t *>, const bucket, warray->get_buckets())
 				{
-					if(has_uint16_count && ware_count++ > 65535)
+					FOR(vector_tpl<ware_t>, & ware, bucket->wares)
 					{
-						// Discard ware packets > 65535 if the version is < 11, as trying
-						// to save greater than this number will corrupt the save.
-						ware.menge = 0;
-					}
-					else
-					{
-						ware.rdwr(file);
+						if(has_uint16_count && ware_count++ > 65535)
+						{
+							// Discard ware packets > 65535 if the version is < 11, as trying
+							// to save greater than this number will corrupt the save.
+							warray->take(ware, ware.menge);
+						}
+						else
+						{
+							ware.rdwr(file);
+						}
 					}
 				}
 			}
@@ -4744,6 +4740,7 @@ void haltestelle_t::rdwr(loadsave_t *file)
 	// clear it here.
 
 	service_frequencies.clear();
+	service_frequencies_outdated = true;
 
 	// So compute it fresh every time
 	calc_transfer_time();
@@ -4759,30 +4756,48 @@ void haltestelle_t::finish_rd(bool need_recheck_for_walking_distance)
 	{
 		if(cargo[i])
 		{
-			vector_tpl<ware_t> * warray = cargo[i];
-			FOR(vector_tpl<ware_t>, & j, *warray)
+			halt_cargo_t * warray = cargo[i];
+			FOR(vector_tpl<halt_cargo_t::bucket_t *>, const bucket, warray->get_buckets())
 			{
-				j.finish_rd(welt);
+				FOR(vector_tpl<ware_t>, & j, bucket->wares)
+				{
+					j.finish_rd(welt);
+				}
 			}
+			// the next transfers may have changed
+			warray->rebuild();
+
 			// merge identical entries (should only happen with old games)
-			const uint32 count = warray->get_count();
-			for(uint32 j = 0; j < count; ++j)
+			// only packets in the same bucket can be merged
+			bool merged = false;
+			FOR(vector_tpl<halt_cargo_t::bucket_t *>, const bucket, warray->get_buckets())
 			{
-				ware_t& warj = (*warray)[j];
-				if(warj.menge == 0)
+				vector_tpl<ware_t> &wares = bucket->wares;
+				const uint32 count = wares.get_count();
+				for(uint32 j = 0; j < count; ++j)
 				{
-					continue;
-				}
-				for(uint32 k = j + 1; k < count; ++k)
-				{
-					ware_t& wark = (*warray)[k];
-					if(wark.menge > 0 && warj.can_merge_with(wark))
+					ware_t& warj = wares[j];
+					if(warj.menge == 0)
 					{
-						warj.menge += wark.menge;
-						wark.menge = 0;
+						continue;
+					}
+					for(uint32 k = j + 1; k < count; ++k)
+					{
+						ware_t& wark = wares[k];
+						if(wark.menge > 0 && warj.can_merge_with(wark))
+						{
+							warj.menge += wark.menge;
+							wark.menge = 0;
+							merged = true;
+						}
 					}
 				}
 			}
+			if(merged)
+			{
+				// commuters may have been merged with other passengers
+				warray->rebuild();
+			}
 		}
 	}
 
@@ -5343,6 +5358,7 @@ bool haltestelle_t::add_grund(grund_t *gr, bool relink_factories, bool recalc_ne
 	add_to_station_type( gr );
 	gr->set_halt( self );
 	tiles.append( gr );
+	weg_t::network_changed();
 
 	// add to hashtable
 	if (all_koords) {
@@ -5487,6 +5503,7 @@ bool haltestelle_t::rem_grund(grund_t *gr)
 	}
 
 	station_signals.remove(gr->get_pos());
+	weg_t::network_changed();
 
 	slist_tpl<tile_t>::iterator i = std::find(tiles.begin(), tiles.end(), gr);
 	if (i == tiles.end()) {
@@ -6445,11 +6462,7 @@ void haltestelle_t::clear_estimated_timings(uint16 convoy_id)
 void haltestelle_t::add_line(linehandle_t line)
 {
 	registered_lines.append_unique(line);
-#ifdef ALWAYS_CACHE_SERVICE_INTERVAL
-	clear_service_intervals(line->get_schedule());
-#else
-	update_service_intervals(line->get_schedule());
-#endif
+	service_frequencies_outdated = true;
 }
 void haltestelle_t::remove_line(linehandle_t line)
 {
@@ -6465,17 +6478,12 @@ void haltestelle_t::remove_line(linehandle_t line)
 			}
 		}
 	}
-	update_service_intervals(line->get_schedule());
+	service_frequencies_outdated = true;
 }
 
 void haltestelle_t::add_convoy(convoihandle_t convoy)
 {
 	registered_convoys.append_unique(convoy);
-#ifdef ALWAYS_CACHE_SERVICE_INTERVAL
-	clear_service_intervals(convoy->get_schedule());
-#else
-	update_service_intervals(convoy->get_schedule());
-#endif
 }
 
 void haltestelle_t::remove_convoy(convoihandle_t convoy)
@@ -6492,54 +6500,8 @@ void haltestelle_t::remove_convoy(convoihandle_t convoy)
 			}
 		}
 	}
-	if (!welt->is_destroying())
-	{
-		update_service_intervals(convoy->get_schedule());
-	}
 }
 
-void haltestelle_t::update_service_intervals(schedule_t* sch)
-{
-	halthandle_t halt;
-	for (uint8 i = 0; i < sch->get_count(); i++)
-	{
-		halt = haltestelle_t::get_halt(sch->entries[i].pos, world()->get_public_player());
-		if (halt.is_bound())
-		{
-			service_frequency_specifier spec;
-			spec.y = halt.get_id();
-			uint32 freq;
-			for(uint8 c = 0; c < goods_manager_t::get_max_catg_index(); c ++)
-			{
-				freq = calc_service_frequency(halt, c);
-				spec.x = c;
-				service_frequencies.set(spec, freq);
-			}
-		}
-	}
-}
-
-#ifdef ALWAYS_CACHE_SERVICE_INTERVAL
-void haltestelle_t::clear_service_intervals(schedule_t* sch)
-{
-	halthandle_t halt;
-	for (uint8 i = 0; i < sch->get_count(); i++)
-	{
-		halt = haltestelle_t::get_halt(sch->entries[i].pos, world()->get_public_player());
-		if (halt.is_bound())
-		{
-			service_frequency_specifier spec;
-			spec.y = halt.get_id();
-			for (uint8 c = 0; c < goods_manager_t::get_max_catg_index(); c++)
-			{
-				spec.x = c;
-				service_frequencies.remove(spec);
-			}
-		}
-	}
-}
-#endif
-
 sint64 haltestelle_t::calc_earliest_arrival_time_at(halthandle_t halt, convoihandle_t &convoy, uint8 catg_index, uint8 g_class) const
 {
 	const arrival_times_map& next_transfer_arrivals = halt->get_estimated_convoy_arrival_times();
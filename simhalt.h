@@ -11,6 +11,7 @@
 #include "linehandle_t.h"
 #include "halthandle_t.h"
 #include "simware.h"
+#include "halt_cargo.h"
 
 #include "obj/simobj.h"
 #include "display/simgraph.h"
@@ -391,7 +392,7 @@ private:
 	vector_tpl<uint8> non_identical_schedules;
 
 	// Array with different categories that contains all waiting goods at this stop
-	vector_tpl<ware_t> **cargo;
+	halt_cargo_t **cargo;
 
 	/**
 	 * Liste der angeschlossenen Fabriken
@@ -476,8 +477,13 @@ private:
 	// Store the service frequencies to all other halts so that this does not need to be
 	// recalculated frequently. These are used as proxies for waiting times when no
 	// recent (or any) waiting time data are available.
+	// All stops served by the registered lines are in here after calc_service_frequencies(),
+	// so a missing entry means that there is no service.
 	koordhashtable_tpl<service_frequency_specifier, uint32, N_BAGS_SMALL> service_frequencies;
 
+	// The registered lines or their convoys have changed since calc_service_frequencies()
+	bool service_frequencies_outdated;
+
 	static const sint64 waiting_multiplication_factor = 3ll;
 	static const sint64 waiting_tolerance_ratio = 50ll;
 
@@ -602,6 +608,10 @@ public:
 	void get_destination_halts_of_ware(ware_t &ware, vector_tpl<halthandle_t>& destination_halts_list) const;
 	uint32 find_route(const vector_tpl<halthandle_t>& ziel_list, ware_t & ware, const uint32 journey_time = UINT32_MAX_VALUE, const koord destination_pos = koord::invalid) const;
 
+	// Times from each destination halt to the final destination of the ware (or destination_pos, if valid):
+	// walking for passengers and mail, haulage for freight. For path_explorer_t::get_catg_paths().
+	static void get_destination_times(const vector_tpl<halthandle_t>& destination_halts_list, const ware_t &ware, const koord destination_pos, vector_tpl<uint32> &times);
+
 	inline bool get_pax_enabled()  const { return enables & PAX;  }
 	inline bool get_mail_enabled() const { return enables & POST; }
 	inline bool get_ware_enabled() const { return enables & WARE; }
@@ -845,16 +855,15 @@ public:
 	 */
 	vector_tpl<convoihandle_t> registered_convoys;
 
-	// Update and recalculate the cached service intervals
-	void update_service_intervals(schedule_t* sch);
+	/**
+	 * The interval between calls of the convoys of this line at this stop
+	 * in 10ths of minutes, or 0 if it has no convoys.
+	 * @param[out] served_halts the stops of the line are appended, once each
+	 */
+	uint32 calc_service_interval(linehandle_t line, vector_tpl<halthandle_t> &served_halts) const;
 
-#ifdef ALWAYS_CACHE_SERVICE_INTERVAL
-	// This is a selective clear of the service intervals:
-	// this will clear the service intervals to stops
-	// on this schedule only. To clear all service intervals,
-	// run service_intervals.clear().
-	void clear_service_intervals(schedule_t* sch);
-#endif
+	/// @return the service frequency of two services with these frequencies together
+	static uint32 combine_service_frequencies(uint32 service_frequency, uint32 timing);
 
 	/**
 	 * It will calculate number of free seats in all other (not cnv) convoys at stop
@@ -922,8 +931,10 @@ public:
 	// Adapted from : Jamespetts' code
 	// Purpose		: To notify relevant halts to rebuild connexions and to notify all halts to recalculate paths
 	// @jamespetts: modified the code to combine with previous method and provide options about partially delayed refreshes for performance.
+	// If the line or lineless convoy operating the schedule is given, its connexions are also patched into the existing paths straight away.
 
-	static void refresh_routing(const schedule_t *const sched, const minivec_tpl<uint8> &categories, const minivec_tpl<uint8> *passenger_classes, const minivec_tpl<uint8> *mail_classes, const player_t *const player);
+	static void refresh_routing(const schedule_t *const sched, const minivec_tpl<uint8> &categories, const minivec_tpl<uint8> *passenger_classes, const minivec_tpl<uint8> *mail_classes, const player_t *const player,
+								linehandle_t line = linehandle_t(), convoihandle_t convoy = convoihandle_t());
 
 	// Added by		: Knightly
 	// Adapted from : haltestelle_t::add_connexion()
@@ -933,7 +944,7 @@ public:
 		if (cargo[category] == NULL )
 		{
 			// indicates that this can route those goods
-			cargo[category] = new vector_tpl<ware_t>(0);
+			cargo[category] = new halt_cargo_t();
 		}
 	}
 
@@ -988,6 +999,18 @@ public:
 
 	uint32 calc_service_frequency(halthandle_t destination, uint8 category) const;
 
+	/**
+	* Calculates the service frequencies to all stops served by the registered lines
+	* in one pass over their schedules.
+	*/
+	void calc_service_frequencies();
+
+	/**
+	* The registered lines, their schedules or their convoys have changed:
+	* the service frequencies are recalculated in the next step.
+	*/
+	void set_service_frequencies_outdated() { service_frequencies_outdated = true; }
+
 	void set_estimated_arrival_time(uint16 convoy_id, sint64 time);
 	void set_estimated_departure_time(uint16 convoy_id, sint64 time);
 
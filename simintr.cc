@@ -17,6 +17,7 @@
 
 #include "simworld.h"
 #include "display/simview.h"
+#include "display/simgraph.h"
 
 #include "boden/wasser.h"
 
@@ -75,6 +76,8 @@ void intr_refresh_display(bool dirty)
 {
 	wasser_t::prepare_for_refresh();
 	dr_prepare_flush();
+	// no drawing until main_view->display()
+	display_trim_image_cache();
 	main_view->display( dirty );
 	if(  env_t::player_finance_display_account  ) {
 		win_display_flush( (double)world()->get_active_player()->get_finance()->get_account_balance()/100.0 );
@@ -188,7 +188,7 @@ void simline_t::set_schedule(schedule_t* schedule)
 {
 	if (this->schedule)
 	{
-		haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, player);
+		haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, player, self);
 		unregister_stops();
 		delete this->schedule;
 	}
@@ -251,6 +251,7 @@ void simline_t::add_convoy(convoihandle_t cnv, bool from_loading)
 	}
 	// only add convoy if not already member of line
 	line_managed_convoys.append_unique(cnv);
+	update_stops_service_frequencies();
 
 	// what goods can this line transport?
 	bool update_schedules = false;
@@ -296,7 +297,7 @@ void simline_t::add_convoy(convoihandle_t cnv, bool from_loading)
 	if(  update_schedules  )
 	{
 		// Added by : Knightly
-		haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, player);
+		haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, player, self);
 	}
 
 	// if the schedule is flagged as bidirectional, set the initial convoy direction
@@ -312,6 +313,7 @@ void simline_t::remove_convoy(convoihandle_t cnv)
 {
 	if(line_managed_convoys.is_contained(cnv) && !welt->is_destroying()) {
 		line_managed_convoys.remove(cnv);
+		update_stops_service_frequencies();
 		recalc_catg_index();
 		financial_history[0][LINE_CONVOIS] = count_convoys();
 		recalc_status();
@@ -688,6 +690,17 @@ void simline_t::unregister_stops(schedule_t * schedule)
 }
 
 
+void simline_t::update_stops_service_frequencies()
+{
+	FOR(minivec_tpl<schedule_entry_t>, const& i, schedule->entries) {
+		halthandle_t const halt = haltestelle_t::get_halt(i.pos, player);
+		if(halt.is_bound()) {
+			halt->set_service_frequencies_outdated();
+		}
+	}
+}
+
+
 void simline_t::renew_stops()
 {
 	if (!line_managed_convoys.empty())
@@ -695,7 +708,7 @@ void simline_t::renew_stops()
 		register_stops( schedule );
 
 		// Added by Knightly
-		haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, player);
+		haltestelle_t::refresh_routing(schedule, goods_catg_index, NULL, NULL, player, self);
 
 		DBG_DEBUG("simline_t::renew_stops()", "Line id=%d, name='%s'", self.get_id(), name.c_str());
 	}
@@ -1078,7 +1091,7 @@ void simline_t::recalc_catg_index()
 	}
 
 	// refresh only those categories which are either removed or added to the category list
-	haltestelle_t::refresh_routing(schedule, catg_differences, &passenger_class_differences, &mail_class_differences, player);
+	haltestelle_t::refresh_routing(schedule, catg_differences, &passenger_class_differences, &mail_class_differences, player, self);
 }
 
 bool simline_t::carries_this_or_lower_class(uint8 catg, uint8 g_class)
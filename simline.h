@@ -257,6 +257,11 @@ public:
 	void unregister_stops(schedule_t * schedule);
 	void unregister_stops();
 
+	/*
+	 * the interval between the convoys at the stops has changed
+	 */
+	void update_stops_service_frequencies();
+
 	/*
 	 * renew line registration for stops
 	 */
@@ -7,6 +7,10 @@
 #include <string>
 #include <new>
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 #include "pathes.h"
 
 #include "simmain.h"
@@ -72,6 +76,8 @@
 #include "sound/sound.h"
 
 #include "utils/cbuffer_t.h"
+#include "utils/csv.h"
+#include "utils/simprofiler.h"
 #include "utils/simrandom.h"
 
 #include "bauer/vehikelbauer.h"
@@ -81,6 +87,70 @@
 
 using std::string;
 
+/**
+ * Runs the loaded world for a number of months as fast as possible, without
+ * drawing, and prints the results as comma separated values to stdout:
+ * first key,value lines, then the phase timings from profiler_t.
+ */
+static void run_benchmark(karte_t *welt, uint32 months)
+{
+	intr_disable();
+	welt->set_fast_forward(true);
+	profiler_t::reset();
+
+	// a benchmark must not write savegames
+	const sint32 old_autosave = env_t::autosave;
+	env_t::autosave = 0;
+
+	const uint32 quit_month = welt->get_current_month() + months;
+	const sint64 start_ticks = welt->get_ticks();
+	const sint32 start_steps = welt->get_steps();
+	const uint64 start_time = profiler_t::get_time_us();
+
+	dbg->message( "run_benchmark()", "running %u months with %d threads", months, env_t::num_threads );
+
+	while(  welt->get_current_month() < quit_month  &&  !env_t::quit_simutrans  ) {
+		// same as fast forward in karte_t::interactive()
+		welt->sync_step( 100, true, false );
+		set_random_mode( STEP_RANDOM );
+		welt->step();
+		clear_random_mode( STEP_RANDOM );
+	}
+
+	const double seconds = (profiler_t::get_time_us() - start_time) / 1000000.0;
+	const sint64 ticks = welt->get_ticks() - start_ticks;
+
+	long peak_rss_kb = 0;
+#ifndef _WIN32
+	struct rusage usage;
+	if(  getrusage( RUSAGE_SELF, &usage ) == 0  ) {
+#ifdef __APPLE__
+		peak_rss_kb = usage.ru_maxrss / 1024; // bytes on MacOS
+#else
+		peak_rss_kb = usage.ru_maxrss;
+#endif
+	}
+#endif
+
+	printf( "months,%u\n", months );
+	printf( "threads,%d\n", env_t::num_threads );
+	printf( "steps,%d\n", welt->get_steps() - start_steps );
+	printf( "ticks,%lld\n", (long long)ticks );
+	printf( "seconds,%.3f\n", seconds );
+	printf( "ticks_per_second,%.1f\n", seconds > 0.0 ? ticks / seconds : 0.0 );
+	printf( "peak_rss_kb,%ld\n", peak_rss_kb );
+	printf( "gamestate_hash,%08x\n", welt->get_gamestate_hash() );
+	printf( "\n" );
+
+	CSV_t csv;
+	profiler_t::write_csv( csv );
+	printf( "%s", csv.get_str() );
+	fflush( stdout );
+
+	env_t::autosave = old_autosave;
+}
+
+
 #if defined DEBUG || defined PROFILE
 /* diagnostic routine:
  * show the size of several internal structures
@@ -450,6 +520,8 @@ void print_help()
 		"command line parameters available: \n"
 		" -addons             loads also addons (with -objects)\n"
 		" -async              asynchronous images, only for SDL\n"
+		" -benchmark NAME     loads savegame 'NAME', runs it without drawing and sound\n"
+		"                     for -months N months (default 1), prints the timings and quits\n"
 		" -borderless         emulate fullscreen as borderless window\n"
 		" -use_hw             hardware double buffering, only for SDL\n"
 		" -debug NUM          enables debugging (1..5)\n"
@@ -1197,7 +1269,7 @@ int simu_main(int argc, char** argv)
 #endif
 
 	// just check before loading objects
-	if(  !args.has_arg("-nosound")  &&  dr_init_sound()  ) {
+	if(  !args.has_arg("-nosound")  &&  !args.has_arg("-benchmark")  &&  dr_init_sound()  ) {
 		dbg->message("simu_main()","Reading compatibility sound data ...");
 		sound_desc_t::init();
 	}
@@ -1348,13 +1420,13 @@ int simu_main(int argc, char** argv)
 		env_t::server_runs_background_tasks_when_paused = true;
 	}
 
-	if(  args.has_arg("-load")  ) {
+	if(  args.has_arg("-load")  ||  args.has_arg("-benchmark")  ) {
 		cbuffer_t buf;
 		dr_chdir( env_t::user_dir );
 		/**
 		 * Added automatic adding of extension
 		 */
-		const char *name = args.gimme_arg("-load", 1);
+		const char *name = args.has_arg("-benchmark") ? args.gimme_arg("-benchmark", 1) : args.gimme_arg("-load", 1);
 		if (strstart(name, "net:")) {
 			buf.append( name );
 		}
@@ -1479,7 +1551,7 @@ int simu_main(int argc, char** argv)
 		midi_set_mute(true);
 	}
 
-	if(  args.has_arg("-mute")  ) {
+	if(  args.has_arg("-mute")  ||  args.has_arg("-benchmark")  ) {
 		sound_set_mute(true);
 		midi_set_mute(true);
 	}
@@ -1552,6 +1624,10 @@ int simu_main(int argc, char** argv)
 	clear_random_mode( 7 ); // allow all
 
 	if(  loadgame==""  ||  !welt->load(loadgame.c_str())  ) {
+		if(  args.has_arg("-benchmark")  ) {
+			dbg->fatal("simu_main()", "Cannot load savegame \"%s\" for benchmark", loadgame.c_str() );
+		}
+
 		// create a default map
 		DBG_MESSAGE("simu_main()", "Init with default map (failing will be a pak error!)");
 
@@ -1606,6 +1682,12 @@ int simu_main(int argc, char** argv)
 
 	uint32 quit_month = 0x7FFFFFFFu;
 
+	if(  args.has_arg("-benchmark")  ) {
+		const char *months = args.gimme_arg("-months", 1);
+		run_benchmark( welt, months ? max(1, atoi(months)) : 1 );
+		env_t::quit_simutrans = true;
+	}
+
 #if defined DEBUG || defined PROFILE
 	// do a render test?
 	if (args.has_arg("-times")) {
@@ -189,6 +189,7 @@ enum {
 	DIALOG_TOOL_STANDARD_COUNT,
 	// Extended entries from here:
 	DIALOG_LIST_SIGNALBOX =0x0080,
+	DIALOG_PROFILER,
 	DIALOG_TOOL_COUNT,
 	DIALOG_TOOL = 0x4000
 };
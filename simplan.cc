@@ -33,6 +33,8 @@
 
 karte_ptr_t planquadrat_t::welt;
 
+uint32 planquadrat_t::haltlist_generation = 0;
+
 
 void swap(planquadrat_t& a, planquadrat_t& b)
 {
@@ -68,6 +70,9 @@ planquadrat_t::~planquadrat_t()
 		delete [] data.some;
 	}
 	delete [] halt_list;
+	if(  halt_list_count > 0  ) {
+		haltlist_generation++;
+	}
 	halt_list_count = 0;
 	// to avoid access to this tile
 	ground_size = 0;
@@ -763,6 +768,7 @@ void planquadrat_t::halt_list_remove( halthandle_t halt )
 				halt_list[j-1] = halt_list[j];
 			}
 			halt_list_count--;
+			halt_list_changed();
 			break;
 		}
 	}
@@ -790,6 +796,19 @@ void planquadrat_t::halt_list_insert_at(halthandle_t halt, uint8 pos, uint8 dist
 	halt_list[pos].halt = halt;
 	halt_list[pos].distance = distance;
 	halt_list_count ++;
+	halt_list_changed();
+}
+
+
+void planquadrat_t::halt_list_changed()
+{
+	haltlist_generation++;
+	// only the buildings on this tile need to collect their nearby halts anew
+	for(  uint8 i=0;  i<ground_size;  i++  ) {
+		if(  gebaeude_t *gb = get_boden_bei(i)->find<gebaeude_t>()  ) {
+			gb->access_first_tile()->nearby_halts_changed();
+		}
+	}
 }
 
 
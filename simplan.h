@@ -37,6 +37,12 @@ private:
 	/* list of stations that are reaching to this tile (saves lots of time for lookup) */
 	nearby_halt_t *halt_list;
 
+	/**
+	 * Changed whenever the list of stations of any tile changes, so the
+	 * copies of these lists need only be checked after a change.
+	 */
+	static uint32 haltlist_generation;
+
 	uint8 ground_size, halt_list_count;
 
 	/**
@@ -190,6 +196,8 @@ private:
 	// these functions are private helper functions for halt_list corrections
 	void halt_list_remove(halthandle_t halt);
 	void halt_list_insert_at(halthandle_t halt, uint8 pos, uint8 distance);
+	/// tells the buildings on this tile that their nearby halts changed
+	void halt_list_changed();
 
 public:
 	/*
@@ -212,6 +220,8 @@ public:
 	const nearby_halt_t *get_haltlist() const { return halt_list; }
 	uint8 get_haltlist_count() const { return halt_list_count; }
 
+	static uint32 get_haltlist_generation() { return haltlist_generation; }
+
 	void rdwr(loadsave_t *file, koord pos );
 
 	/**
@@ -50,6 +50,7 @@
 #include "gui/depotlist_frame.h"
 #include "gui/vehiclelist_frame.h"
 #include "gui/signalboxlist_frame.h"
+#include "gui/profiler_frame.h"
 
 #include "obj/baum.h"
 
@@ -391,6 +392,21 @@ public:
 	bool is_work_network_safe() const OVERRIDE { return true; }
 };
 
+/* open the timings of the world steps */
+class dialog_profiler_t : public tool_t {
+public:
+	dialog_profiler_t() : tool_t(DIALOG_PROFILER | DIALOG_TOOL) {}
+	char const* get_tooltip(player_t const*) const OVERRIDE { return translator::translate("Performance profile"); }
+	bool is_selected() const OVERRIDE { return win_get_magic(magic_profiler); }
+	bool init(player_t*) OVERRIDE {
+		create_win(new profiler_frame_t(), w_info, magic_profiler);
+		return false;
+	}
+	bool exit(player_t*) OVERRIDE { destroy_win(magic_profiler); return false; }
+	bool is_init_network_safe() const OVERRIDE { return true; }
+	bool is_work_network_safe() const OVERRIDE { return true; }
+};
+
 /* open the list of towns */
 class dialog_list_town_t : public tool_t {
 public:
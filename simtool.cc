@@ -10638,6 +10638,8 @@ bool tool_change_traffic_light_t::init( player_t *player )
 					}
 				}
 				else {
+					// the players allowed on the private way have changed
+					weg_t::network_changed();
 					privatesign_info_t* trafficlight_win = (privatesign_info_t*)win_get_magic((ptrdiff_t)rs);
 					if (trafficlight_win) {
 						trafficlight_win->update_data();
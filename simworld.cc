@@ -91,6 +91,7 @@
 #include "dataobj/marker.h"
 
 #include "utils/cbuffer_t.h"
+#include "utils/simprofiler.h"
 #include "utils/simrandom.h"
 #include "utils/simstring.h"
 
@@ -130,7 +131,6 @@
 #include "utils/simthread.h"
 
 static vector_tpl<pthread_t> private_car_route_threads;
-static vector_tpl<pthread_t> unreserve_route_threads;
 static vector_tpl<pthread_t> step_passengers_and_mail_threads;
 static vector_tpl<pthread_t> individual_convoy_step_threads;
 static vector_tpl<pthread_t> path_explorer_threads;
@@ -143,16 +143,14 @@ static pthread_mutexattr_t mutex_attributes;
 //static pthread_mutex_t private_car_route_mutex = PTHREAD_MUTEX_INITIALIZER;
 //pthread_mutex_t karte_t::step_passengers_and_mail_mutex = PTHREAD_MUTEX_INITIALIZER;
 //static pthread_mutex_t path_explorer_await_mutex = PTHREAD_MUTEX_INITIALIZER;
-//pthread_mutex_t karte_t::unreserve_route_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 pthread_mutex_t karte_t::private_car_route_mutex;
 bool karte_t::private_car_route_mutex_initialised;
 pthread_mutex_t karte_t::step_passengers_and_mail_mutex;
 static pthread_mutex_t path_explorer_await_mutex;
-pthread_mutex_t karte_t::unreserve_route_mutex;
 
 simthread_barrier_t karte_t::private_car_barrier;
-simthread_barrier_t karte_t::unreserve_route_barrier;
+simthread_barrier_t karte_t::path_explorer_workers_barrier;
 static simthread_barrier_t step_passengers_and_mail_barrier;
 static simthread_barrier_t path_explorer_barrier;
 static simthread_barrier_t step_convoys_barrier_internal;
@@ -167,6 +165,7 @@ vector_tpl<convoihandle_t> convoys_next_step;
 
 vector_tpl<pedestrian_t*> *karte_t::pedestrians_added_threaded;
 vector_tpl<private_car_t*> *karte_t::private_cars_added_threaded;
+karte_t::passenger_thread_output_t *karte_t::passenger_thread_outputs;
 #endif
 sint32 karte_t::cities_to_process = 0;
 #ifdef MULTI_THREAD
@@ -639,6 +638,7 @@ void karte_t::destroy()
 
 	// Added by : B.Gabriel
 	route_t::TERM_NODES();
+	route_t::clear_cache();
 
 	// Added by : Knightly
 	path_explorer_t::finalise();
@@ -647,6 +647,7 @@ void karte_t::destroy()
 	destroying = false;
 #ifdef MULTI_THREAD
 	cities_to_process = 0;
+	cities_checking_private_car_routes.clear();
 	terminating_threads = false;
 #endif
 }
@@ -854,6 +855,46 @@ void karte_t::create_rivers( sint16 number )
 void karte_t::remove_queued_city(stadt_t* city)
 {
 	cities_awaiting_private_car_route_check.remove(city);
+	if (cities_checking_private_car_routes.is_contained(city))
+	{
+#ifdef MULTI_THREAD
+		// Let the check of this city finish before it is deleted
+		suspend_private_car_threads();
+#endif
+		for (uint32 i = 0; i < cities_checking_private_car_routes.get_count(); i++)
+		{
+			if (cities_checking_private_car_routes[i] == city)
+			{
+				cities_checking_private_car_routes[i] = NULL;
+				cities_to_process--;
+			}
+		}
+	}
+}
+
+void karte_t::assign_private_car_route_cities(sint32 max_cities)
+{
+#ifdef MULTI_THREAD
+	int error = pthread_mutex_lock(&karte_t::private_car_route_mutex);
+	assert(error == 0);
+	(void)error;
+#endif
+	cities_to_process = 0;
+	for (uint32 i = 0; i < cities_checking_private_car_routes.get_count(); i++)
+	{
+		if (!cities_checking_private_car_routes[i] && (sint32)i < max_cities && !cities_awaiting_private_car_route_check.empty())
+		{
+			cities_checking_private_car_routes[i] = cities_awaiting_private_car_route_check.remove_first();
+		}
+		if (cities_checking_private_car_routes[i])
+		{
+			cities_to_process++;
+		}
+	}
+#ifdef MULTI_THREAD
+	error = pthread_mutex_unlock(&karte_t::private_car_route_mutex);
+	assert(error == 0);
+#endif
 }
 
 void karte_t::add_queued_city(stadt_t* city)
@@ -1593,23 +1634,27 @@ void *check_road_connexions_threaded(void *args)
 		assert(error == 0);
 		(void)error;
 
-		if (karte_t::cities_to_process > 0 && karte_t::cities_to_process >= thread_number + 1 && route_t::suspend_private_car_routing == false && !world()->cities_awaiting_private_car_route_check.empty())
+		stadt_t* city = NULL;
+		if (route_t::suspend_private_car_routing == false && thread_number < world()->cities_checking_private_car_routes.get_count())
 		{
-			stadt_t* city;
-			city = world()->cities_awaiting_private_car_route_check.remove_first();
+			// The main thread assigns the cities while this thread waits at the barrier
+			city = world()->cities_checking_private_car_routes[thread_number];
+		}
 
+		if (city)
+		{
 			int error = pthread_mutex_unlock(&karte_t::private_car_route_mutex);
 			assert(error == 0);
 			(void)error;
 
-			if (!city || world()->get_settings().get_assume_everywhere_connected_by_road())
+			if (!world()->get_settings().get_assume_everywhere_connected_by_road())
 			{
-				continue;
+				profile_worker_scope_t profile(profiler_t::WORKER_PRIVATE_CARS, thread_number);
+				city->check_all_private_car_routes();
 			}
 
-			city->check_all_private_car_routes();
-
 			error = pthread_mutex_lock(&karte_t::private_car_route_mutex);
+			world()->cities_checking_private_car_routes[thread_number] = NULL;
 			karte_t::cities_to_process--;
 			error = pthread_mutex_unlock(&karte_t::private_car_route_mutex);
 
@@ -1653,6 +1698,24 @@ uint32 passengers_travelled_this_month_with_tolerance_of_under_10_minutes = 0;
 uint32 total_journey_times_this_month = 0;
 #endif
 
+/**
+ * The share of one of thread_count passenger generation threads of the
+ * time budget for generating packets: whole step intervals, spread so that
+ * the shares differ by at most one interval and depend only on the thread
+ * index. Thus no thread is left without work by rounding, and the shares
+ * are the same on all clients of a network game.
+ */
+static sint32 get_generation_share(sint32 budget, sint32 interval, uint32 thread_index, uint32 thread_count)
+{
+	if (interval <= 0 || budget < interval)
+	{
+		return 0;
+	}
+	const uint32 packets = (uint32)(budget / interval);
+	const uint32 share = packets / thread_count + (thread_index < packets % thread_count ? 1 : 0);
+	return (sint32)share * interval;
+}
+
 void *step_passengers_and_mail_threaded(void* args)
 {
 	const uint32* thread_number_ptr = (const uint32*)args;
@@ -1687,120 +1750,73 @@ void *step_passengers_and_mail_threaded(void* args)
 			break;
 		}
 
-		// The generate passengers function is called many times (often well > 100) each step; the mail version is called only once or twice each step, sometimes not at all.
-		sint32 units_this_step = 0;
-		total_units_passenger = 0;
-		total_units_mail = 0;
+		{
+			profile_worker_scope_t profile(profiler_t::WORKER_PASSENGERS, karte_t::passenger_generation_thread_number);
+
+			// The generate passengers function is called many times (often well > 100) each step; the mail version is called only once or twice each step, sometimes not at all.
+			sint32 units_this_step = 0;
+			total_units_passenger = 0;
+			total_units_mail = 0;
 
 #ifndef FIXED_PASSENGER_NUMBERS_PER_STEP_FOR_TESTING
-		next_step_passenger_this_thread = karte_t::world->next_step_passenger / (karte_t::world->get_parallel_operations());
-
-		next_step_mail_this_thread = karte_t::world->next_step_mail / (karte_t::world->get_parallel_operations());
+			// Thread numbers start from 1, as 0 is the main thread.
+			const uint32 thread_count = karte_t::world->get_parallel_operations() + 1;
+			next_step_passenger_this_thread = get_generation_share(karte_t::world->next_step_passenger, karte_t::world->passenger_step_interval, karte_t::passenger_generation_thread_number - 1, thread_count);
+			next_step_mail_this_thread = get_generation_share(karte_t::world->next_step_mail, karte_t::world->mail_step_interval, karte_t::passenger_generation_thread_number - 1, thread_count);
 
 #ifdef FORBID_PARALLELL_PASSENGER_GENERATION_IN_NETWORK_MODE
-		if (env_t::networkmode)
-		{
-			if (karte_t::passenger_generation_thread_number == 0)
-			{
-				next_step_passenger_this_thread = karte_t::world->next_step_passenger;
-			}
-			else
+			if (env_t::networkmode)
 			{
-				next_step_passenger_this_thread = 0;
+				// Only the first thread generates passengers.
+				next_step_passenger_this_thread = karte_t::passenger_generation_thread_number == 1 ? get_generation_share(karte_t::world->next_step_passenger, karte_t::world->passenger_step_interval, 0, 1) : 0;
 			}
-		}
-		else
-		{
-#else
+#endif
 
-			if (next_step_passenger_this_thread < karte_t::world->passenger_step_interval && karte_t::world->next_step_passenger > karte_t::world->passenger_step_interval)
+			if (karte_t::world->passenger_step_interval <= next_step_passenger_this_thread)
 			{
-				if (karte_t::passenger_generation_thread_number == 0)
+				do
 				{
-					// In case of very small numbers, make this effectively single threaded, or else rounding errors will prevent any passenger generation.
-					next_step_passenger_this_thread = karte_t::world->next_step_passenger;
-				}
-				else
-				{
-					next_step_passenger_this_thread = 0;
-				}
-			}
-			else if (karte_t::passenger_generation_thread_number == 0)
-			{
-				next_step_passenger_this_thread += karte_t::world->next_step_passenger % (karte_t::world->get_parallel_operations());
+					if (karte_t::world->passenger_origins.get_count() == 0)
+					{
+						goto top;
+					}
+					units_this_step = karte_t::world->generate_passengers_or_mail(goods_manager_t::passengers);
+					total_units_passenger += units_this_step;
+					next_step_passenger_this_thread -= (karte_t::world->passenger_step_interval * units_this_step);
+
+				} while (karte_t::world->passenger_step_interval <= next_step_passenger_this_thread);
 			}
 
-			if (next_step_mail_this_thread < karte_t::world->mail_step_interval && karte_t::world->next_step_mail > karte_t::world->mail_step_interval)
+			if (karte_t::world->mail_step_interval <= next_step_mail_this_thread)
 			{
-				if (karte_t::passenger_generation_thread_number == 0)
-				{
-					// In case of very small numbers, make this effectively single threaded, or else rounding errors will prevent any mail generation.
-					next_step_mail_this_thread = karte_t::world->next_step_mail;
-				}
-				else
+				do
 				{
-					next_step_mail_this_thread = 0;
-				}
+					if (karte_t::world->mail_origins_and_targets.get_count() == 0)
+					{
+						goto top;
+					}
+					units_this_step = karte_t::world->generate_passengers_or_mail(goods_manager_t::mail);
+					total_units_mail += units_this_step;
+					next_step_mail_this_thread -= (karte_t::world->mail_step_interval * units_this_step);
+
+				} while (karte_t::world->mail_step_interval <= next_step_mail_this_thread);
 			}
-			else if (karte_t::passenger_generation_thread_number == 0)
+#else
+			for (uint32 i = 0; i < 2; i++)
 			{
-				next_step_mail_this_thread += karte_t::world->next_step_mail % (karte_t::world->get_parallel_operations());
+				karte_t::world->generate_passengers_or_mail(goods_manager_t::passengers);
+				karte_t::world->generate_passengers_or_mail(goods_manager_t::mail);
 			}
 #endif
-
-#ifdef FORBID_PARALLELL_PASSENGER_GENERATION_IN_NETWORK_MODE
 		}
-#endif
 
-		if (karte_t::world->passenger_step_interval <= next_step_passenger_this_thread)
-		{
-			do
-			{
-				if (karte_t::world->passenger_origins.get_count() == 0)
-				{
-					goto top;
-				}
-				units_this_step = karte_t::world->generate_passengers_or_mail(goods_manager_t::passengers);
-				total_units_passenger += units_this_step;
-				next_step_passenger_this_thread -= (karte_t::world->passenger_step_interval * units_this_step);
-
-			} while (karte_t::world->passenger_step_interval <= next_step_passenger_this_thread);
-		}
-
-		if (karte_t::world->mail_step_interval <= next_step_mail_this_thread)
-		{
-			do
-			{
-				if (karte_t::world->mail_origins_and_targets.get_count() == 0)
-				{
-					goto top;
-				}
-				units_this_step = karte_t::world->generate_passengers_or_mail(goods_manager_t::mail);
-				total_units_mail += units_this_step;
-				next_step_mail_this_thread -= (karte_t::world->mail_step_interval * units_this_step);
-
-			} while (karte_t::world->mail_step_interval <= next_step_mail_this_thread);
-		}
-#else
-		for (uint32 i = 0; i < 2; i++)
-		{
-			karte_t::world->generate_passengers_or_mail(goods_manager_t::passengers);
-			karte_t::world->generate_passengers_or_mail(goods_manager_t::mail);
-		}
-#endif
+		// Deducted from the totals by the main thread in await_passengers_and_mail_threads()
+		karte_t::passenger_thread_output_t &output = karte_t::passenger_thread_outputs[karte_t::passenger_generation_thread_number];
+		output.passenger_units = total_units_passenger;
+		output.mail_units = total_units_mail;
 
 		simthread_barrier_wait(&step_passengers_and_mail_barrier); // Having three of these is intentional.
-		int mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-		assert(mutex_error == 0);
-		(void)mutex_error;
-
-		karte_t::world->next_step_passenger -= (total_units_passenger * karte_t::world->passenger_step_interval);
-		karte_t::world->next_step_mail -= (total_units_mail * karte_t::world->mail_step_interval);
-
-		mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
 		simthread_barrier_wait(&step_passengers_and_mail_barrier);
-		assert(mutex_error == 0);
-		(void)mutex_error;
 	}
 
 	return args;
@@ -1808,8 +1824,9 @@ void *step_passengers_and_mail_threaded(void* args)
 
 void karte_t::start_passengers_and_mail_threads()
 {
-	simthread_barrier_wait(&step_passengers_and_mail_barrier);
+	// Set before the barrier releases the threads, so that await_passengers_and_mail_threads() always collects them.
 	passengers_and_mail_threads_working = true;
+	simthread_barrier_wait(&step_passengers_and_mail_barrier);
 }
 #endif //MULTI_THREAD
 
@@ -1826,6 +1843,22 @@ void karte_t::await_passengers_and_mail_threads()
 			simthread_barrier_wait(&step_passengers_and_mail_barrier);
 			simthread_barrier_wait(&step_passengers_and_mail_barrier);
 			passengers_and_mail_threads_working = false;
+
+			// Merge the output of the threads in thread order,
+			// so that the result does not depend on their timing.
+			for (sint32 i = 1; i <= get_parallel_operations() + 1; i++)
+			{
+				passenger_thread_output_t &output = passenger_thread_outputs[i];
+				next_step_passenger -= output.passenger_units * passenger_step_interval;
+				next_step_mail -= output.mail_units * mail_step_interval;
+				output.passenger_units = 0;
+				output.mail_units = 0;
+				FOR(vector_tpl<generated_statistic_t>, const& stat, output.statistics)
+				{
+					apply_generated(stat);
+				}
+				output.statistics.clear();
+			}
 		}
 #ifdef FORBID_MULTI_THREAD_PASSENGER_GENERATION_IN_NETWORK_MODE
 	}
@@ -1879,13 +1912,16 @@ void* step_individual_convoy_threaded(void* args)
 			return NULL;
 		}
 
-		const uint32 convoys_next_step_count = convoys_next_step.get_count();
-		for (uint32 i = thread_number; i < convoys_next_step_count; i += karte_t::world->get_parallel_operations())
 		{
-			convoihandle_t cnv = convoys_next_step[i];
-			if (cnv.is_bound())
+			profile_worker_scope_t profile(profiler_t::WORKER_CONVOYS, thread_number);
+			const uint32 convoys_next_step_count = convoys_next_step.get_count();
+			for (uint32 i = thread_number; i < convoys_next_step_count; i += karte_t::world->get_parallel_operations())
 			{
-				cnv->threaded_step();
+				convoihandle_t cnv = convoys_next_step[i];
+				if (cnv.is_bound())
+				{
+					cnv->threaded_step();
+				}
 			}
 		}
 
@@ -1967,12 +2003,46 @@ void* path_explorer_threaded(void* args)
 		{
 			return NULL;
 		}
-		path_explorer_t::step();
+		{
+			profile_worker_scope_t profile(profiler_t::WORKER_PATH_EXPLORER, 0);
+			path_explorer_t::step();
+		}
 		simthread_barrier_wait(&path_explorer_barrier);
 	}
 
 	return args;
 }
+
+#ifdef MULTI_THREAD_PATH_EXPLORER
+void* path_explorer_worker_threaded(void* args)
+{
+	const uint32* thread_number_ptr = (const uint32*)args;
+	const uint32 thread_number = *thread_number_ptr;
+	delete thread_number_ptr;
+
+	do
+	{
+		simthread_barrier_wait(&karte_t::path_explorer_workers_barrier);
+
+		if (karte_t::world->is_terminating_threads())
+		{
+			break;
+		}
+
+		// Share 0 is explored by the path explorer thread itself
+		{
+			profile_worker_scope_t profile(profiler_t::WORKER_PATH_EXPLORER, thread_number + 1);
+			path_explorer_t::parallel_compartment->explore_segments_share(path_explorer_t::parallel_via, thread_number + 1, path_explorer_t::worker_count + 1);
+		}
+
+		simthread_barrier_wait(&karte_t::path_explorer_workers_barrier);
+
+	} while (!karte_t::world->is_terminating_threads());
+
+	pthread_exit(NULL);
+	return args;
+}
+#endif
 #endif
 
 void karte_t::await_path_explorer()
@@ -2008,53 +2078,6 @@ void karte_t::start_path_explorer()
 #endif
 }
 
-void* unreserve_route_threaded(void* args)
-{
-	const uint32* thread_number_ptr = (const uint32*)args;
-	const uint32 thread_number = *thread_number_ptr;
-	delete thread_number_ptr;
-
-	do
-	{
-		simthread_barrier_wait(&karte_t::unreserve_route_barrier);
-
-		if (karte_t::world->is_terminating_threads())
-		{
-			break;
-		}
-		if (convoi_t::current_unreserver == 0)
-		{
-			int error = pthread_mutex_unlock(&karte_t::unreserve_route_mutex);
-			assert(error == 0);
-			(void)error;
-
-			continue;
-		}
-
-		const uint32 max_count = weg_t::get_all_ways_count() - 1;
-		const uint32 fraction = max_count / karte_t::world->get_parallel_operations();
-
-		route_range_specification range;
-
-		range.start = thread_number * fraction;
-		if (thread_number == karte_t::world->get_parallel_operations() - 1)
-		{
-			range.end = max_count;
-		}
-		else
-		{
-			range.end = min(((thread_number + 1) * fraction - 1), max_count);
-		}
-
-		convoi_t::unreserve_route_range(range);
-
-		simthread_barrier_wait(&karte_t::unreserve_route_barrier);
-
-	} while (!karte_t::world->is_terminating_threads());
-
-	pthread_exit(NULL);
-	return args;
-}
 #endif
 
 void karte_t::await_all_threads()
@@ -2084,6 +2107,7 @@ void karte_t::init_threads()
 
 	start_halts = new vector_tpl<nearby_halt_t>[parallel_operations + 2];
 	destination_list = new vector_tpl<halthandle_t>[parallel_operations + 2];
+	passenger_thread_outputs = new passenger_thread_output_t[parallel_operations + 2];
 
 	pthread_attr_init(&thread_attributes);
 	pthread_attr_setdetachstate(&thread_attributes, PTHREAD_CREATE_JOINABLE);
@@ -2092,11 +2116,13 @@ void karte_t::init_threads()
 	const bool one_private_car_thread = false; // Because we allow servers to run private car threading in the background when no clients are connected, we should now always allow multiple thread instances here.
 
 	simthread_barrier_init(&private_car_barrier, NULL, one_private_car_thread ? 2 : parallel_operations + 1);
-	simthread_barrier_init(&karte_t::unreserve_route_barrier, NULL, parallel_operations + 2); // This and the next does not run concurrently with anything significant on the main thread, so the number of parallel operations need to be +1 compared to the others.
-	simthread_barrier_init(&step_passengers_and_mail_barrier, NULL, parallel_operations + 2);
+	simthread_barrier_init(&step_passengers_and_mail_barrier, NULL, parallel_operations + 2); // This does not run concurrently with anything significant on the main thread, so the number of parallel operations need to be +1 compared to the others.
 	simthread_barrier_init(&step_convoys_barrier_external, NULL, 2);
 	simthread_barrier_init(&step_convoys_barrier_internal, NULL, parallel_operations + 1);
 	simthread_barrier_init(&path_explorer_barrier, NULL, 2);
+#ifdef MULTI_THREAD_PATH_EXPLORER
+	simthread_barrier_init(&path_explorer_workers_barrier, NULL, parallel_operations + 1);
+#endif
 
 	// Initialise mutexes
 	pthread_mutexattr_init(&mutex_attributes);
@@ -2105,9 +2131,14 @@ void karte_t::init_threads()
 	private_car_route_mutex_initialised = true;
 	pthread_mutex_init(&private_car_route_mutex, &mutex_attributes);
 
+	cities_checking_private_car_routes.clear();
+	for (sint32 i = 0; i < (one_private_car_thread ? 1 : parallel_operations); i++)
+	{
+		cities_checking_private_car_routes.append(NULL);
+	}
+
 	pthread_mutex_init(&step_passengers_and_mail_mutex, &mutex_attributes);
 	pthread_mutex_init(&path_explorer_await_mutex, &mutex_attributes);
-	pthread_mutex_init(&unreserve_route_mutex, &mutex_attributes);
 
 	pthread_t thread;
 
@@ -2128,19 +2159,7 @@ void karte_t::init_threads()
 			}
 			private_car_threads_working = false;
 		}
-		// The next two need an extra thread compared with the others, as they do not run concurrently with anything non-trivial on the main thread
-		sint32* thread_number_unres = new sint32;
-		*thread_number_unres = i;
-		rc = pthread_create(&thread, &thread_attributes, &unreserve_route_threaded, (void*)thread_number_unres);
-		if (rc)
-		{
-			dbg->fatal("void karte_t::init_threads()", "Failed to create private car thread, error %d. See here for a translation of the error numbers: http://epydoc.sourceforge.net/stdlib/errno-module.html", rc);
-		}
-		else
-		{
-			unreserve_route_threads.append(thread);
-		}
-
+		// The next one needs an extra thread compared with the others, as it does not run concurrently with anything non-trivial on the main thread
 #ifdef MULTI_THREAD_PASSENGER_GENERATION
 		sint32* thread_number_pass = new sint32;
 		*thread_number_pass = i + 1; // +1 because we need thread number 0 to represent the main thread.
@@ -2194,6 +2213,22 @@ void karte_t::init_threads()
 		dbg->fatal("void karte_t::init_threads()", "Failed to create path explorer thread, error %d. See here for a translation of the error numbers: http://epydoc.sourceforge.net/stdlib/errno-module.html", rc);
 	}
 	path_explorer_working = false;
+
+	for (sint32 i = 0; i < parallel_operations; i++)
+	{
+		uint32* thread_number_explorer = new uint32;
+		*thread_number_explorer = i;
+		rc = pthread_create(&thread, &thread_attributes, &path_explorer_worker_threaded, (void*)thread_number_explorer);
+		if (rc)
+		{
+			dbg->fatal("void karte_t::init_threads()", "Failed to create path explorer worker thread, error %d. See here for a translation of the error numbers: http://epydoc.sourceforge.net/stdlib/errno-module.html", rc);
+		}
+		else
+		{
+			path_explorer_threads.append(thread);
+		}
+	}
+	path_explorer_t::set_worker_count(path_explorer_threads.get_count());
 #endif
 
 	threads_initialised = true;
@@ -2226,10 +2261,13 @@ void karte_t::destroy_threads()
 		await_private_car_threads();
 		simthread_barrier_wait(&private_car_barrier);
 
-		simthread_barrier_wait(&unreserve_route_barrier);
 #ifdef MULTI_THREAD_PATH_EXPLORER
 		simthread_barrier_wait(&path_explorer_barrier);
 		pthread_join(path_explorer_thread, 0);
+		simthread_barrier_wait(&path_explorer_workers_barrier);
+		clean_threads(&path_explorer_threads);
+		path_explorer_threads.clear();
+		path_explorer_t::set_worker_count(0);
 #endif
 #ifdef MULTI_THREAD_CONVOYS
 		pthread_join(convoy_step_master_thread, 0);
@@ -2242,9 +2280,6 @@ void karte_t::destroy_threads()
 		clean_threads(&step_passengers_and_mail_threads);
 		step_passengers_and_mail_threads.clear();
 #endif
-
-		clean_threads(&unreserve_route_threads);
-		unreserve_route_threads.clear();
 #ifdef MULTI_THREAD_CONVOYS
 		simthread_barrier_destroy(&step_convoys_barrier_external);
 		simthread_barrier_destroy(&step_convoys_barrier_internal);
@@ -2253,10 +2288,10 @@ void karte_t::destroy_threads()
 		simthread_barrier_destroy(&step_passengers_and_mail_barrier);
 #endif
 		simthread_barrier_destroy(&private_car_barrier);
-		simthread_barrier_destroy(&unreserve_route_barrier);
 
 #ifdef MULTI_THREAD_PATH_EXPLORER
 		simthread_barrier_destroy(&path_explorer_barrier);
+		simthread_barrier_destroy(&path_explorer_workers_barrier);
 #endif
 
 		// Destroy mutexes
@@ -2264,7 +2299,6 @@ void karte_t::destroy_threads()
 		private_car_route_mutex_initialised = false;
 		pthread_mutex_destroy(&step_passengers_and_mail_mutex);
 		pthread_mutex_destroy(&path_explorer_await_mutex);
-		pthread_mutex_destroy(&unreserve_route_mutex);
 
 		pthread_mutexattr_destroy(&mutex_attributes);
 	}
@@ -2281,6 +2315,8 @@ void karte_t::destroy_threads()
 	start_halts = NULL;
 	delete[] destination_list;
 	destination_list = NULL;
+	delete[] passenger_thread_outputs;
+	passenger_thread_outputs = NULL;
 
 	threads_initialised = false;
 	terminating_threads = false;
@@ -2913,18 +2949,18 @@ void karte_t::enlarge_map(settings_t const* sets, sint8 const* const h_field)
 
 	for (uint8 i = 0; i < goods_manager_t::passengers->get_number_of_classes(); i++)
 	{
-		FOR(weighted_vector_tpl<gebaeude_t*>, const target, commuter_targets[i])
+		FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const target, commuter_targets[i])
 		{
 			target->set_building_tiles();
 		}
 
-		FOR(weighted_vector_tpl<gebaeude_t*>, const target, visitor_targets[i])
+		FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const target, visitor_targets[i])
 		{
 			target->set_building_tiles();
 		}
 	}
 
-	FOR(weighted_vector_tpl<gebaeude_t*>, const target, mail_origins_and_targets)
+	FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const target, mail_origins_and_targets)
 	{
 		target->set_building_tiles();
 	}
@@ -3038,6 +3074,7 @@ karte_t::karte_t() :
 	speed_factors_are_set(false)
 {
 	destroying = false;
+	background_save_id = -1;
 
 	// length of day and other time stuff
 	ticks_per_world_month_shift = 20;
@@ -3055,6 +3092,7 @@ karte_t::karte_t() :
 	sync_steps_barrier = sync_steps;
 	next_step_passenger = 0;
 	next_step_mail = 0;
+	nearby_halts_generation = 0;
 	destroying = false;
 	transferring_cargoes = NULL;
 #ifdef MULTI_THREAD
@@ -3132,8 +3170,8 @@ karte_t::karte_t() :
 	parallel_operations = -1;
 
 	const uint8 number_of_passenger_classes = goods_manager_t::passengers->get_number_of_classes();
-	commuter_targets = new weighted_vector_tpl<gebaeude_t*>[number_of_passenger_classes];
-	visitor_targets = new weighted_vector_tpl<gebaeude_t*>[number_of_passenger_classes];
+	commuter_targets = new fenwick_weighted_vector_tpl<gebaeude_t*>[number_of_passenger_classes];
+	visitor_targets = new fenwick_weighted_vector_tpl<gebaeude_t*>[number_of_passenger_classes];
 
 #ifdef MULTI_THREAD
 	passengers_and_mail_threads_working = false;
@@ -3146,6 +3184,8 @@ karte_t::karte_t() :
 karte_t::~karte_t()
 {
 	is_sound = false;
+	// let an autosave in the background finish
+	check_background_save(true);
 	destroy();
 
 	// not deleting the tools of this map ...
@@ -3909,20 +3949,20 @@ DBG_MESSAGE( "karte_t::rotate90()", "called" );
 
 	for (uint8 i = 0; i < goods_manager_t::passengers->get_number_of_classes(); i++)
 	{
-		FOR(weighted_vector_tpl<gebaeude_t*>, const building, visitor_targets[i])
+		FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const building, visitor_targets[i])
 		{
 			building->set_building_tiles();
 		}
-		FOR(weighted_vector_tpl<gebaeude_t*>, const building, commuter_targets[i])
+		FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const building, commuter_targets[i])
 		{
 			building->set_building_tiles();
 		}
 	}
-	FOR(weighted_vector_tpl<gebaeude_t*>, const building, passenger_origins)
+	FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const building, passenger_origins)
 	{
 		building->set_building_tiles();
 	}
-	FOR(weighted_vector_tpl<gebaeude_t*>, const building, mail_origins_and_targets)
+	FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const building, mail_origins_and_targets)
 	{
 		building->set_building_tiles();
 	}
@@ -4201,10 +4241,54 @@ void karte_t::sync_list_t::remove(sync_steppable *obj)
 void karte_t::sync_list_t::clear()
 {
 	list.clear();
+	parallel_stepped.clear();
 	currently_deleting = NULL;
 	sync_step_running = false;
 }
 
+bool karte_t::sync_list_t::prepare_parallel_sync_step(uint32 delta_t, sint16 rows)
+{
+	parallel_delta_t = delta_t;
+	parallel_stepped.set_count( list.get_count() );
+	parallel_row_start.set_count( rows + 1 );
+	for(  sint16 y = 0;  y <= rows;  y++  ) {
+		parallel_row_start[y] = 0;
+	}
+
+	// count the objects per row
+	parallel_row.set_count( list.get_count() );
+	uint32 parallel_count = 0;
+	for(  uint32 i = 0;  i < list.get_count();  i++  ) {
+		const sint16 y = list[i]->prepare_parallel_sync_step( delta_t );
+		parallel_stepped[i] = y >= 0  &&  y < rows;
+		if(  parallel_stepped[i]  ) {
+			parallel_row[i] = y;
+			parallel_row_start[y+1]++;
+			parallel_count++;
+		}
+	}
+	if(  parallel_count == 0  ) {
+		parallel_stepped.clear();
+		return false;
+	}
+
+	for(  sint16 y = 0;  y < rows;  y++  ) {
+		parallel_row_start[y+1] += parallel_row_start[y];
+	}
+	// now place the objects, in list order within each row
+	vector_tpl<uint32> next( rows );
+	for(  sint16 y = 0;  y < rows;  y++  ) {
+		next.append( parallel_row_start[y] );
+	}
+	parallel_order.set_count( parallel_count );
+	for(  uint32 i = 0;  i < list.get_count();  i++  ) {
+		if(  parallel_stepped[i]  ) {
+			parallel_order[ next[parallel_row[i]]++ ] = i;
+		}
+	}
+	return true;
+}
+
 void karte_t::sync_list_t::sync_step(uint32 delta_t)
 {
 	sync_step_running = true;
@@ -4212,6 +4296,10 @@ void karte_t::sync_list_t::sync_step(uint32 delta_t)
 
 	for(uint32 i=0; i<list.get_count();i++) {
 		sync_steppable *ss = list[i];
+		if(  i < parallel_stepped.get_count()  &&  parallel_stepped[i]  ) {
+			// already moved by sync_step_parallel_loop()
+			continue;
+		}
 		switch(ss->sync_step(delta_t)) {
 			case SYNC_OK:
 				break;
@@ -4225,12 +4313,25 @@ void karte_t::sync_list_t::sync_step(uint32 delta_t)
 				if (i < list.get_count()) {
 					list[i] = ss;
 				}
+				if(  parallel_stepped.get_count() > list.get_count()  ) {
+					// the moved entry is not visited again anyway
+					parallel_stepped.pop_back();
+				}
 		}
 	}
+	parallel_stepped.clear();
 	sync_step_running = false;
 }
 
 
+void karte_t::sync_step_parallel_loop(sint16, sint16, sint16 y_min, sint16 y_max)
+{
+	for(  uint32 j = sync.parallel_row_start[y_min];  j < sync.parallel_row_start[y_max];  j++  ) {
+		sync.list[ sync.parallel_order[j] ]->sync_step( sync.parallel_delta_t );
+	}
+}
+
+
 /*
  * this routine is called before an image is displayed
  * it moves vehicles and pedestrians
@@ -4258,6 +4359,8 @@ void karte_t::sync_step(uint32 delta_t, bool do_sync_step, bool display )
 	set_random_mode( SYNC_STEP_RANDOM );
 	if(do_sync_step) {
 		// Only omitted when called to display a new frame during fast forward
+		profile_scope_t sync_step_scope( profiler_t::SYNC_STEP );
+		profile_laps_t laps;
 
 		// just for progress
 		if(  delta_t > 10000  ) {
@@ -4282,12 +4385,24 @@ void karte_t::sync_step(uint32 delta_t, bool do_sync_step, bool display )
 		sync_way_eyecandy.sync_step( delta_t );
 
 		rands[3] = get_random_seed();
+		laps.lap( profiler_t::SYNC_STEP_EYECANDY );
 
 		clear_random_mode( INTERACTIVE_RANDOM );
 
+#ifdef MULTI_THREAD
+		/* Private cars and pedestrians which only move on within their tile
+		 * do not interact with anything, so they are moved first, in parallel
+		 * by map region. Everything else follows in list order, as usual.
+		 * This changes the order of the steps, hence not in network games.
+		 */
+		if(  env_t::parallel_sync_step  &&  !env_t::networkmode  &&  env_t::num_threads > 1  &&  sync.prepare_parallel_sync_step( delta_t, cached_grid_size.y )  ) {
+			world_xy_loop( &karte_t::sync_step_parallel_loop, 0 );
+		}
+#endif
 		sync.sync_step( delta_t );
 
 		rands[4] = get_random_seed();
+		laps.lap( profiler_t::SYNC_STEP_OBJECTS );
 
 		ticker::update();
 	}
@@ -4723,7 +4838,9 @@ void karte_t::new_month()
 	if( !env_t::networkmode && env_t::autosave>0 && last_month%env_t::autosave==0 && !win_get_magic(magic_welt_gui_t) ) {
 		char buf[128];
 		sprintf( buf, "save/autosave%02i.sve", last_month+1 );
-		save( buf, true, env_t::savegame_version_str, env_t::savegame_ex_version_str, env_t::savegame_ex_revision_str, true );
+		if(  !env_t::background_save  ||  !save_in_background( buf, env_t::savegame_version_str, env_t::savegame_ex_version_str, env_t::savegame_ex_revision_str )  ) {
+			save( buf, true, env_t::savegame_version_str, env_t::savegame_ex_version_str, env_t::savegame_ex_revision_str, true );
+		}
 	}
 
 	recalc_passenger_destination_weights();
@@ -4943,10 +5060,8 @@ void karte_t::pause_step()
 		// There can be many mutex clashes with this; however, processing only one city at a time can make it take an unfeasible amount of time to refresh all routes.
 		//cities_to_process = stadt.get_count() > 64 ? 1 : min(cities_awaiting_private_car_route_check.get_count(), parallel_operations - 1);
 		//cities_to_process = 1;
-		if (cities_to_process <= 0 || cities_awaiting_private_car_route_check.get_count() > parallel_operations - 1)
-		{
-			cities_to_process = min(cities_awaiting_private_car_route_check.get_count(), parallel_operations - 1);
-		}
+		// As in step(), only one city at a time in network games.
+		assign_private_car_route_cities(env_t::networkmode ? 1 : parallel_operations - 1);
 		start_private_car_threads();
 #else
 		const sint32 cities_to_process = env_t::networkmode ? 1 : min(cities_awaiting_private_car_route_check.get_count(), parallel_operations - 1);
@@ -4969,6 +5084,7 @@ void karte_t::pause_step()
 #ifdef MULTI_THREAD
 	await_private_car_threads();
 #endif
+	weg_t::merge_private_car_routes();
 
 	weg_t::apply_travel_time_updates();
 
@@ -5005,6 +5121,7 @@ void karte_t::step()
 		next_month_ticks += karte_t::ticks_per_world_month;
 
 		DBG_DEBUG4("karte_t::step", "calling new_month");
+		profile_scope_t new_month_scope( profiler_t::NEW_MONTH );
 		new_month();
 	}
 	rands[9] = get_random_seed();
@@ -5061,9 +5178,16 @@ void karte_t::step()
 	last_step_ticks = ticks;
 	steps ++;
 
+	// each lap records the time since the previous one
+	profile_scope_t step_scope( profiler_t::STEP );
+	profile_laps_t laps;
+
 	// to make sure the tick counter will be updated
 	INT_CHECK("karte_t::step");
 
+	// reap a finished autosave in the background
+	check_background_save(false);
+
 	/** THREADING CAN START HERE **/
 
 	// Check the private car routes. In multi-threaded mode, this can be running in the background whilst a number of other steps are processed.
@@ -5085,16 +5209,11 @@ void karte_t::step()
 		// This cannot be started at the end of the step, as we will not know at that point whether we need to call this at all.
 		// There can be many mutex clashes with this; however, processing only one city at a time can make it take an unfeasible amount of time to refresh all routes.
 
-		// Also, processing multiple cities when mutli-threaded is not network safe. The reasons for this are unclear, but this remains so even after
-		// the implementation of rwlocks for the private car routing data in January 2021. It is suspected that hte route finding algorithm is not
-		// deterministic for any given starting point, but investigations have so far not revealed whether this is the real problem or how or in what way(s) that
-		// this is not deterministic.
-
-		// For this reason, multi-threading is disabled when using network mode with clients connected until the problem can be solved.
-		if (cities_to_process <= 0 || cities_awaiting_private_car_route_check.get_count() > parallel_operations - 1)
-		{
-			cities_to_process = env_t::networkmode ? min(1, cities_awaiting_private_car_route_check.get_count()) : min(cities_awaiting_private_car_route_check.get_count(), parallel_operations - 1);
-		}
+		// The cities are handed to the threads in the order of the queue, and the routes found are only merged
+		// into the ways at one point of the step, ordered by city. However, the threads run on while the
+		// convoys and cities step, and city growth builds and removes roads, so which routes are found still
+		// depends on thread timing. Hence only one city at a time in network games, as before.
+		assign_private_car_route_cities(env_t::networkmode ? 1 : parallel_operations - 1);
 		start_private_car_threads();
 #else
 		const sint32 cities_to_process = min(cities_awaiting_private_car_route_check.get_count(), env_t::networkmode ? 1 : parallel_operations - 1);
@@ -5108,6 +5227,7 @@ void karte_t::step()
 	}
 
 	rands[10] = get_random_seed();
+	laps.lap( profiler_t::PRIVATE_CAR_ROUTES );
 
 	// check for pending seasons change
 	// This is not very computationally intensive.
@@ -5137,6 +5257,7 @@ void karte_t::step()
 	}
 
 	rands[11] = get_random_seed();
+	laps.lap( profiler_t::SEASONS );
 
 	// to make sure the tick counter will be updated
 	INT_CHECK("karte_t::step 1");
@@ -5149,6 +5270,7 @@ void karte_t::step()
 	path_explorer_t::step();
 #endif
 	rands[12] = get_random_seed();
+	laps.lap( profiler_t::PATH_EXPLORER_WAIT );
 
 	INT_CHECK("karte_t::step 2");
 
@@ -5164,6 +5286,7 @@ void karte_t::step()
 #endif
 
 	rands[13] = get_random_seed();
+	laps.lap( profiler_t::CONVOY_WAIT );
 
 	// The more computationally intensive parts of this have been extracted and made multi-threaded.
 	DBG_DEBUG4("karte_t::step 4", "step %d convois", convoi_array.get_count());
@@ -5177,6 +5300,7 @@ void karte_t::step()
 	}
 
 	rands[14] = get_random_seed();
+	laps.lap( profiler_t::CONVOYS );
 
 	INT_CHECK("karte_t::step 3a");
 
@@ -5198,6 +5322,7 @@ void karte_t::step()
 	}
 
 	rands[15] = get_random_seed();
+	laps.lap( profiler_t::CITIES );
 
 	INT_CHECK("karte_t::step 3b");
 
@@ -5208,10 +5333,14 @@ void karte_t::step()
 		await_private_car_threads();
 	}
 #endif
+	// Always here, and never when the threads are awaited elsewhere, so that the route tables
+	// change at the same point of the step on every machine of a network game.
+	weg_t::merge_private_car_routes();
 
 	weg_t::apply_travel_time_updates();
 
 	rands[16] = get_random_seed();
+	laps.lap( profiler_t::PRIVATE_CAR_WAIT );
 
 
 	INT_CHECK("karte_t::step 3c");
@@ -5233,6 +5362,9 @@ void karte_t::step()
 	po = 1;
 #endif
 
+	// The passenger generation threads only read these lists.
+	update_nearby_halts_of_buildings();
+
 	// This is quite computationally intensive, but not as much as the path explorer. It can be more or less than the convoys, depending on the map.
 	// Multi-threading the passenger and mail generation is currently not working well as dividing the number of passengers/mail to be generated per
 	//step by the number of parallel operations introduces significant rounding errors.
@@ -5279,6 +5411,7 @@ void karte_t::step()
 	DBG_DEBUG4("karte_t::step", "step generate passengers and mail");
 
 	rands[17] = get_random_seed();
+	laps.lap( profiler_t::PASSENGERS );
 
 	// the inhabitants stuff
 	finance_history_year[0][WORLD_CITIZENS] = finance_history_month[0][WORLD_CITIZENS] = 0;
@@ -5298,6 +5431,7 @@ void karte_t::step()
 	}
 
 	rands[18] = get_random_seed();
+	laps.lap( profiler_t::CITY_STATISTICS );
 
 	INT_CHECK("karte_t::step 4");
 
@@ -5305,6 +5439,7 @@ void karte_t::step()
 	await_passengers_and_mail_threads();
 
 	rands[19] = get_random_seed();
+	laps.lap( profiler_t::PASSENGER_WAIT );
 
 	for (uint32 i = 0; i < po; i++)
 	{
@@ -5370,6 +5505,8 @@ void karte_t::step()
 	}
 #endif
 #endif
+	laps.lap( profiler_t::NEW_ROAD_USERS );
+
 	INT_CHECK("karte_t::step 5");
 
 	DBG_DEBUG4("karte_t::step", "step factories");
@@ -5377,6 +5514,7 @@ void karte_t::step()
 		f->step(delta_t);
 	}
 	rands[20] = get_random_seed();
+	laps.lap( profiler_t::FACTORIES );
 
 	finance_history_year[0][WORLD_FACTORIES] = finance_history_month[0][WORLD_FACTORIES] = fab_list.get_count();
 
@@ -5387,6 +5525,7 @@ void karte_t::step()
 	senke_t::step_all( delta_t );
 	powernet_t::step_all( delta_t );
 	rands[21] = get_random_seed();
+	laps.lap( profiler_t::POWERLINES );
 
 	INT_CHECK("karte_t::step 6");
 
@@ -5399,6 +5538,7 @@ void karte_t::step()
 		}
 	}
 	rands[22] = get_random_seed();
+	laps.lap( profiler_t::PLAYERS );
 
 	INT_CHECK("karte_t::step 7");
 
@@ -5406,6 +5546,7 @@ void karte_t::step()
 	DBG_DEBUG4("karte_t::step", "step halts");
 	haltestelle_t::step_all();
 	rands[23] = get_random_seed();
+	laps.lap( profiler_t::HALTS );
 
 	// Re-check paths if the time has come.
 	// Long months means that it might be necessary to do
@@ -5420,12 +5561,14 @@ void karte_t::step()
 	}
 
 	rands[24] = get_random_seed();
+	laps.lap( profiler_t::PATH_REFRESH );
 
 	INT_CHECK("karte_t::step 8");
 
 	check_transferring_cargoes();
 
 	rands[25] = get_random_seed();
+	laps.lap( profiler_t::TRANSFERRING_CARGOES );
 
 #ifdef MULTI_THREAD_PATH_EXPLORER
 	// Start the path explorer ready for the next step. This can be very
@@ -5442,6 +5585,7 @@ void karte_t::step()
 	// the path explorer would thus lead to a race condition.
 	start_convoy_threads();
 #endif
+	laps.lap( profiler_t::START_THREADS );
 
 	// ok, next step
 	INT_CHECK("karte_t::step 9");
@@ -5492,12 +5636,14 @@ void karte_t::step()
 
 	DBG_DEBUG4("karte_t::step", "end");
 	rands[26] = get_random_seed();
+	laps.lap( profiler_t::STEP_REST );
 }
 
 void karte_t::refresh_private_car_routes() {
 #ifdef MULTI_THREAD
 	suspend_private_car_threads();
 #endif
+	weg_t::merge_private_car_routes();
 	weg_t::swap_private_car_routes_currently_reading_element();
 	clear_private_car_routes();
 	for(auto & city : stadt) {
@@ -5506,16 +5652,7 @@ void karte_t::refresh_private_car_routes() {
 }
 
 void karte_t::clear_private_car_routes() {
-	weg_t::private_car_route_map::route_map_lock();
-	for(auto & w : weg_t::get_alle_wege()) {
-		for(auto & l : w->private_car_routes[weg_t::get_private_car_routes_currently_writing_element()]) {
-			l.pre_reset();
-		}
-	}
-	weg_t::private_car_route_map::reset(weg_t::get_private_car_routes_currently_writing_element());
-
-	weg_t::private_car_route_map::route_map_unlock();
-
+	weg_t::clear_private_car_routes(weg_t::get_private_car_routes_currently_writing_element());
 }
 
 void karte_t::step_time_interval_signals()
@@ -5616,6 +5753,58 @@ void karte_t::get_nearby_halts_of_tiles(const minivec_tpl<const planquadrat_t*>
 	}
 }
 
+void karte_t::get_nearby_halts_of_building(gebaeude_t *gb, const goods_desc_t * wtyp, vector_tpl<nearby_halt_t> &halts) const
+{
+	const vector_tpl<nearby_halt_t> *nearby_halts = gb->get_nearby_halts();
+	if (!nearby_halts)
+	{
+		get_nearby_halts_of_tiles(gb->get_tiles(), wtyp, halts);
+		return;
+	}
+
+	FOR(vector_tpl<nearby_halt_t>, const& halt, *nearby_halts)
+	{
+		if (halt.halt->is_enabled(wtyp))
+		{
+			halts.append(halt);
+		}
+	}
+}
+
+void karte_t::update_nearby_halts_of_buildings()
+{
+	if (nearby_halts_generation == planquadrat_t::get_haltlist_generation())
+	{
+		return;
+	}
+
+	// A building may be in several of these lists, but it is only updated once.
+	FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const gb, passenger_origins)
+	{
+		gb->update_nearby_halts();
+	}
+
+	for (uint8 i = 0; i < goods_manager_t::passengers->get_number_of_classes(); i++)
+	{
+		FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const gb, commuter_targets[i])
+		{
+			gb->update_nearby_halts();
+		}
+
+		FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const gb, visitor_targets[i])
+		{
+			gb->update_nearby_halts();
+		}
+	}
+
+	FOR(fenwick_weighted_vector_tpl<gebaeude_t*>, const gb, mail_origins_and_targets)
+	{
+		gb->update_nearby_halts();
+	}
+
+	nearby_halts_generation = planquadrat_t::get_haltlist_generation();
+}
+
 void karte_t::add_to_waiting_list(ware_t ware, koord origin_pos)
 {
 #ifdef DISABLE_GLOBAL_WAITING_LIST
@@ -5761,6 +5950,96 @@ void karte_t::deposit_ware_at_destination(ware_t ware)
 	}
 }
 
+void karte_t::book_generated(generated_statistic_t::type_t type, uint32 amount, stadt_t *city, uint8 history_type, stadt_t *other_city)
+{
+	generated_statistic_t stat(type, amount);
+	stat.city = city;
+	stat.index = history_type;
+	stat.other_city = other_city;
+	book_generated(stat);
+}
+
+void karte_t::book_generated(generated_statistic_t::type_t type, uint32 amount, gebaeude_t *building)
+{
+	generated_statistic_t stat(type, amount);
+	stat.building = building;
+	book_generated(stat);
+}
+
+void karte_t::book_generated(generated_statistic_t::type_t type, uint32 amount, fabrik_t *fab)
+{
+	generated_statistic_t stat(type, amount);
+	stat.fab = fab;
+	book_generated(stat);
+}
+
+void karte_t::book_generated(generated_statistic_t::type_t type, uint32 amount, halthandle_t halt)
+{
+	generated_statistic_t stat(type, amount);
+	stat.halt = halt;
+	book_generated(stat);
+}
+
+void karte_t::book_generated_destination(stadt_t *city, koord pos, PIXVAL colour)
+{
+	generated_statistic_t stat(generated_statistic_t::city_destination, 0);
+	stat.city = city;
+	stat.pos = pos;
+	stat.colour = colour;
+	book_generated(stat);
+}
+
+void karte_t::book_generated_debug_sum(uint8 num, uint32 val)
+{
+	generated_statistic_t stat(generated_statistic_t::debug_sum, val);
+	stat.index = num;
+	book_generated(stat);
+}
+
+void karte_t::book_generated(const generated_statistic_t &stat)
+{
+#ifdef MULTI_THREAD_PASSENGER_GENERATION
+	// Decided only by the thread itself: the worker threads never apply their statistics directly.
+	if (passenger_generation_thread_number > 0)
+	{
+		passenger_thread_outputs[passenger_generation_thread_number].statistics.append(stat);
+		return;
+	}
+#endif
+	apply_generated(stat);
+}
+
+void karte_t::apply_generated(const generated_statistic_t &stat)
+{
+	// Only the main thread may change the statistics.
+	assert(passenger_generation_thread_number == 0);
+	switch (stat.type)
+	{
+		case generated_statistic_t::city_generated:        stat.city->set_generated_passengers(stat.amount, stat.index); break;
+		case generated_statistic_t::city_private_car_trip: stat.city->set_private_car_trip(stat.amount, stat.other_city); break;
+		case generated_statistic_t::city_walked:           stat.city->add_walking_passengers(stat.amount); break;
+		case generated_statistic_t::city_mail_transported: stat.city->add_transported_mail(stat.amount); break;
+		case generated_statistic_t::city_destination:      stat.city->merke_passagier_ziel(stat.pos, stat.colour); break;
+
+		case generated_statistic_t::building_commuting_generated: stat.building->add_passengers_generated_commuting(stat.amount); break;
+		case generated_statistic_t::building_commuting_succeeded: stat.building->add_passengers_succeeded_commuting(stat.amount); break;
+		case generated_statistic_t::building_visiting_generated:  stat.building->add_passengers_generated_visiting(stat.amount); break;
+		case generated_statistic_t::building_visiting_succeeded:  stat.building->add_passengers_succeeded_visiting(stat.amount); break;
+		case generated_statistic_t::building_mail_generated:      stat.building->add_mail_generated(stat.amount); break;
+		case generated_statistic_t::building_mail_succeeded:      stat.building->add_mail_delivery_succeeded(stat.amount); break;
+
+		case generated_statistic_t::factory_mail_departed: stat.fab->book_stat(stat.amount, FAB_MAIL_DEPARTED); break;
+
+		// halts may have been removed in the meantime
+		case generated_statistic_t::halt_unhappy:       if (stat.halt.is_bound()) { stat.halt->add_pax_unhappy(stat.amount); } break;
+		case generated_statistic_t::halt_too_slow:      if (stat.halt.is_bound()) { stat.halt->add_pax_too_slow(stat.amount); } break;
+		case generated_statistic_t::halt_no_route:      if (stat.halt.is_bound()) { stat.halt->add_pax_no_route(stat.amount); } break;
+		case generated_statistic_t::halt_mail_no_route: if (stat.halt.is_bound()) { stat.halt->add_mail_no_route(stat.amount); } break;
+
+		case generated_statistic_t::debug_sum: add_to_debug_sums(stat.index, stat.amount); break;
+	}
+}
+
 sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 {
 	const city_cost history_type = (wtyp == goods_manager_t::passengers) ? HIST_PAS_TRANSPORTED : HIST_MAIL_TRANSPORTED;
@@ -5789,22 +6068,11 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 	{
 		// Mail is generated in non-city buildings such as attractions.
 		// That will be the only legitimate case in which this condition is not fulfilled.
-#ifdef MULTI_THREAD
-		int mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-		assert(mutex_error == 0);
-		(void)mutex_error;
-#endif
-		city->set_generated_passengers(units_this_step, history_type + 1);
-		add_to_debug_sums(5, units_this_step);
-#ifdef MULTI_THREAD
-		mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-		assert(mutex_error == 0);
-		(void)mutex_error;
-#endif
+		book_generated(generated_statistic_t::city_generated, units_this_step, city, history_type + 1);
+		book_generated_debug_sum(5, units_this_step);
 	}
 
 	koord3d origin_pos = gb->get_pos();
-	minivec_tpl<const planquadrat_t*> const &tile_list = first_origin->get_tiles();
 
 	// Suitable start search (public transport)
 #ifdef MULTI_THREAD
@@ -5813,11 +6081,10 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 	start_halts.clear();
 #endif
 
-	//vector_tpl<nearby_halt_t> start_halts(tile_list.empty() ? 0 : tile_list[0]->get_haltlist_count() * tile_list.get_count());
 #ifdef MULTI_THREAD
-	get_nearby_halts_of_tiles(tile_list, wtyp, start_halts[passenger_generation_thread_number]);
+	get_nearby_halts_of_building(first_origin, wtyp, start_halts[passenger_generation_thread_number]);
 #else
-	get_nearby_halts_of_tiles(tile_list, wtyp, start_halts);
+	get_nearby_halts_of_building(first_origin, wtyp, start_halts);
 #endif
 
 	// Initialise the class out of the loop, as the passengers remain the same class no matter what their trip.
@@ -5968,17 +6235,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			// Added here as the original journey had its generated passengers set much earlier, outside the for loop.
 			if(city)
 			{
-#ifdef MULTI_THREAD
-				int mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-				(void)mutex_error;
-#endif
-				city->set_generated_passengers(units_this_step, history_type + 1);
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-				(void)mutex_error;
-#endif
+				book_generated(generated_statistic_t::city_generated, units_this_step, city, history_type + 1);
 			}
 
 			if(route_status != private_car)
@@ -5993,15 +6250,13 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			// TODO BG, 15.02.2014: first build a nearby_destination_list and then a destination_list from it.
 			//  Should be faster than finding all nearby halts again.
 
-			minivec_tpl<const planquadrat_t*> const &tile_list_2 = first_origin->get_tiles();
-
 			// Suitable start search (public transport)
 #ifdef MULTI_THREAD
 			start_halts[passenger_generation_thread_number].clear();
-			get_nearby_halts_of_tiles(tile_list_2, wtyp, start_halts[passenger_generation_thread_number]);
+			get_nearby_halts_of_building(first_origin, wtyp, start_halts[passenger_generation_thread_number]);
 #else
 			start_halts.clear();
-			get_nearby_halts_of_tiles(tile_list_2, wtyp, start_halts);
+			get_nearby_halts_of_building(first_origin, wtyp, start_halts);
 #endif
 		}
 
@@ -6022,46 +6277,17 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 
 		if(trip == commuting_trip)
 		{
-#ifdef MULTI_THREAD
-			int mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-			(void)mutex_error;
-#endif
-			first_origin->add_passengers_generated_commuting(units_this_step);
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-			(void)mutex_error;
-#endif
+			book_generated(generated_statistic_t::building_commuting_generated, units_this_step, first_origin);
 		}
 
 		else if(trip == visiting_trip)
 		{
-#ifdef MULTI_THREAD
-			int mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-			(void)mutex_error;
-#endif
-			first_origin->add_passengers_generated_visiting(units_this_step);
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-			(void)mutex_error;
-#endif
+			book_generated(generated_statistic_t::building_visiting_generated, units_this_step, first_origin);
 		}
 
 		else if (trip == mail_trip)
 		{
-#ifdef MULTI_THREAD
-			int mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-			(void)mutex_error;
-#endif
-			first_origin->add_mail_generated(units_this_step);
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
+			book_generated(generated_statistic_t::building_mail_generated, units_this_step, first_origin);
 		}
 
 		/**
@@ -6247,6 +6473,21 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 						destination_list[passenger_generation_thread_number].append(halt);
 #else
 						destination_list.append(halt);
+#endif
+					}
+				}
+			}
+			else if (const vector_tpl<nearby_halt_t>* nearby_halts = current_destination.building->get_nearby_halts())
+			{
+				FOR(vector_tpl<nearby_halt_t>, const& nearby_halt, *nearby_halts)
+				{
+					halthandle_t halt = nearby_halt.halt;
+					if ((trip == mail_trip && halt->get_mail_enabled()) || (trip != mail_trip && halt->get_pax_enabled()))
+					{
+#ifdef MULTI_THREAD
+						destination_list[passenger_generation_thread_number].append(halt);
+#else
+						destination_list.append(halt);
 #endif
 					}
 				}
@@ -6319,28 +6560,32 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 				uint32 best_start_halt = 0;
 				uint32 best_journey_time_including_crowded_halts = UINT32_MAX_VALUE;
 
-				sint32 i = 0;
-
-
 #ifdef MULTI_THREAD
-				FOR(vector_tpl<nearby_halt_t>, const& nearby_halt, start_halts[passenger_generation_thread_number])
+				const vector_tpl<nearby_halt_t> &nearby_start_halts = start_halts[passenger_generation_thread_number];
+				const vector_tpl<halthandle_t> &destination_halts = destination_list[passenger_generation_thread_number];
 #else
-				FOR(vector_tpl<nearby_halt_t>, const& nearby_halt, start_halts)
-#endif
+				const vector_tpl<nearby_halt_t> &nearby_start_halts = start_halts;
+				const vector_tpl<halthandle_t> &destination_halts = destination_list;
+#endif
+
+				// Look up the routes from all the start halts to all the destination halts at once:
+				// the walking times from the destination halts are the same for every start halt.
+				// Start halts which cannot be used whatever the routes are left unbound.
+				static thread_local vector_tpl<uint32> destination_times;
+				static thread_local vector_tpl<halthandle_t> route_origins;
+				static thread_local vector_tpl<path_explorer_t::route_t> routes;
+				haltestelle_t::get_destination_times(destination_halts, pax, destination_pos, destination_times);
+				route_origins.clear();
+				routes.clear();
+				FOR(vector_tpl<nearby_halt_t>, const& nearby_halt, nearby_start_halts)
 				{
-					current_halt = nearby_halt.halt;
-
-#ifdef MULTI_THREAD
 					// Start with the walking time to the start halt.
-					// Note that the walking time to the destination stop is already added by find_route.
-					current_journey_time = walking_time_tenths_from_distance(start_halts[passenger_generation_thread_number].get_element(i).distance);
-
-#else
-					current_journey_time = walking_time_tenths_from_distance(start_halts[i].distance);
-#endif
-					if (current_journey_time < best_journey_time && (current_journey_time < walking_time || !can_walk) && current_journey_time < tolerance)
+					// Note that the walking time to the destination stop is already in the routes.
+					current_journey_time = walking_time_tenths_from_distance(nearby_halt.distance);
+					halthandle_t origin;
+					if ((current_journey_time < walking_time || !can_walk) && current_journey_time < tolerance)
 					{
-						// Do not hit the database with a request if even walking to the local stop takes longer than the tolerance time, is worse than the best journey time, is worse than simply walking to the destination
+						// Do not hit the database with a request if even walking to the local stop takes longer than the tolerance time, is worse than simply walking to the destination
 						// or if the impicit speed taking into account the time taken to walk to the origin stop.
 						const uint32 distance_this_origin_to_destination = shortest_distance(nearby_halt.halt->get_basis_pos(), current_destination.location);
 						const uint32 distance_this_origin_to_destination_km = (distance_this_origin_to_destination * get_settings().get_meters_per_tile()) / 1000u;
@@ -6348,21 +6593,29 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 
 						if(!((tolerance > settings.get_min_wait_airport() && origin_stop_specific_implicit_minimum_speed_kmh > max_convoy_speed_air) || origin_stop_specific_implicit_minimum_speed_kmh > max_convoy_speed_ground))
 						{
-#ifdef MULTI_THREAD
-							const uint32 public_transport_journey_time = current_halt->find_route(destination_list[passenger_generation_thread_number], pax, best_journey_time, destination_pos);
-#else
-							const uint32 public_transport_journey_time = current_halt->find_route(destination_list, pax, best_journey_time, destination_pos);
-#endif
-							if (public_transport_journey_time < UINT32_MAX_VALUE)
+							origin = nearby_halt.halt;
+						}
+					}
+					route_origins.append(origin);
+					routes.append(path_explorer_t::route_t());
+				}
+				path_explorer_t::get_catg_paths(pax.get_desc()->get_catg_index(), pax.g_class, route_origins.begin(), route_origins.get_count(), destination_halts, destination_times, routes.begin());
+
+				sint32 i = 0;
+
+				FOR(vector_tpl<nearby_halt_t>, const& nearby_halt, nearby_start_halts)
+				{
+					current_halt = nearby_halt.halt;
+					current_journey_time = walking_time_tenths_from_distance(nearby_halt.distance);
+
+					if (current_journey_time < best_journey_time && route_origins[i].is_bound())
+					{
+						const uint32 public_transport_journey_time = routes[i].apply_to(pax, best_journey_time);
+						if (public_transport_journey_time < UINT32_MAX_VALUE)
+						{
+							if (public_transport_journey_time < (UINT32_MAX_VALUE - current_journey_time))
 							{
-								if (public_transport_journey_time < (UINT32_MAX_VALUE - current_journey_time))
-								{
-									current_journey_time += public_transport_journey_time;
-								}
-								else
-								{
-									current_journey_time = UINT32_MAX_VALUE;
-								}
+								current_journey_time += public_transport_journey_time;
 							}
 							else
 							{
@@ -6614,19 +6867,10 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 		bool set_return_trip = false;
 		stadt_t* destination_town;
 
-#ifdef MULTI_THREAD
-		int mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-		assert(mutex_error == 0);
-		(void)mutex_error;
-#endif
 
 		switch(route_status)
 		{
 		case public_transport:
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
 			if(tolerance < UINT32_MAX_VALUE)
 			{
 				tolerance -= best_journey_time;
@@ -6634,13 +6878,9 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			}
 			pax.set_origin(start_halt);
 			start_halt->starte_mit_route(pax, origin_pos.get_2d());
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
 			if(city && wtyp == goods_manager_t::passengers)
 			{
-				city->merke_passagier_ziel(destination_pos, color_idx_to_rgb(MAP_COL_HAPPY));
+				book_generated_destination(city, destination_pos, color_idx_to_rgb(MAP_COL_HAPPY));
 			}
 			set_return_trip = true;
 			// create pedestrians in the near area?
@@ -6652,7 +6892,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			// However, as for the destination, this can be set when the passengers arrive.
 			if(trip == commuting_trip && first_origin)
 			{
-				first_origin->add_passengers_succeeded_commuting(units_this_step);
+				book_generated(generated_statistic_t::building_commuting_succeeded, units_this_step, first_origin);
 #ifdef DEBUG_MARCHETTI_CONSTANT
 				if (trip_count == 0)
 				{
@@ -6667,7 +6907,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			}
 			else if(trip == visiting_trip && first_origin)
 			{
-				first_origin->add_passengers_succeeded_visiting(units_this_step);
+				book_generated(generated_statistic_t::building_visiting_succeeded, units_this_step, first_origin);
 #ifdef DEBUG_MARCHETTI_CONSTANT
 				if (trip_count == 0)
 				{
@@ -6682,7 +6922,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			}
 			else if (trip == mail_trip && first_origin)
 			{
-				first_origin->add_mail_delivery_succeeded(units_this_step);
+				book_generated(generated_statistic_t::building_mail_succeeded, units_this_step, first_origin);
 			}
 		break;
 
@@ -6702,13 +6942,13 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 				city->generate_private_cars(origin_pos.get_2d(), car_minutes, adjusted_destination_pos, units_this_step);
 				if(wtyp == goods_manager_t::passengers)
 				{
-					city->set_private_car_trip(units_this_step, destination_town);
-					city->merke_passagier_ziel(destination_pos, color_idx_to_rgb(MAP_COL_PRIVATECAR));
+					book_generated(generated_statistic_t::city_private_car_trip, units_this_step, city, 0, destination_town);
+					book_generated_destination(city, destination_pos, color_idx_to_rgb(MAP_COL_PRIVATECAR));
 				}
 				else
 				{
 					// Mail
-					city->add_transported_mail(units_this_step);
+					book_generated(generated_statistic_t::city_mail_transported, units_this_step, city);
 				}
 			}
 
@@ -6717,7 +6957,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			// We cannot do this on arrival, as the ware packets do not remember their origin building.
 			if(trip == commuting_trip)
 			{
-				first_origin->add_passengers_succeeded_commuting(units_this_step);
+				book_generated(generated_statistic_t::building_commuting_succeeded, units_this_step, first_origin);
 #ifdef DEBUG_MARCHETTI_CONSTANT
 				if (trip_count == 0)
 				{
@@ -6732,7 +6972,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			}
 			else if(trip == visiting_trip)
 			{
-				first_origin->add_passengers_succeeded_visiting(units_this_step);
+				book_generated(generated_statistic_t::building_visiting_succeeded, units_this_step, first_origin);
 #ifdef DEBUG_MARCHETTI_CONSTANT
 				if (trip_count == 0)
 				{
@@ -6747,17 +6987,9 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			}
 			else if(trip == mail_trip)
 			{
-				first_origin->add_mail_delivery_succeeded(units_this_step);
+				book_generated(generated_statistic_t::building_mail_succeeded, units_this_step, first_origin);
 			}
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
 			add_to_waiting_list(pax, origin_pos.get_2d());
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
 			break;
 
 		case on_foot:
@@ -6781,13 +7013,13 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			{
 				if(wtyp == goods_manager_t::passengers)
 				{
-					city->merke_passagier_ziel(destination_pos, color_idx_to_rgb(MAP_COL_WALKED));
-					city->add_walking_passengers(units_this_step);
+					book_generated_destination(city, destination_pos, color_idx_to_rgb(MAP_COL_WALKED));
+					book_generated(generated_statistic_t::city_walked, units_this_step, city);
 				}
 				else
 				{
 					// Mail
-					city->add_transported_mail(units_this_step);
+					book_generated(generated_statistic_t::city_mail_transported, units_this_step, city);
 				}
 			}
 			set_return_trip = true;
@@ -6795,7 +7027,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			// We cannot do this on arrival, as the ware packets do not remember their origin building.
 			if(trip == commuting_trip)
 			{
-				first_origin->add_passengers_succeeded_commuting(units_this_step);
+				book_generated(generated_statistic_t::building_commuting_succeeded, units_this_step, first_origin);
 #ifdef DEBUG_MARCHETTI_CONSTANT
 				if (trip_count == 0)
 				{
@@ -6810,7 +7042,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			}
 			else if(trip == visiting_trip)
 			{
-				first_origin->add_passengers_succeeded_visiting(units_this_step);
+				book_generated(generated_statistic_t::building_visiting_succeeded, units_this_step, first_origin);
 #ifdef DEBUG_MARCHETTI_CONSTANT
 				if (trip_count == 0)
 				{
@@ -6825,28 +7057,17 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			}
 			else if (trip == mail_trip)
 			{
-				first_origin->add_mail_delivery_succeeded(units_this_step);
+				book_generated(generated_statistic_t::building_mail_succeeded, units_this_step, first_origin);
 			}
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-
-			// Prevent deadlocks because of double-locking:
-			// there is already a mutex lock in the add_to_waiting_list
-#endif
 			add_to_waiting_list(pax, origin_pos.get_2d());
 			// Do nothing if trip == mail.
-#ifdef MULTI_THREAD
-			mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-			assert(mutex_error == 0);
-#endif
 			break;
 
 		case overcrowded:
 
 			if(city && wtyp == goods_manager_t::passengers)
 			{
-				city->merke_passagier_ziel(best_bad_destination, color_idx_to_rgb(MAP_COL_OVERCROWDED));
+				book_generated_destination(city, best_bad_destination, color_idx_to_rgb(MAP_COL_OVERCROWDED));
 			}
 #ifdef MULTI_THREAD
 			if(start_halts[passenger_generation_thread_number].get_count() > 0)
@@ -6859,7 +7080,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 #endif
 				if(start_halt.is_bound())
 				{
-					start_halt->add_pax_unhappy(units_this_step);
+					book_generated(generated_statistic_t::halt_unhappy, units_this_step, start_halt);
 				}
 			}
 
@@ -6870,11 +7091,11 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 			{
 				if(car_minutes >= best_journey_time && best_journey_time < UINT32_MAX_VALUE)
 				{
-					city->merke_passagier_ziel(best_bad_destination, color_idx_to_rgb(MAP_COL_TOO_SLOW));
+					book_generated_destination(city, best_bad_destination, color_idx_to_rgb(MAP_COL_TOO_SLOW));
 				}
 				else if(car_minutes < UINT32_MAX_VALUE)
 				{
-					city->merke_passagier_ziel(best_bad_destination, color_idx_to_rgb(MAP_COL_TOO_SLOW_USE_PRIVATECAR));
+					book_generated_destination(city, best_bad_destination, color_idx_to_rgb(MAP_COL_TOO_SLOW_USE_PRIVATECAR));
 				}
 				else
 				{
@@ -6897,7 +7118,7 @@ sint32 karte_t::generate_passengers_or_mail(const goods_desc_t * wtyp)
 #endif
 			if(start_halt.is_bound() && best_journey_time < UINT32_MAX_VALUE)
 			{
-				start_halt->add_pax_too_slow(units_this_step);
+				book_generated(generated_statistic_t::halt_too_slow, units_this_step, start_halt);
 			}
 			break;
 
@@ -6909,11 +7130,11 @@ no_route:
 			{
 				if(route_status == destination_unavailable)
 				{
-					city->merke_passagier_ziel(first_destination.location, color_idx_to_rgb(MAP_COL_UNAVAILABLE));
+					book_generated_destination(city, first_destination.location, color_idx_to_rgb(MAP_COL_UNAVAILABLE));
 				}
 				else
 				{
-					city->merke_passagier_ziel(first_destination.location, color_idx_to_rgb(MAP_COL_NOROUTE));
+					book_generated_destination(city, first_destination.location, color_idx_to_rgb(MAP_COL_NOROUTE));
 				}
 			}
 #ifdef MULTI_THREAD
@@ -6929,20 +7150,16 @@ no_route:
 				{
 					if (trip == mail_trip)
 					{
-						start_halt->add_mail_no_route(units_this_step);
+						book_generated(generated_statistic_t::halt_mail_no_route, units_this_step, start_halt);
 					}
 					else
 					{
-						start_halt->add_pax_no_route(units_this_step);
+						book_generated(generated_statistic_t::halt_no_route, units_this_step, start_halt);
 					}
 				}
 			}
 		};
 
-#ifdef MULTI_THREAD
-		mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-		assert(mutex_error == 0);
-#endif
 #ifdef FORBID_RETURN_TRIPS
 		if(false)
 #else
@@ -6961,29 +7178,13 @@ no_route:
 			if(destination_town)
 			{
 #ifndef FORBID_SET_GENERATED_PASSENGERS
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
-				destination_town->set_generated_passengers(units_this_step, history_type + 1);
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
+				book_generated(generated_statistic_t::city_generated, units_this_step, destination_town, history_type + 1);
 #endif
 			}
 			else if(city)
 			{
 #ifndef FORBID_SET_GENERATED_PASSENGERS
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
-				city->set_generated_passengers(units_this_step, history_type + 1);
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
+				book_generated(generated_statistic_t::city_generated, units_this_step, city, history_type + 1);
 #endif
 				// Cannot add success figures for buildings here as cannot get a building from a koord.
 				// However, this should not matter much, as equally not recording generated passengers
@@ -7094,18 +7295,10 @@ no_route:
 								// This is somewhat anomalous, as we are recording that the passengers have departed, not arrived, whereas for cities, we record
 								// that they have successfully arrived. However, this is not easy to implement for factories, as passengers do not store their ultimate
 								// origin, so the origin factory is not known by the time that the passengers reach the end of their journey.
-#ifdef MULTI_THREAD
-								mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-								assert(mutex_error == 0);
-#endif
 								if (trip == mail_trip)
 								{
-									current_destination.building->get_fabrik()->book_stat(units_this_step, FAB_MAIL_DEPARTED);
+									book_generated(generated_statistic_t::factory_mail_departed, units_this_step, current_destination.building->get_fabrik());
 								}
-#ifdef MULTI_THREAD
-								mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-								assert(mutex_error == 0);
-#endif
 							}
 						}
 						else
@@ -7117,15 +7310,7 @@ no_route:
 							}
 							else
 							{
-#ifdef MULTI_THREAD
-								mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-								assert(mutex_error == 0);
-#endif
-								ret_halt->add_pax_unhappy(units_this_step);
-#ifdef MULTI_THREAD
-								mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-								assert(mutex_error == 0);
-#endif
+								book_generated(generated_statistic_t::halt_unhappy, units_this_step, ret_halt);
 							}
 						}
 					}
@@ -7140,25 +7325,13 @@ no_route:
 					}
 					else
 					{
-#ifdef MULTI_THREAD
-						mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-						assert(mutex_error == 0);
-#endif
-						ret_halt->add_pax_no_route(units_this_step);
-#ifdef MULTI_THREAD
-						mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-						assert(mutex_error == 0);
-#endif
+						book_generated(generated_statistic_t::halt_no_route, units_this_step, ret_halt);
 					}
 				}
 			}
 
 			if(return_in_private_car)
 			{
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
 				if(car_minutes < UINT32_MAX_VALUE)
 				{
 					// Do not check tolerance, as they must come back!
@@ -7166,12 +7339,12 @@ no_route:
 					{
 						if(destination_town)
 						{
-							destination_town->set_private_car_trip(units_this_step, city);
+							book_generated(generated_statistic_t::city_private_car_trip, units_this_step, destination_town, 0, city);
 						}
 						else
 						{
 							// Industry, attraction or local
-							city->set_private_car_trip(units_this_step, NULL);
+							book_generated(generated_statistic_t::city_private_car_trip, units_this_step, city, 0, NULL);
 						}
 					}
 					else
@@ -7179,11 +7352,11 @@ no_route:
 						// Mail
 						if(destination_town)
 						{
-							destination_town->add_transported_mail(units_this_step);
+							book_generated(generated_statistic_t::city_mail_transported, units_this_step, destination_town);
 						}
 						else if(city)
 						{
-							city->add_transported_mail(units_this_step);
+							book_generated(generated_statistic_t::city_mail_transported, units_this_step, city);
 						}
 					}
 					const grund_t* gr_origin = lookup(origin_pos);
@@ -7200,32 +7373,24 @@ no_route:
 					city->generate_private_cars(current_destination.location, car_minutes, adjusted_return_pos, units_this_step);
 					if(current_destination.type == factory && trip == mail_trip)
 					{
-						current_destination.building->get_fabrik()->book_stat(units_this_step, FAB_MAIL_DEPARTED);
+						book_generated(generated_statistic_t::factory_mail_departed, units_this_step, current_destination.building->get_fabrik());
 					}
 				}
 				else
 				{
 					if(ret_halt.is_bound())
 					{
-						ret_halt->add_pax_no_route(units_this_step);
+						book_generated(generated_statistic_t::halt_no_route, units_this_step, ret_halt);
 					}
 					if(city)
 					{
-						city->merke_passagier_ziel(origin_pos.get_2d(), color_idx_to_rgb(MAP_COL_NOROUTE));
+						book_generated_destination(city, origin_pos.get_2d(), color_idx_to_rgb(MAP_COL_NOROUTE));
 					}
 				}
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
 			}
 return_on_foot:
 			if(return_on_foot)
 			{
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_lock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
 				if(wtyp == goods_manager_t::passengers)
 				{
 					if (settings.get_random_pedestrians())
@@ -7238,13 +7403,13 @@ return_on_foot:
 					}
 					if(destination_town)
 					{
-						destination_town->add_walking_passengers(units_this_step);
+						book_generated(generated_statistic_t::city_walked, units_this_step, destination_town);
 					}
 					else if(city)
 					{
 						// Local, attraction or industry.
-						city->merke_passagier_ziel(origin_pos.get_2d(), color_idx_to_rgb(MAP_COL_WALKED));
-						city->add_walking_passengers(units_this_step);
+						book_generated_destination(city, origin_pos.get_2d(), color_idx_to_rgb(MAP_COL_WALKED));
+						book_generated(generated_statistic_t::city_walked, units_this_step, city);
 					}
 				}
 				else
@@ -7252,21 +7417,17 @@ return_on_foot:
 					// Mail
 					if(destination_town)
 					{
-						destination_town->add_transported_mail(units_this_step);
+						book_generated(generated_statistic_t::city_mail_transported, units_this_step, destination_town);
 					}
 					else if(city)
 					{
-						city->add_transported_mail(units_this_step);
+						book_generated(generated_statistic_t::city_mail_transported, units_this_step, city);
 					}
 				}
 				if(current_destination.type == factory && trip == mail_trip)
 				{
-					current_destination.building->get_fabrik()->book_stat(units_this_step, FAB_MAIL_DEPARTED);
+					book_generated(generated_statistic_t::factory_mail_departed, units_this_step, current_destination.building->get_fabrik());
 				}
-#ifdef MULTI_THREAD
-				mutex_error = pthread_mutex_unlock(&karte_t::step_passengers_and_mail_mutex);
-				assert(mutex_error == 0);
-#endif
 			}
 
 		} // Set return trip
@@ -7896,6 +8057,90 @@ DBG_MESSAGE("karte_t::save()", "saving game to '%s'", filename);
 }
 
 
+bool karte_t::save_snapshot(std::string &snapshot, const char *version_str, const char *ex_version_str, const char* ex_revision_str)
+{
+DBG_MESSAGE("karte_t::save_snapshot()", "saving game to memory");
+	loadsave_t file;
+	if(  file.wr_open_memory( snapshot, env_t::objfilename.c_str(), version_str, ex_version_str, ex_revision_str ) != loadsave_t::FILE_STATUS_OK  ) {
+		dbg->error("karte_t::save_snapshot()", "cannot save game to memory");
+		return false;
+	}
+	save( &file, true );
+	const char *err = file.close();
+	reset_interaction();
+	if(  err  ) {
+		dbg->error("karte_t::save_snapshot()", "error during saving: %s", err);
+		return false;
+	}
+	return true;
+}
+
+
+bool karte_t::in_background_save = false;
+
+
+bool karte_t::save_in_background(const char *filename, const char *version_str, const char *ex_version_str, const char* ex_revision_str)
+{
+	check_background_save(false);
+	if(  background_save_id > 0  ||  nosave_warning  ) {
+		// rotating the map for saving cannot be done in the copy
+		return false;
+	}
+#ifdef MULTI_THREAD
+	// the worker threads do not exist in the copy, so they must be idle now
+	await_all_threads();
+#endif
+
+	const int id = dr_fork_background();
+	if(  id < 0  ) {
+		return false;
+	}
+	if(  id > 0  ) {
+DBG_MESSAGE("karte_t::save_in_background()", "saving game to '%s' in process %d", filename, id);
+		background_save_id = id;
+		return true;
+	}
+
+	// from here on in the copy
+	in_background_save = true;
+	intr_disable();
+
+	std::string savename = filename;
+	savename[savename.length() - 1] = '_';
+
+	bool ok = false;
+	loadsave_t file;
+	if(  file.wr_open( savename.c_str(), loadsave_t::autosave_mode, loadsave_t::autosave_level, env_t::objfilename.c_str(), version_str, ex_version_str, ex_revision_str ) == loadsave_t::FILE_STATUS_OK  ) {
+		save( &file, true );
+		const char *err = file.close();
+		if(  err  ) {
+			dbg->error( "karte_t::save_in_background()", "error during saving: %s", err );
+		}
+		else {
+			ok = dr_rename( savename.c_str(), filename ) == 0;
+		}
+	}
+	dr_exit_background( ok ? 0 : 1 );
+	return true; // never reached
+}
+
+
+void karte_t::check_background_save(bool wait)
+{
+	if(  background_save_id <= 0  ) {
+		return;
+	}
+	const int status = dr_check_background( background_save_id, wait );
+	if(  status >= 0  ) {
+		background_save_id = -1;
+		if(  status != 0  ) {
+			dbg->error( "karte_t::check_background_save()", "saving in the background failed with %d", status );
+			create_win( new news_img("Kann Spielstand\nnicht speichern.\n"), w_info, magic_none );
+		}
+	}
+}
+
+
 void karte_t::save(loadsave_t *file, bool silent)
 {
 	bool needs_redraw = false;
@@ -7906,8 +8151,13 @@ DBG_MESSAGE("karte_t::save(loadsave_t *file)", "start");
 		ls = new loadingscreen_t( translator::translate("Saving map ..."), get_size().y );
 	}
 #ifdef MULTI_THREAD
-	await_all_threads();
+	if(  !in_background_save  ) {
+		await_all_threads();
+	}
 #endif
+	// routes found since the last step would otherwise be missing from the file
+	weg_t::merge_private_car_routes();
+
 	// rotate the map until it can be saved completely
 	for( int i=0;  i<4  &&  nosave_warning;  i++  ) {
 		rotate90();
@@ -8207,10 +8457,23 @@ DBG_MESSAGE("karte_t::save(loadsave_t *file)", "motd filename %s", env_t::server
 
 	if (file->get_extended_version() >= 15 || (file->get_extended_version() == 14 && file->get_extended_revision() >= 35))
 	{
-		uint32 count = cities_awaiting_private_car_route_check.get_count();
+		// Cities handed to a thread but not checked yet are queued first again
+		vector_tpl<stadt_t*> cities;
+		for (auto city : cities_checking_private_car_routes)
+		{
+			if (city)
+			{
+				cities.append(city);
+			}
+		}
+		for (auto city : cities_awaiting_private_car_route_check)
+		{
+			cities.append(city);
+		}
+		uint32 count = cities.get_count();
 		file->rdwr_long(count);
 
-		for (auto city : cities_awaiting_private_car_route_check)
+		for (auto city : cities)
 		{
 			koord location = city->get_pos();
 			location.rdwr(file);
@@ -8553,6 +8816,7 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 		old_blockmanager_t::rdwr(this, file);
 	}
 
+	weg_t::private_car_routes_start_rdwr();
 	if (file->is_loading()) {
 		DBG_MESSAGE("karte_t::load()","loading tiles");
 		for (int y = 0; y < get_size().y; y++) {
@@ -8587,6 +8851,7 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 		DBG_MESSAGE("karte_t::save(loadsave_t *file)", "saved hgt");
 		}
 	}
+	weg_t::private_car_routes_finish_rdwr(file);
 
 
 	if (file->is_loading()) {
@@ -8769,6 +9034,13 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 				ls->set_progress( get_size().y+(get_size().y*convoi_array.get_count())/(2*max_convoi)+128 );
 			}
 		}
+
+		// the ways were loaded before the convoys which reserved them
+		FOR(vector_tpl<weg_t*>, const w, weg_t::get_alle_wege()) {
+			if(  w->is_rail_type()  ||  w->get_waytype() == air_wt  ) {
+				((schiene_t *)w)->register_reservation();
+			}
+		}
 DBG_MESSAGE("karte_t::load()", "%d convois/trains loaded", convoi_array.get_count());
 	}
 	else {
@@ -8870,7 +9142,7 @@ void karte_t::switch_server( bool start_server, bool port_forwarding )
 
 // LOAD, not save
 // just the preliminaries, opens the file, checks the versions ...
-bool karte_t::load(const char *filename)
+bool karte_t::load(const char *filename, const std::string *snapshot)
 {
 	dbg->message("karte_t::load", "suspending private car threads");
 #ifdef MULTI_THREAD
@@ -8950,7 +9222,7 @@ bool karte_t::load(const char *filename)
 		name.append(filename);
 	}
 
-	if(file.rd_open(name) != loadsave_t::FILE_STATUS_OK) {
+	if(  (snapshot ? file.rd_open_memory(*snapshot) : file.rd_open(name)) != loadsave_t::FILE_STATUS_OK  ) {
 
 		if(file.get_version_int() == 0 || file.get_version_int() > loadsave_t::int_version(env_t::savegame_version_str, NULL).version) {
 			dbg->warning("karte_t::load()", translator::translate("WRONGSAVE") );
@@ -9336,6 +9608,11 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 		}
 	}
 
+	// now the lines know their convoys
+	FOR(vector_tpl<halthandle_t>, const i, haltestelle_t::get_alle_haltestellen()) {
+		i->calc_service_frequencies();
+	}
+
 
 #if 0
 	// reroute goods for benchmarking
@@ -11418,7 +11695,7 @@ void karte_t::update_weight_of_building_in_world_list(gebaeude_t *gb)
 
 void karte_t::remove_all_building_references_to_city(stadt_t* city)
 {
-	FOR(weighted_vector_tpl <gebaeude_t *>, building, passenger_origins)
+	FOR(fenwick_weighted_vector_tpl <gebaeude_t *>, building, passenger_origins)
 	{
 		if(building->get_stadt() == city)
 		{
@@ -11426,7 +11703,7 @@ void karte_t::remove_all_building_references_to_city(stadt_t* city)
 		}
 	}
 
-	FOR(weighted_vector_tpl <gebaeude_t *>, building, mail_origins_and_targets)
+	FOR(fenwick_weighted_vector_tpl <gebaeude_t *>, building, mail_origins_and_targets)
 	{
 		if(building->get_stadt() == city)
 		{
@@ -11436,7 +11713,7 @@ void karte_t::remove_all_building_references_to_city(stadt_t* city)
 
 	for (uint8 i = 0; i < goods_manager_t::passengers->get_number_of_classes(); i++)
 	{
-		FOR(weighted_vector_tpl <gebaeude_t *>, building, commuter_targets[i])
+		FOR(fenwick_weighted_vector_tpl <gebaeude_t *>, building, commuter_targets[i])
 		{
 			if (building->get_stadt() == city)
 			{
@@ -11444,7 +11721,7 @@ void karte_t::remove_all_building_references_to_city(stadt_t* city)
 			}
 		}
 
-		FOR(weighted_vector_tpl <gebaeude_t *>, building, visitor_targets[i])
+		FOR(fenwick_weighted_vector_tpl <gebaeude_t *>, building, visitor_targets[i])
 		{
 			if (building->get_stadt() == city)
 			{
@@ -15,6 +15,7 @@
 #include "halthandle_t.h"
 
 #include "tpl/weighted_vector_tpl.h"
+#include "tpl/fenwick_weighted_vector_tpl.h"
 #include "tpl/vector_tpl.h"
 #include "tpl/slist_tpl.h"
 #include "tpl/koordhashtable_tpl.h"
@@ -27,6 +28,7 @@
 #include "simware.h"
 #include "simplan.h"
 #include "simdebug.h"
+#include "simcolor.h"
 
 #include "utils/checklist.h"
 
@@ -77,9 +79,6 @@ class terraformer_t;
 #ifndef FORBID_MULTI_THREAD_PATH_EXPLORER
 #define MULTI_THREAD_PATH_EXPLORER
 #endif
-#ifndef FORBID_MULTI_THREAD_ROUTE_UNRESERVER
-#define MULTI_THREAD_ROUTE_UNRESERVER
-#endif
 #endif
 
 #ifndef FORBID_MULTI_THREAD_PASSENGER_GENERATION_IN_NETWORK_MODE
@@ -324,6 +323,18 @@ private:
 	bool nosave;
 	bool nosave_warning;
 
+	/// id of the copy of the process writing an autosave in the background, or -1
+	int background_save_id;
+
+	/// true in that copy, which has no worker threads and must not draw
+	static bool in_background_save;
+
+	/**
+	 * Checks whether the background save has ended, and reports errors.
+	 * @param wait if true, waits for it to end
+	 */
+	void check_background_save(bool wait);
+
 	/**
 	 * Water level height.
 	 */
@@ -747,6 +758,16 @@ private:
 
 	slist_tpl<stadt_t*> cities_awaiting_private_car_route_check;
 
+	/**
+	 * The city each private car thread is checking, or NULL. Only the main
+	 * thread hands out cities, in the order of the queue above, so which
+	 * city is checked in which step does not depend on thread timing.
+	 */
+	vector_tpl<stadt_t*> cities_checking_private_car_routes;
+
+	/// Hands queued cities to the idle private car threads with a number below max_cities
+	void assign_private_car_route_cities(sint32 max_cities);
+
 	/**
 	 * The last time when a server announce was performed (in ms).
 	 */
@@ -780,7 +801,7 @@ private:
 	 * journeys ultimately start, weighted by their level.
 	 * @author: jamespetts
 	 */
-	weighted_vector_tpl <gebaeude_t *> passenger_origins;
+	fenwick_weighted_vector_tpl <gebaeude_t *> passenger_origins;
 
 	/**
 	 * This contains all buildings in the world to which passengers make
@@ -788,7 +809,7 @@ private:
 	 * This is an array indexed by class.
 	 * @author: jamespetts
 	 */
-	weighted_vector_tpl <gebaeude_t *> *commuter_targets;
+	fenwick_weighted_vector_tpl <gebaeude_t *> *commuter_targets;
 
 	/**
 	 * This contains all buildings in the world to which passengers make
@@ -796,7 +817,7 @@ private:
 	 * This is an array indexed by class.
 	 * @author: jamespetts
 	 */
-	weighted_vector_tpl <gebaeude_t *> *visitor_targets;
+	fenwick_weighted_vector_tpl <gebaeude_t *> *visitor_targets;
 
 	/**
 	 * This contains all buildings in the world to and from which mail
@@ -804,7 +825,10 @@ private:
 	 * level.
 	 * @author: jamespetts
 	 */
-	weighted_vector_tpl <gebaeude_t *> mail_origins_and_targets;
+	fenwick_weighted_vector_tpl <gebaeude_t *> mail_origins_and_targets;
+
+	/// planquadrat_t::get_haltlist_generation() at the last update_nearby_halts_of_buildings()
+	uint32 nearby_halts_generation;
 
 	/** Stores the value of the next step for passenger/mail generation
 	 * purposes.
@@ -856,9 +880,8 @@ private:
 	bool private_car_threads_working;
 public:
 	static simthread_barrier_t step_convoys_barrier_external;
-	static simthread_barrier_t unreserve_route_barrier;
 	static simthread_barrier_t private_car_barrier;
-	static pthread_mutex_t unreserve_route_mutex;
+	static simthread_barrier_t path_explorer_workers_barrier;
 	static pthread_mutex_t step_passengers_and_mail_mutex;
 	static bool private_car_route_mutex_initialised;
 	static pthread_mutex_t private_car_route_mutex;
@@ -906,10 +929,10 @@ private:
 	static sint32 cities_to_process;
 #ifdef MULTI_THREAD
 	friend void *check_road_connexions_threaded(void* args);
-	friend void *unreserve_route_threaded(void* args);
 	friend void *step_passengers_and_mail_threaded(void* args);
 	friend void *step_convoys_threaded(void* args);
 	friend void *path_explorer_threaded(void* args);
+	friend void *path_explorer_worker_threaded(void* args);
 	friend void *step_individual_convoy_threaded(void* args);
 	static vector_tpl<convoihandle_t> convoys_next_step;
 	public:
@@ -956,6 +979,79 @@ public:
 	void inc_rands(uint8 num) { rands[num]++; }
 	inline void add_to_debug_sums(uint8 num, uint32 val) { debug_sums[num] += val; }
 
+	/**
+	 * A statistic booked by the passenger and mail generation. With threads, each
+	 * thread collects these in its own buffer, and the main thread books them in
+	 * thread order once all threads have finished, so the threads need not lock.
+	 */
+	struct generated_statistic_t
+	{
+		enum type_t {
+			city_generated = 0,            ///< stadt_t::set_generated_passengers(), index is the history type
+			city_private_car_trip,         ///< stadt_t::set_private_car_trip() to other_city
+			city_walked,
+			city_mail_transported,
+			city_destination,              ///< stadt_t::merke_passagier_ziel() of pos in colour
+			building_commuting_generated,
+			building_commuting_succeeded,
+			building_visiting_generated,
+			building_visiting_succeeded,
+			building_mail_generated,
+			building_mail_succeeded,
+			factory_mail_departed,
+			halt_unhappy,
+			halt_too_slow,
+			halt_no_route,
+			halt_mail_no_route,
+			debug_sum                      ///< add_to_debug_sums(), index is the number of the sum
+		};
+
+		uint8 type;
+		uint8 index;
+		PIXVAL colour;
+		uint32 amount;
+		koord pos;
+		stadt_t *city;
+		stadt_t *other_city;
+		gebaeude_t *building;
+		fabrik_t *fab;
+		halthandle_t halt;
+
+		generated_statistic_t(type_t type, uint32 amount) :
+			type(type), index(0), colour(0), amount(amount), pos(koord::invalid),
+			city(NULL), other_city(NULL), building(NULL), fab(NULL)
+		{}
+
+		generated_statistic_t() : generated_statistic_t(debug_sum, 0) {}
+	};
+
+	void book_generated(generated_statistic_t::type_t type, uint32 amount, stadt_t *city, uint8 history_type = 0, stadt_t *other_city = NULL);
+	void book_generated(generated_statistic_t::type_t type, uint32 amount, gebaeude_t *building);
+	void book_generated(generated_statistic_t::type_t type, uint32 amount, fabrik_t *fab);
+	void book_generated(generated_statistic_t::type_t type, uint32 amount, halthandle_t halt);
+	void book_generated_destination(stadt_t *city, koord pos, PIXVAL colour);
+	void book_generated_debug_sum(uint8 num, uint32 val);
+
+private:
+	/// books at once, or into the buffer of the passenger generation thread
+	void book_generated(const generated_statistic_t &stat);
+	void apply_generated(const generated_statistic_t &stat);
+
+#ifdef MULTI_THREAD
+	/// output of one passenger and mail generation thread, merged in thread order by await_passengers_and_mail_threads()
+	struct passenger_thread_output_t
+	{
+		sint32 passenger_units;
+		sint32 mail_units;
+		vector_tpl<generated_statistic_t> statistics;
+
+		passenger_thread_output_t() : passenger_units(0), mail_units(0) {}
+	};
+	static passenger_thread_output_t *passenger_thread_outputs;
+#endif
+
+public:
+
 
 	/**
 	 * Announce server and current state to listserver.
@@ -2152,17 +2248,30 @@ public:
 	class sync_list_t {
 			friend class karte_t;
 		public:
-			sync_list_t() : currently_deleting(NULL), sync_step_running(false) {}
+			sync_list_t() : currently_deleting(NULL), sync_step_running(false), parallel_delta_t(0) {}
 			void add(sync_steppable *obj);
 			void remove(sync_steppable *obj);
 		private:
 			void sync_step(uint32 delta_t);
+			/**
+			 * Sorts the objects which can be stepped in parallel by map row
+			 * (see sync_steppable::prepare_parallel_sync_step()).
+			 * sync_step() then skips them.
+			 * @return false if there are none
+			 */
+			bool prepare_parallel_sync_step(uint32 delta_t, sint16 rows);
 			/// clears list, does not delete the objects
 			void clear();
 
 			vector_tpl<sync_steppable *> list;  ///< list of sync-steppable objects
 			sync_steppable* currently_deleting; ///< deleted durign sync_step, safeguard calls to remove
 			bool sync_step_running;
+
+			vector_tpl<uint8> parallel_stepped;  ///< per entry of list: stepped by sync_step_parallel_loop()
+			vector_tpl<sint16> parallel_row;     ///< per entry of list: its map row
+			vector_tpl<uint32> parallel_order;   ///< indices into list, sorted by map row
+			vector_tpl<uint32> parallel_row_start; ///< first entry of parallel_order for each map row
+			uint32 parallel_delta_t;
 	};
 
 	sync_list_t sync;              ///< vehicles, transformers, traffic lights
@@ -2287,6 +2396,11 @@ public:
 	 */
 	void cleanup_grounds_loop(sint16, sint16, sint16, sint16);
 
+	/**
+	 * Steps the objects of sync prepared by sync_list_t::prepare_parallel_sync_step() - suitable for multithreading
+	 */
+	void sync_step_parallel_loop(sint16, sint16, sint16, sint16);
+
 public:
 	/**
 	 * @return Minimum height of the planquadrats (tile) at i, j. - for speed no checks performed that coordinates are valid
@@ -2347,11 +2461,29 @@ public:
 	 */
 	void save(const char *filename, bool autosave, const char *version, const char *ex_version, const char* ex_revision, bool silent);
 
+	/**
+	 * Saves the map uncompressed to memory, to resynchronise network games
+	 * without writing and reading files.
+	 * @param snapshot the savegame is appended to it.
+	 * @return false if saving failed.
+	 */
+	bool save_snapshot(std::string &snapshot, const char *version, const char *ex_version, const char* ex_revision);
+
+	/**
+	 * Saves the map like an autosave from a copy-on-write copy of the process,
+	 * so the game only stops for making the copy.
+	 * @return false if not possible (not supported, the last one still running,
+	 *         or the map must be rotated for saving); then nothing was saved.
+	 */
+	bool save_in_background(const char *filename, const char *version, const char *ex_version, const char* ex_revision);
+
 	/**
 	 * Loads a map from a file.
 	 * @param filename name of the file to read.
+	 * @param snapshot if not NULL, the map is read from this savegame in memory instead;
+	 *                 filename then only tells a resync of a network game from loading another map.
 	 */
-	bool load(const char *filename);
+	bool load(const char *filename, const std::string *snapshot = NULL);
 
 	/**
 	 * Creates a map from a heightfield.
@@ -2500,6 +2632,16 @@ private:
 
 	void get_nearby_halts_of_tiles(const minivec_tpl<const planquadrat_t*> &tile_list, const goods_desc_t * wtyp, vector_tpl<nearby_halt_t> &halts) const;
 
+	/// as get_nearby_halts_of_tiles() for the tiles of the building, but from its list of nearby halts if that is up to date
+	void get_nearby_halts_of_building(gebaeude_t *gb, const goods_desc_t * wtyp, vector_tpl<nearby_halt_t> &halts) const;
+
+	/**
+	 * Brings the lists of nearby halts of the buildings in the passenger and
+	 * mail lists up to date, if any halt coverage changed since the last call.
+	 * Must be called before the passenger generation starts.
+	 */
+	void update_nearby_halts_of_buildings();
+
 	void refresh_private_car_routes();
 
 	static void clear_private_car_routes() ;
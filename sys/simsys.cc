@@ -46,6 +46,10 @@
 #	if !defined __AMIGA__ && !defined __BEOS__
 #		include <unistd.h>
 #	endif
+#	if !defined __AMIGA__ && !defined __BEOS__ && !defined __EMSCRIPTEN__
+#		include <sys/wait.h>
+#		define HAS_FORK
+#	endif
 #endif
 
 
@@ -326,6 +330,48 @@ int dr_stat(const char *path, struct stat *buf)
 #endif
 }
 
+
+int dr_fork_background()
+{
+#ifdef HAS_FORK
+	// anything buffered would be written twice otherwise
+	fflush(NULL);
+	return fork();
+#else
+	return -1;
+#endif
+}
+
+
+void dr_exit_background(int status)
+{
+#ifdef HAS_FORK
+	_exit(status);
+#else
+	exit(status);
+#endif
+}
+
+
+int dr_check_background(int id, bool wait)
+{
+#ifdef HAS_FORK
+	int status;
+	const pid_t pid = waitpid( (pid_t)id, &status, wait ? 0 : WNOHANG );
+	if(  pid == 0  ) {
+		return -1;
+	}
+	if(  pid < 0  ||  !WIFEXITED(status)  ) {
+		return 255;
+	}
+	return WEXITSTATUS(status);
+#else
+	(void)id;
+	(void)wait;
+	return 255;
+#endif
+}
+
 char const *dr_query_homedir()
 {
 	static char buffer[PATH_MAX + 24];
@@ -140,6 +140,23 @@ gzFile dr_gzopen(const char *path, const char *mode);
 // Functions the same as stat except path must be UTF-8 encoded.
 int dr_stat(const char *path, struct stat *buf);
 
+/**
+ * Starts a copy-on-write copy of this process, to work on a snapshot of it in the background.
+ * Only the calling thread exists in the copy, which must end with dr_exit_background().
+ * @return 0 in the copy, its id in this process, or -1 if failed or not supported.
+ */
+int dr_fork_background();
+
+// ends the copy without any cleanup, which would also close windows, sound etc. of this process
+void dr_exit_background(int status);
+
+/**
+ * Checks whether a copy started by dr_fork_background() has ended.
+ * @param wait if true, waits for it to end
+ * @return -1 while it is running, else its exit status (255 if it crashed)
+ */
+int dr_check_background(int id, bool wait);
+
 /* query home directory */
 char const* dr_query_homedir();
 
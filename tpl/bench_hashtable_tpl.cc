@@ -0,0 +1,189 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ *
+ * Microbenchmark for hashtable_tpl.h against the former chained-bucket table.
+ * Do NOT link this into simutrans! Build it on its own, for instance
+ *   g++ -O2 -std=c++11 tpl/bench_hashtable_tpl.cc -o bench_hashtable
+ */
+#include <stdio.h>
+#include <time.h>
+#include "../simtypes.h"
+#include "slist_tpl.h"
+#include "inthashtable_tpl.h"
+#include "stringhashtable_tpl.h"
+
+// This is a hack, but it's worth it. The templates need the node allocator in order to link.
+#include "../dataobj/freelist.cc"
+
+void* xmalloc(size_t const size) { return malloc(size); }
+
+
+/*
+ * The previous hashtable_tpl: a fixed number of bags, each a sorted slist.
+ * Only the parts needed for the comparison are kept.
+ */
+template<class key_t, class value_t, class hash_t, size_t n_bags>
+class chained_hashtable_tpl
+{
+	struct node_t {
+		key_t   key;
+		value_t value;
+	};
+
+	slist_tpl<node_t> bags[n_bags];
+	uint32 count;
+
+	uint8 get_hash(const key_t key) const { return (uint8)(hash_t::hash(key) % n_bags); }
+
+public:
+	chained_hashtable_tpl() : count(0) {}
+
+	const value_t &get(const key_t key) const
+	{
+		static value_t nix;
+		FORT(slist_tpl<node_t>, const& node, bags[get_hash(key)]) {
+			typename hash_t::diff_type diff = hash_t::comp(node.key, key);
+			if(  diff == 0  ) {
+				return node.value;
+			}
+			if(  diff > 0  ) {
+				break;
+			}
+		}
+		return nix;
+	}
+
+	bool put(const key_t key, value_t object)
+	{
+		slist_tpl<node_t>& bag = bags[get_hash(key)];
+		node_t n;
+		n.key   = key;
+		n.value = object;
+		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
+			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
+			if(  diff > 0  ) {
+				bag.insert( iter, n );
+				count ++;
+				return true;
+			}
+			if(  diff == 0  ) {
+				return false;
+			}
+		}
+		bag.append( n );
+		count ++;
+		return true;
+	}
+
+	value_t remove(const key_t key)
+	{
+		slist_tpl<node_t>& bag = bags[get_hash(key)];
+		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
+			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
+			if(  diff == 0  ) {
+				value_t v = iter->value;
+				bag.erase(iter);
+				count --;
+				return v;
+			}
+			if(  diff > 0  ) {
+				break;
+			}
+		}
+		return value_t();
+	}
+
+	uint32 get_count() const { return count; }
+};
+
+
+static double seconds_since(clock_t start)
+{
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+
+/*
+ * Fill, look up (hits and misses), and empty a table of the given size
+ * "rounds" times. Returns the checksum of all values found to keep the
+ * compiler honest.
+ */
+template<class table_t, class key_t>
+static uint32 run(const char *name, key_t const *keys, key_t const *misses, uint32 size, uint32 rounds)
+{
+	uint32 found = 0;
+	double t_put = 0, t_get = 0, t_miss = 0, t_remove = 0;
+	for(  uint32 r = 0;  r < rounds;  r++  ) {
+		table_t *table = new table_t();
+		clock_t start = clock();
+		for(  uint32 i = 0;  i < size;  i++  ) {
+			table->put( keys[i], i + 1 );
+		}
+		t_put += seconds_since( start );
+
+		start = clock();
+		for(  uint32 repeat = 0;  repeat < 8;  repeat++  ) {
+			for(  uint32 i = 0;  i < size;  i++  ) {
+				found += table->get( keys[i] );
+			}
+		}
+		t_get += seconds_since( start );
+
+		start = clock();
+		for(  uint32 repeat = 0;  repeat < 8;  repeat++  ) {
+			for(  uint32 i = 0;  i < size;  i++  ) {
+				found += table->get( misses[i] );
+			}
+		}
+		t_miss += seconds_since( start );
+
+		start = clock();
+		for(  uint32 i = 0;  i < size;  i++  ) {
+			found += table->remove( keys[i] );
+		}
+		t_remove += seconds_since( start );
+		delete table;
+	}
+	fprintf(stdout, "%-10s %6u entries: put %7.3fs  get %7.3fs  miss %7.3fs  remove %7.3fs\n", name, size, t_put, t_get, t_miss, t_remove );
+	return found;
+}
+
+
+int main()
+{
+	uint32 checksum = 0;
+
+	// connexions_map sized tables: halt ids as keys, up to a few thousand entries
+	static uint16 halt_ids[8192], halt_misses[8192];
+	for(  uint32 i = 0;  i < 8192;  i++  ) {
+		halt_ids[i] = (uint16)(1 + i * 7);
+		halt_misses[i] = (uint16)(2 + i * 7);
+	}
+	const uint32 halt_sizes[] = { 16, 256, 2048, 8192 };
+	for(  uint32 s = 0;  s < 4;  s++  ) {
+		const uint32 rounds = 2000000 / halt_sizes[s];
+		checksum += run< chained_hashtable_tpl<uint16, uint32, inthash_tpl<uint16>, N_BAGS_MEDIUM> >( "chained", halt_ids, halt_misses, halt_sizes[s], rounds );
+		checksum += run< inthashtable_tpl<uint16, uint32, N_BAGS_MEDIUM> >( "open", halt_ids, halt_misses, halt_sizes[s], rounds );
+	}
+
+	// pak registry sized tables: object names as keys
+	const uint32 name_count = 16384;
+	static char names[name_count][24], name_misses[name_count][24];
+	static const char *name_keys[name_count], *name_miss_keys[name_count];
+	for(  uint32 i = 0;  i < name_count;  i++  ) {
+		sprintf( names[i], "Building_%u_pak", i );
+		sprintf( name_misses[i], "Vehicle_%u_pak", i );
+		name_keys[i] = names[i];
+		name_miss_keys[i] = name_misses[i];
+	}
+	const uint32 name_sizes[] = { 512, 4096, 16384 };
+	for(  uint32 s = 0;  s < 3;  s++  ) {
+		const uint32 rounds = 1000000 / name_sizes[s];
+		checksum += run< chained_hashtable_tpl<const char *, uint32, stringhash_t, N_BAGS_LARGE> >( "chained", name_keys, name_miss_keys, name_sizes[s], rounds );
+		checksum += run< stringhashtable_tpl<uint32, N_BAGS_LARGE> >( "open", name_keys, name_miss_keys, name_sizes[s], rounds );
+	}
+
+	fprintf(stdout, "checksum %u\n", checksum );
+	return 0;
+}
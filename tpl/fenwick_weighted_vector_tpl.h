@@ -0,0 +1,412 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef TPL_FENWICK_WEIGHTED_VECTOR_TPL_H
+#define TPL_FENWICK_WEIGHTED_VECTOR_TPL_H
+
+
+#include <cstddef>
+#include <iterator>
+
+#include "../macros.h"
+#include "../simdebug.h"
+#include "ptrhashtable_tpl.h"
+
+
+/**
+ * A weighted vector for large lists whose weights change all the time,
+ * like the world lists of buildings for passenger and mail generation.
+ *
+ * The weights are kept in a Fenwick tree, so at_weight(), append(),
+ * remove() and update() are O(log n). The elements are found through an
+ * index table instead of a linear search. Removed elements leave a hole
+ * with zero weight, which is closed by compacting the whole vector once
+ * there are more holes than elements.
+ *
+ * Only the order of the contained elements and their weights decides
+ * what at_weight() returns, so for the same sequence of elements and
+ * weights the result is the same as from weighted_vector_tpl. Inserting
+ * in the middle (insert_ordered()) is O(n) as with weighted_vector_tpl.
+ *
+ * T must be a pointer type, as the index table hashes the pointers.
+ */
+template<class T> class fenwick_weighted_vector_tpl
+{
+	private:
+		struct nodestruct
+		{
+			T data;
+			uint32 weight;
+			bool removed;
+		};
+
+		struct index_t
+		{
+			uint32 pos;    ///< first occurrence of the element
+			uint32 copies; ///< number of occurrences
+			index_t() : pos(0), copies(0) {}
+		};
+
+	public:
+		class const_iterator;
+
+		class iterator
+		{
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef std::ptrdiff_t            difference_type;
+				typedef T const*                  pointer;
+				typedef T const&                  reference;
+				typedef T                         value_type;
+
+				T& operator *() const { return ptr->data; }
+
+				iterator& operator ++()
+				{
+					while(  ++ptr != end  &&  ptr->removed  ) {}
+					return *this;
+				}
+
+				bool operator !=(const iterator& o) { return ptr != o.ptr; }
+
+			private:
+				iterator(nodestruct* ptr_, nodestruct* end_) : ptr(ptr_), end(end_)
+				{
+					while(  ptr != end  &&  ptr->removed  ) {
+						++ptr;
+					}
+				}
+
+				nodestruct* ptr;
+				nodestruct* end;
+
+			friend class fenwick_weighted_vector_tpl;
+			friend class const_iterator;
+		};
+
+		class const_iterator
+		{
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef std::ptrdiff_t            difference_type;
+				typedef T const*                  pointer;
+				typedef T const&                  reference;
+				typedef T                         value_type;
+
+				const_iterator(const iterator& o) : ptr(o.ptr), end(o.end) {}
+
+				const T& operator *() const { return ptr->data; }
+
+				const_iterator& operator ++()
+				{
+					while(  ++ptr != end  &&  ptr->removed  ) {}
+					return *this;
+				}
+
+				bool operator !=(const const_iterator& o) { return ptr != o.ptr; }
+
+			private:
+				const_iterator(const nodestruct* ptr_, const nodestruct* end_) : ptr(ptr_), end(end_)
+				{
+					while(  ptr != end  &&  ptr->removed  ) {
+						++ptr;
+					}
+				}
+
+				const nodestruct* ptr;
+				const nodestruct* end;
+
+			friend class fenwick_weighted_vector_tpl;
+		};
+
+		fenwick_weighted_vector_tpl() : nodes(NULL), tree(NULL), size(0), count(0), live_count(0), total_weight(0) {}
+
+		~fenwick_weighted_vector_tpl()
+		{
+			delete [] nodes;
+			delete [] tree;
+		}
+
+		/** sets the vector to empty */
+		void clear()
+		{
+			count = 0;
+			live_count = 0;
+			total_weight = 0;
+			index.clear();
+		}
+
+		/** Reserves room for new_size elements (including holes) */
+		void resize(uint32 new_size)
+		{
+			if(  new_size <= size  ) {
+				return;
+			}
+			nodestruct* new_nodes = new nodestruct[new_size];
+			uint32* new_tree = new uint32[new_size + 1];
+			for(  uint32 i = 0;  i < count;  i++  ) {
+				new_nodes[i] = nodes[i];
+			}
+			// a Fenwick node only covers elements before it, so it survives growing
+			for(  uint32 k = 1;  k <= count;  k++  ) {
+				new_tree[k] = tree[k];
+			}
+			delete [] nodes;
+			delete [] tree;
+			nodes = new_nodes;
+			tree = new_tree;
+			size = new_size;
+		}
+
+		bool is_contained(T elem) const
+		{
+			return index.is_contained(elem);
+		}
+
+		/** Appends the element at the end of the vector. */
+		bool append(T elem, uint32 weight)
+		{
+#ifdef IGNORE_ZERO_WEIGHT
+			if (weight == 0) {
+				// ignore unused entries ...
+				return false;
+			}
+#endif
+			if(  count == size  ) {
+				resize(size == 0 ? 16 : size * 2);
+			}
+			nodes[count].data    = elem;
+			nodes[count].weight  = weight;
+			nodes[count].removed = false;
+			count++;
+			// the new Fenwick node sums up its own weight and the nodes it covers
+			uint32 sum = weight;
+			for(  uint32 step = 1;  step < (count & (0 - count));  step <<= 1  ) {
+				sum += tree[count - step];
+			}
+			tree[count] = sum;
+
+			index_t& entry = index_of(elem);
+			if(  entry.copies++ == 0  ) {
+				entry.pos = count - 1;
+			}
+			live_count++;
+			total_weight += weight;
+			return true;
+		}
+
+		/** Checks if element is contained. Appends only new elements. */
+		bool append_unique(T elem, uint32 weight)
+		{
+			return is_contained(elem) || append(elem, weight);
+		}
+
+		/**
+		 * Insert `elem' with respect to ordering. This needs O(n) like
+		 * for weighted_vector_tpl.
+		 */
+		template<class StrictWeakOrdering>
+		void insert_ordered(const T& elem, uint32 weight, StrictWeakOrdering comp)
+		{
+			// the data of holes may point to deleted objects, so do not compare them
+			compact();
+			if(  count == size  ) {
+				resize(size == 0 ? 16 : size * 2);
+			}
+			sint32 high = count, low = -1;
+			while(  high-low>1  ) {
+				const sint32 mid = ((uint32)(high + low)) >> 1;
+				if(  comp(elem, nodes[mid].data)  ) {
+					high = mid;
+				}
+				else {
+					low = mid;
+				}
+			}
+			for(  uint32 i = count;  i > (uint32)high;  i--  ) {
+				nodes[i] = nodes[i - 1];
+			}
+			nodes[high].data    = elem;
+			nodes[high].weight  = weight;
+			nodes[high].removed = false;
+			count++;
+			live_count++;
+			total_weight += weight;
+			rebuild();
+		}
+
+		/**
+		 * Update the weight of the first occurrence of the element, if contained
+		 */
+		bool update(T elem, uint32 weight)
+		{
+			const index_t* entry = index.access(elem);
+			if(  entry == NULL  ) {
+				return false;
+			}
+			return update_at(entry->pos, weight);
+		}
+
+		/** removes the first occurrence of the element, if contained */
+		bool remove(T elem)
+		{
+			const index_t* entry = index.access(elem);
+			if(  entry == NULL  ) {
+				return false;
+			}
+			remove_at(entry->pos);
+			return true;
+		}
+
+		/** removes all copies of element, if contained */
+		bool remove_all(T elem)
+		{
+			bool any_to_remove = false;
+			while(  remove(elem)  ) {
+				any_to_remove = true;
+			}
+			return any_to_remove;
+		}
+
+		/** Accesses the element at position i by weight */
+		T& at_weight(const uint32 target_weight) const
+		{
+			if (target_weight > total_weight) {
+				dbg->fatal("fenwick_weighted_vector_tpl<T>::at_weight()", "weight out of bounds: %i not in 0..%d", target_weight, total_weight);
+			}
+			// find the last position whose preceding weights sum up to at most target_weight
+			uint32 pos = 0;
+			uint32 remaining = target_weight;
+			uint32 step = 1;
+			while(  step <= count / 2  ) {
+				step <<= 1;
+			}
+			for(  ;  step > 0;  step >>= 1  ) {
+				if(  pos + step <= count  &&  tree[pos + step] <= remaining  ) {
+					pos += step;
+					remaining -= tree[pos];
+				}
+			}
+			// for target_weight==total_weight this is the last element, as in weighted_vector_tpl
+			if(  pos >= count  ) {
+				pos = count - 1;
+			}
+			while(  pos > 0  &&  nodes[pos].removed  ) {
+				pos--;
+			}
+			return nodes[pos].data;
+		}
+
+		/** Gets the number of elements in the vector */
+		uint32 get_count() const { return live_count; }
+
+		/** Gets the total weight */
+		uint32 get_sum_weight() const { return total_weight; }
+
+		bool empty() const { return live_count == 0; }
+
+		iterator begin() { return iterator(nodes, nodes + count); }
+		iterator end()   { return iterator(nodes + count, nodes + count); }
+
+		const_iterator begin() const { return const_iterator(nodes, nodes + count); }
+		const_iterator end()   const { return const_iterator(nodes + count, nodes + count); }
+
+	private:
+		nodestruct* nodes;
+		uint32* tree;         ///< Fenwick tree of the weights, 1-based
+		uint32 size;          ///< Capacity
+		uint32 count;         ///< Number of elements including holes
+		uint32 live_count;    ///< Number of elements in vector
+		uint32 total_weight;  ///< Sum of all weights
+		ptrhashtable_tpl<T, index_t, N_BAGS_LARGE> index;
+
+		fenwick_weighted_vector_tpl(const fenwick_weighted_vector_tpl& other);
+
+		fenwick_weighted_vector_tpl& operator=( fenwick_weighted_vector_tpl const& other );
+
+		index_t& index_of(T elem)
+		{
+			index.put(elem);
+			return *index.access(elem);
+		}
+
+		/** adds delta (modulo 2^32) to the weight at pos */
+		void add_weight(uint32 pos, uint32 delta)
+		{
+			for(  uint32 k = pos + 1;  k <= count;  k += k & (0 - k)  ) {
+				tree[k] += delta;
+			}
+		}
+
+		bool update_at(uint32 pos, uint32 weight)
+		{
+			add_weight(pos, weight - nodes[pos].weight);
+			total_weight += weight - nodes[pos].weight;
+			nodes[pos].weight = weight;
+			return true;
+		}
+
+		void remove_at(uint32 pos)
+		{
+			update_at(pos, 0);
+			nodes[pos].removed = true;
+			live_count--;
+
+			index_t* entry = index.access(nodes[pos].data);
+			if(  --entry->copies == 0  ) {
+				index.remove(nodes[pos].data);
+			}
+			else {
+				// only with duplicates: find the next occurrence
+				uint32 next = pos + 1;
+				while(  nodes[next].removed  ||  !(nodes[next].data == nodes[pos].data)  ) {
+					next++;
+				}
+				entry->pos = next;
+			}
+
+			if(  count - live_count > live_count  &&  count > 64  ) {
+				compact();
+			}
+		}
+
+		/** closes all holes, keeping the order of the elements */
+		void compact()
+		{
+			if(  live_count == count  ) {
+				return;
+			}
+			uint32 j = 0;
+			for(  uint32 i = 0;  i < count;  i++  ) {
+				if(  !nodes[i].removed  ) {
+					nodes[j++] = nodes[i];
+				}
+			}
+			count = j;
+			rebuild();
+		}
+
+		/** recalculates the Fenwick tree and the index table from nodes */
+		void rebuild()
+		{
+			for(  uint32 k = 1;  k <= count;  k++  ) {
+				tree[k] = nodes[k - 1].weight;
+			}
+			for(  uint32 k = 1;  k <= count;  k++  ) {
+				const uint32 parent = k + (k & (0 - k));
+				if(  parent <= count  ) {
+					tree[parent] += tree[k];
+				}
+			}
+			index.clear();
+			for(  uint32 i = count;  i-- > 0;  ) {
+				index_t& entry = index_of(nodes[i].data);
+				entry.pos = i;
+				entry.copies++;
+			}
+		}
+};
+
+#endif
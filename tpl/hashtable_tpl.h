@@ -7,17 +7,31 @@
 #define TPL_HASHTABLE_TPL_H
 
 
+#include <iterator>
+#include <string.h>
 #include "slist_tpl.h"
+#include "../dataobj/freelist.h"
+#include "../simdebug.h"
 #include "../macros.h"
 
-#define STHT_BAGSIZE 3
-#define STHT_BAG_COUNTER_T uint8
-
 
 /*
  * Generic hashtable, which maps key_t to value_t. key_t depended functions
  * like the hash generation is implemented by the third template parameter
  * hash_t (see ifc/hash_tpl.h)
+ *
+ * The table uses open addressing with linear probing. The slot array only
+ * holds the hash and a pointer to the node, so nodes never move: pointers
+ * returned by access() and get() stay valid until that very key is removed.
+ *
+ * The slots are kept sorted by (scrambled hash, key) and never wrap around
+ * at the end of the array. Therefore the layout for a given capacity, and
+ * the iteration order for any capacity, only depends on the set of keys and
+ * not on the order of insertions and removals. This matters for everything
+ * that is iterated in network games or written to savegames.
+ *
+ * n_bags is only used as a hint for the size of the first allocation. Empty
+ * tables allocate nothing.
  */
 template<class key_t, class value_t, class hash_t, size_t n_bags>
 class hashtable_tpl
@@ -28,12 +42,25 @@ protected:
 		key_t   key;
 		value_t value;
 
+		node_t(const key_t &key_) : key(key_), value() {}
+		node_t(const key_t &key_, const value_t &value_) : key(key_), value(value_) {}
+
+		void* operator new(size_t) { return freelist_t::gimme_node(sizeof(node_t)); }
+		void operator delete(void* p) { freelist_t::putback_node(sizeof(node_t), p); }
+
 		int operator == (const node_t &x) const { return key == x.key; }
 	};
 
-	// the entires in the lists are sorted according to their keys
-	slist_tpl <node_t> bags[n_bags];
+	struct slot_t {
+		node_t *node;  // NULL for an empty slot
+		uint32 hash;   // scrambled hash of node->key
+	};
+
+	slot_t *slots;
+	uint32 slot_count;     // home slots plus overflow slots at the end
+	uint8  home_bits;      // log2 of the number of home slots
 	uint32 count;
+	uint32 first_used;     // all slots below are empty
 
 /*
  * assigning hashtables seems also not sound
@@ -42,13 +69,131 @@ private:
 	hashtable_tpl(const hashtable_tpl&);
 	hashtable_tpl& operator=( hashtable_tpl const&);
 
-public:
-	hashtable_tpl() { count = 0; }
+	// Fibonacci hashing spreads even sequential ids over the upper bits
+	static uint32 scramble(const key_t &key) { return (uint32)hash_t::hash(key) * 0x9E3779B1u; }
+
+	uint32 get_home(const uint32 hash) const { return hash >> (32 - home_bits); }
+
+	static uint32 get_overflow(const uint8 bits) { return (1u << bits) / 8 + 4; }
+
+	/* Searches the slot of key. Returns true if found; otherwise pos is
+	 * the place where key belongs (which may be occupied or even beyond
+	 * the end of the array) */
+	bool find(const key_t &key, const uint32 hash, uint32 &pos) const
+	{
+		if(  slots == NULL  ) {
+			pos = 0;
+			return false;
+		}
+		uint32 i = get_home(hash);
+		for(  ;  i < slot_count  &&  slots[i].node;  i++  ) {
+			if(  slots[i].hash > hash  ) {
+				break;
+			}
+			if(  slots[i].hash == hash  ) {
+				typename hash_t::diff_type diff = hash_t::comp(slots[i].node->key, key);
+				if(  diff == 0  ) {
+					pos = i;
+					return true;
+				}
+				if(  diff > 0  ) {
+					break;
+				}
+			}
+		}
+		pos = i;
+		return false;
+	}
+
+	/* Rebuilds the slot array with at least 2^bits home slots. Since the
+	 * old slots are already sorted, every node is just appended. */
+	void resize(uint8 bits)
+	{
+		for(  ;;  bits++  ) {
+			const uint32 new_count = (1u << bits) + get_overflow(bits);
+			slot_t *new_slots = new slot_t[new_count];
+			memset( new_slots, 0, sizeof(slot_t) * new_count );
+			uint32 next = 0;
+			bool fits = true;
+			for(  uint32 i = first_used;  i < slot_count;  i++  ) {
+				if(  slots[i].node  ) {
+					const uint32 home = slots[i].hash >> (32 - bits);
+					const uint32 pos = home > next ? home : next;
+					if(  pos >= new_count  ) {
+						fits = false;
+						break;
+					}
+					new_slots[pos] = slots[i];
+					next = pos + 1;
+				}
+			}
+			if(  fits  ) {
+				delete [] slots;
+				slots = new_slots;
+				slot_count = new_count;
+				home_bits = bits;
+				first_used = 0;
+				while(  first_used < slot_count  &&  !slots[first_used].node  ) {
+					first_used++;
+				}
+				return;
+			}
+			delete [] new_slots;
+		}
+	}
+
+	/* Inserts a new node into the slot where key belongs, shifting the
+	 * following slots of the run up by one. The key must not be contained. */
+	node_t *insert(node_t *node, const uint32 hash)
+	{
+		if(  slots == NULL  ||  (count + 1) * 4 > (3u << home_bits)  ) {
+			uint8 bits = home_bits + 1;
+			if(  slots == NULL  ) {
+				for(  bits = 3;  (1u << bits) < n_bags;  bits++  ) {}
+			}
+			resize( bits );
+		}
+		for(  ;;  ) {
+			uint32 pos;
+			find( node->key, hash, pos );
+			uint32 free = pos;
+			while(  free < slot_count  &&  slots[free].node  ) {
+				free++;
+			}
+			if(  free < slot_count  ) {
+				memmove( slots + pos + 1, slots + pos, sizeof(slot_t) * (free - pos) );
+				slots[pos].node = node;
+				slots[pos].hash = hash;
+				if(  pos < first_used  ) {
+					first_used = pos;
+				}
+				count ++;
+				return node;
+			}
+			// the run reaches the end of the array
+			resize( home_bits + 1 );
+		}
+	}
+
+	/* Removes the node at pos and closes the gap by moving the displaced
+	 * nodes behind it back by one */
+	void remove_at(uint32 pos)
+	{
+		delete slots[pos].node;
+		while(  pos + 1 < slot_count  &&  slots[pos + 1].node  &&  get_home(slots[pos + 1].hash) <= pos  ) {
+			slots[pos] = slots[pos + 1];
+			pos ++;
+		}
+		slots[pos].node = NULL;
+		count --;
+	}
 
 public:
-	STHT_BAG_COUNTER_T get_hash(const key_t key) const
+	hashtable_tpl() : slots(NULL), slot_count(0), home_bits(0), count(0), first_used(0) {}
+
+	~hashtable_tpl()
 	{
-		return (STHT_BAG_COUNTER_T)(hash_t::hash(key) % n_bags);
+		clear();
 	}
 
 	class iterator
@@ -61,66 +206,41 @@ public:
 			typedef node_t*                   pointer;
 			typedef node_t&                   reference;
 
-			iterator() : bag_i(), bag_end(), node_i() {}
+			iterator() : slot_i(), slot_end() {}
 
-			iterator(slist_tpl<node_t>* const bag_i,  slist_tpl<node_t>* const bag_end, typename slist_tpl<node_t>::iterator const& node_i) :
-				bag_i(bag_i),
-				bag_end(bag_end),
-				node_i(node_i)
+			iterator(slot_t* const slot_i, slot_t* const slot_end) :
+				slot_i(slot_i),
+				slot_end(slot_end)
 			{}
 
-			pointer   operator ->() const { return &*node_i; }
-			reference operator *()  const { return  *node_i; }
+			pointer   operator ->() const { return  slot_i->node; }
+			reference operator *()  const { return *slot_i->node; }
 
 			iterator& operator ++()
 			{
-				if (++node_i == bag_i->end()) {
-					for (;;) {
-						if (++bag_i == bag_end) {
-							node_i = typename slist_tpl<node_t>::iterator();
-							break;
-						}
-						if (!bag_i->empty()) {
-							node_i = bag_i->begin();
-							break;
-						}
-					}
-				}
+				while(  ++slot_i != slot_end  &&  !slot_i->node  ) {}
 				return *this;
 			}
 
-			bool operator ==(iterator const& o) const { return bag_i == o.bag_i && node_i == o.node_i; }
+			bool operator ==(iterator const& o) const { return slot_i == o.slot_i; }
 			bool operator !=(iterator const& o) const { return !(*this == o); }
 
 		private:
-			slist_tpl<node_t>*                   bag_i;
-			slist_tpl<node_t>*                   bag_end;
-			typename slist_tpl<node_t>::iterator node_i;
+			slot_t* slot_i;
+			slot_t* slot_end;
 	};
 
 	/* Erase element at pos
-	 * pos is invalid after this method
+	 * pos and all other iterators are invalid after this method
 	 * An iterator pointing to the successor of the erased element is returned */
 	iterator erase(iterator old)
 	{
-		iterator pos(old);
-		pos.bag_end = old.bag_end;
-		pos.bag_i = old.bag_i;
-		pos.node_i = old.bag_i->erase( old.node_i );
-		if(  pos.node_i ==  pos.bag_i->end()  ) {
-			for (;;) {
-				if (++pos.bag_i == pos.bag_end) {
-					pos.node_i = typename slist_tpl<node_t>::iterator();
-					break;
-				}
-				if (!pos.bag_i->empty()) {
-					pos.node_i = pos.bag_i->begin();
-					break;
-				}
-			}
+		remove_at( (uint32)(old.slot_i - slots) );
+		// the successor may have been moved into the erased slot
+		if(  !old.slot_i->node  ) {
+			++old;
 		}
-		count --;
-		return pos;
+		return old;
 	}
 
 	class const_iterator
@@ -132,113 +252,87 @@ public:
 			typedef node_t const*             pointer;
 			typedef node_t const&             reference;
 
-			const_iterator() : bag_i(), bag_end(), node_i() {}
+			const_iterator() : slot_i(), slot_end() {}
 
-			const_iterator(slist_tpl<node_t> const* const bag_i,  slist_tpl<node_t> const* const bag_end, typename slist_tpl<node_t>::const_iterator const& node_i) :
-				bag_i(bag_i),
-				bag_end(bag_end),
-				node_i(node_i)
+			const_iterator(slot_t const* const slot_i, slot_t const* const slot_end) :
+				slot_i(slot_i),
+				slot_end(slot_end)
 			{}
 
-			pointer   operator ->() const { return &*node_i; }
-			reference operator *()  const { return  *node_i; }
+			pointer   operator ->() const { return  slot_i->node; }
+			reference operator *()  const { return *slot_i->node; }
 
 			const_iterator& operator ++()
 			{
-				if (++node_i == bag_i->end()) {
-					for (;;) {
-						if (++bag_i == bag_end) {
-							node_i = typename slist_tpl<node_t>::const_iterator();
-							break;
-						}
-						if (!bag_i->empty()) {
-							node_i = bag_i->begin();
-							break;
-						}
-					}
-				}
+				while(  ++slot_i != slot_end  &&  !slot_i->node  ) {}
 				return *this;
 			}
 
-			bool operator ==(const_iterator const& o) const { return bag_i == o.bag_i && node_i == o.node_i; }
+			bool operator ==(const_iterator const& o) const { return slot_i == o.slot_i; }
 			bool operator !=(const_iterator const& o) const { return !(*this == o); }
 
 		private:
-			slist_tpl<node_t> const*                   bag_i;
-			slist_tpl<node_t> const*                   bag_end;
-			typename slist_tpl<node_t>::const_iterator node_i;
+			slot_t const* slot_i;
+			slot_t const* slot_end;
 	};
 
 	iterator begin()
 	{
-		for (slist_tpl<node_t>* i = bags; i != endof(bags); ++i) {
-			if (!i->empty()) {
-				return iterator(i, endof(bags), i->begin());
-			}
+		uint32 i = first_used;
+		while(  i < slot_count  &&  !slots[i].node  ) {
+			i++;
 		}
-		return end();
+		return iterator(slots + i, slots + slot_count);
 	}
 
 	iterator end()
 	{
-		return iterator(endof(bags), endof(bags), typename slist_tpl<node_t>::iterator());
+		return iterator(slots + slot_count, slots + slot_count);
 	}
 
 	const_iterator begin() const
 	{
-		for (slist_tpl<node_t> const* i = bags; i != endof(bags); ++i) {
-			if (!i->empty()) {
-				return const_iterator(i, endof(bags), i->begin());
-			}
+		uint32 i = first_used;
+		while(  i < slot_count  &&  !slots[i].node  ) {
+			i++;
 		}
-		return end();
+		return const_iterator(slots + i, slots + slot_count);
 	}
 
 	const_iterator end() const
 	{
-		return const_iterator(endof(bags), endof(bags), typename slist_tpl<node_t>::iterator());
+		return const_iterator(slots + slot_count, slots + slot_count);
 	}
 
 	void clear()
 	{
-		for(STHT_BAG_COUNTER_T i=0; i<n_bags; i++) {
-			bags[i].clear();
+		for(  uint32 i = first_used;  i < slot_count;  i++  ) {
+			delete slots[i].node;
 		}
+		delete [] slots;
+		slots = NULL;
+		slot_count = 0;
+		home_bits = 0;
 		count = 0;
+		first_used = 0;
 	}
 
-	// the elements are inserted with increasing key
-	// => faster retrieval (we only have to check half of the lists)
 	const value_t &get(const key_t key) const
 	{
 		static value_t nix;
-		FORT(slist_tpl<node_t>, const& node, bags[get_hash(key)]) {
-			typename hash_t::diff_type diff = hash_t::comp(node.key, key);
-			if(  diff == 0  ) {
-				return node.value;
-			}
-			if(  diff > 0  ) {
-				// not contained
-				break;
-			}
+		uint32 pos;
+		if(  find( key, scramble(key), pos )  ) {
+			return slots[pos].node->value;
 		}
 		return nix;
 	}
 
-	// the elements are inserted with increasing key
-	// => faster retrivial, but never ever change a key later!!!
+	// never ever change a key later!!!
 	value_t *access(const key_t key)
 	{
-		slist_tpl<node_t>& bag = bags[get_hash(key)];
-		FORT(slist_tpl<node_t>, & node, bag) {
-			typename hash_t::diff_type diff = hash_t::comp(node.key, key);
-			if(  diff == 0  ) {
-				return &node.value;
-			}
-			if(  diff > 0  ) {
-				// not contained
-				break;
-			}
+		uint32 pos;
+		if(  find( key, scramble(key), pos )  ) {
+			return &slots[pos].node->value;
 		}
 		return NULL;
 	}
@@ -246,32 +340,13 @@ public:
 	/// Inserts a new value - failure if key exists in table
 	bool put(const key_t key, value_t object)
 	{
-		slist_tpl<node_t>& bag = bags[get_hash(key)];
-
-		/* Duplicate values are hard to debug, so better check here.
-		 * we also enter it sorted, saving lookout time for large lists ...
-		 */
-		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
-			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
-			if(  diff>0  ) {
-				node_t n;
-				n.key   = key;
-				n.value = object;
-				bag.insert( iter, n );
-				count ++;
-				return true;
-			}
-			if(  diff == 0  ) {
-				//dbg->message( "hashtable_tpl::put", "Duplicate hash!" );
-				return false;
-			}
+		const uint32 hash = scramble(key);
+		uint32 pos;
+		if(  find( key, hash, pos )  ) {
+			//dbg->message( "hashtable_tpl::put", "Duplicate hash!" );
+			return false;
 		}
-		// here only for empty lists or everything was smaller
-		node_t n;
-		n.key = key;
-		n.value = object;
-		bag.append( n );
-		count ++;
+		insert( new node_t(key, object), hash );
 		return true;
 	}
 
@@ -282,18 +357,8 @@ public:
 	//
 	bool is_contained(const key_t key) const
 	{
-		const slist_tpl<node_t>& bag = bags[get_hash(key)];
-		FORT(slist_tpl<node_t>, const& node, bag) {
-			typename hash_t::diff_type diff = hash_t::comp(node.key, key);
-			if(  diff == 0  ) {
-				return true;
-			}
-			if(  diff > 0  ) {
-				// not contained
-				break;
-			}
-		}
-		return false;
+		uint32 pos;
+		return find( key, scramble(key), pos );
 	}
 
 	// Inserts a new instantiated value - failure, if key exists in table
@@ -301,28 +366,13 @@ public:
 	//
 	bool put(const key_t key)
 	{
-		slist_tpl<node_t>& bag = bags[get_hash(key)];
-
-		/* Duplicate values are hard to debug, so better check here.
-		 * we also enter it sorted, saving lookout time for large lists ...
-		 */
-		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
-			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
-			if(  diff>0  ) {
-				iter = bag.insert( iter );
-				iter->key = key;
-				count ++;
-				return true;
-			}
-			if(  diff == 0  ) {
-				// already initialized
-				return false;
-			}
+		const uint32 hash = scramble(key);
+		uint32 pos;
+		if(  find( key, hash, pos )  ) {
+			// already initialized
+			return false;
 		}
-		// here only for empty lists or everything was smaller
-		bag.append();
-		bag.back().key = key;
-		count ++;
+		insert( new node_t(key), hash );
 		return true;
 	}
 
@@ -333,29 +383,14 @@ public:
 	//
 	value_t set(const key_t key, value_t object)
 	{
-		slist_tpl<node_t>& bag = bags[get_hash(key)];
-		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
-			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
-			if(  diff == 0  ) {
-				value_t value = iter->value;
-				iter->value = object;
-				return value;
-			}
-			if(  diff > 0  ) {
-				node_t node;
-				node.key   = key;
-				node.value = object;
-				bag.insert( iter, node );
-				count ++;
-				return value_t();
-			}
+		const uint32 hash = scramble(key);
+		uint32 pos;
+		if(  find( key, hash, pos )  ) {
+			value_t value = slots[pos].node->value;
+			slots[pos].node->value = object;
+			return value;
 		}
-		// empty list or really last one ...
-		node_t node;
-		node.key   = key;
-		node.value = object;
-		bag.append(node);
-		count ++;
+		insert( new node_t(key, object), hash );
 		return value_t();
 	}
 
@@ -363,29 +398,22 @@ public:
 	// otherwise the value that was associated to the key.
 	value_t remove(const key_t key)
 	{
-		slist_tpl<node_t>& bag = bags[get_hash(key)];
-		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
-			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
-			if(  diff == 0  ) {
-				value_t v = iter->value;
-				bag.erase(iter);
-				count --;
-				return v;
-			}
-			if(  diff > 0  ) {
-				// not in list
-				break;
-			}
+		uint32 pos;
+		if(  find( key, scramble(key), pos )  ) {
+			value_t v = slots[pos].node->value;
+			remove_at( pos );
+			return v;
 		}
 		return value_t();
 	}
 
 	value_t remove_first()
 	{
-		for(STHT_BAG_COUNTER_T i = 0; i < n_bags; i++) {
-			if(  !bags[i].empty()  ) {
-				count --;
-				return bags[i].remove_first().value;
+		for(  ;  first_used < slot_count;  first_used++  ) {
+			if(  slots[first_used].node  ) {
+				value_t v = slots[first_used].node->value;
+				remove_at( first_used );
+				return v;
 			}
 		}
 		dbg->fatal( "hashtable_tpl::remove_first()", "Hashtable already empty!" );
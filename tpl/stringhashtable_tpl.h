@@ -21,18 +21,14 @@ class stringhash_t {
 public:
 	typedef int diff_type;
 
+	// FNV-1a over the whole string; the open addressing in hashtable_tpl
+	// needs the hashes to be spread over the full 32 bits
 	static uint32 hash(const char *key)
 	{
-		uint32 hash = 0;
-#if 1
-		for(  sint8 i=16;  i*key[0]!=0;  i--  ) {
-			hash += (uint8)(*key++);
+		uint32 hash = 2166136261u;
+		while(  *key != '\0'  ) {
+			hash = (hash ^ (uint8)(*key++)) * 16777619u;
 		}
-#else
-		while (*key != '\0') {
-			hash = hash * 33 + *key++;
-		}
-#endif
 		return hash;
 	}
 
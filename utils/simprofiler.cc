@@ -0,0 +1,193 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#include "simprofiler.h"
+#include "csv.h"
+#include "../sys/simsys.h"
+
+
+profiler_t::series_t profiler_t::phases[profiler_t::MAX_PHASES];
+profiler_t::series_t profiler_t::workers[profiler_t::MAX_WORKERS][MAX_THREADS];
+
+
+static const char *const phase_names[profiler_t::MAX_PHASES] = {
+	"step",
+	"new month",
+	"private car routes",
+	"seasons",
+	"path explorer wait",
+	"convoy wait",
+	"convoys",
+	"cities",
+	"private car wait",
+	"passengers",
+	"city statistics",
+	"passenger wait",
+	"new road users",
+	"factories",
+	"powerlines",
+	"players",
+	"halts",
+	"path refresh",
+	"transferring cargoes",
+	"start threads",
+	"step rest",
+	"sync_step",
+	"sync_step eyecandy",
+	"sync_step objects"
+};
+
+static const char *const worker_names[profiler_t::MAX_WORKERS] = {
+	"passenger thread",
+	"convoy thread",
+	"path explorer thread",
+	"private car thread"
+};
+
+
+uint64 profiler_t::get_time_us()
+{
+	return (uint64)std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+void profiler_t::add(series_t &series, uint32 usec)
+{
+	series.samples[series.next] = usec;
+	series.next = (series.next + 1) % SAMPLES;
+	if(  series.count < SAMPLES  ) {
+		series.count++;
+	}
+}
+
+
+void profiler_t::get_stats(const series_t &series, stats_t &stats)
+{
+	uint32 sorted[SAMPLES];
+	const uint32 count = series.count;
+	memcpy( sorted, series.samples, sizeof(uint32) * count );
+	std::sort( sorted, sorted + count );
+
+	uint64 sum = 0;
+	for(  uint32 i = 0;  i < count;  i++  ) {
+		sum += sorted[i];
+	}
+	stats.samples = count;
+	stats.last = series.samples[(series.next + SAMPLES - 1) % SAMPLES];
+	stats.mean = (uint32)(sum / count);
+	stats.p50 = sorted[(count - 1) * 50 / 100];
+	stats.p90 = sorted[(count - 1) * 90 / 100];
+	stats.p99 = sorted[(count - 1) * 99 / 100];
+	stats.max = sorted[count - 1];
+}
+
+
+bool profiler_t::get_phase_stats(phase_t phase, stats_t &stats)
+{
+	if(  phases[phase].count == 0  ) {
+		return false;
+	}
+	get_stats( phases[phase], stats );
+	return true;
+}
+
+
+bool profiler_t::get_worker_stats(worker_t worker, uint32 thread_number, stats_t &stats)
+{
+	if(  thread_number >= MAX_THREADS  ||  workers[worker][thread_number].count == 0  ) {
+		return false;
+	}
+	get_stats( workers[worker][thread_number], stats );
+	return true;
+}
+
+
+const char *profiler_t::get_phase_name(phase_t phase)
+{
+	return phase_names[phase];
+}
+
+
+const char *profiler_t::get_worker_name(worker_t worker)
+{
+	return worker_names[worker];
+}
+
+
+void profiler_t::reset()
+{
+	for(  uint32 p = 0;  p < MAX_PHASES;  p++  ) {
+		phases[p].next = phases[p].count = 0;
+	}
+	for(  uint32 w = 0;  w < MAX_WORKERS;  w++  ) {
+		for(  uint32 t = 0;  t < MAX_THREADS;  t++  ) {
+			workers[w][t].next = workers[w][t].count = 0;
+		}
+	}
+}
+
+
+static void add_csv_line(CSV_t &csv, const char *name, int thread_number, const profiler_t::stats_t &stats)
+{
+	csv.add_field( name );
+	csv.add_field( thread_number );
+	csv.add_field( (int)stats.samples );
+	csv.add_field( (int)stats.last );
+	csv.add_field( (int)stats.mean );
+	csv.add_field( (int)stats.p50 );
+	csv.add_field( (int)stats.p90 );
+	csv.add_field( (int)stats.p99 );
+	csv.add_field( (int)stats.max );
+	csv.new_line();
+}
+
+
+void profiler_t::write_csv(CSV_t &csv)
+{
+	csv.add_field( "phase" );
+	csv.add_field( "thread" );
+	csv.add_field( "samples" );
+	csv.add_field( "last_us" );
+	csv.add_field( "mean_us" );
+	csv.add_field( "p50_us" );
+	csv.add_field( "p90_us" );
+	csv.add_field( "p99_us" );
+	csv.add_field( "max_us" );
+	csv.new_line();
+
+	stats_t stats;
+	for(  uint32 p = 0;  p < MAX_PHASES;  p++  ) {
+		if(  get_phase_stats( (phase_t)p, stats )  ) {
+			add_csv_line( csv, phase_names[p], -1, stats );
+		}
+	}
+	for(  uint32 w = 0;  w < MAX_WORKERS;  w++  ) {
+		for(  uint32 t = 0;  t < MAX_THREADS;  t++  ) {
+			if(  get_worker_stats( (worker_t)w, t, stats )  ) {
+				add_csv_line( csv, worker_names[w], t, stats );
+			}
+		}
+	}
+}
+
+
+bool profiler_t::write_csv(const char *filename)
+{
+	CSV_t csv;
+	write_csv( csv );
+	FILE *file = dr_fopen( filename, "wb" );
+	if(  file == NULL  ) {
+		return false;
+	}
+	const char *str = csv.get_str();
+	const bool ok = fwrite( str, 1, strlen(str), file ) == strlen(str);
+	fclose( file );
+	return ok;
+}
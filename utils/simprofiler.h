@@ -0,0 +1,172 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef UTILS_SIMPROFILER_H
+#define UTILS_SIMPROFILER_H
+
+
+#include "../simtypes.h"
+#include "../simconst.h"
+
+class CSV_t;
+
+
+/**
+ * Timings of the phases of karte_t::step() and karte_t::sync_step() and of
+ * the work done by the worker threads, in microseconds.
+ *
+ * Each phase and each worker thread keeps its last SAMPLES samples, from
+ * which the percentiles are taken. Recording costs two reads of the clock,
+ * hence it is always on, also in release builds.
+ *
+ * Every series is written by only one thread, and is read by the main
+ * thread for display without locking. A value might thus be one sample
+ * behind, which does not matter for statistics.
+ */
+class profiler_t
+{
+public:
+	enum phase_t {
+		STEP = 0,             ///< whole karte_t::step()
+		NEW_MONTH,
+		PRIVATE_CAR_ROUTES,   ///< handing the cities to the private car route threads
+		SEASONS,
+		PATH_EXPLORER_WAIT,   ///< waiting for the path explorer (or running it without threads)
+		CONVOY_WAIT,          ///< waiting for the threaded part of the convoy steps
+		CONVOYS,
+		CITIES,
+		PRIVATE_CAR_WAIT,     ///< waiting for the private car route threads, and applying travel times
+		PASSENGERS,           ///< starting (or without threads: doing) passenger and mail generation
+		CITY_STATISTICS,
+		PASSENGER_WAIT,       ///< waiting for the passenger and mail generation threads
+		NEW_ROAD_USERS,
+		FACTORIES,
+		POWERLINES,
+		PLAYERS,
+		HALTS,
+		PATH_REFRESH,
+		TRANSFERRING_CARGOES,
+		START_THREADS,
+		STEP_REST,
+		SYNC_STEP,            ///< moving things in karte_t::sync_step(), without display
+		SYNC_STEP_EYECANDY,
+		SYNC_STEP_OBJECTS,    ///< vehicles, pedestrians, signals ...
+		MAX_PHASES
+	};
+
+	enum worker_t {
+		WORKER_PASSENGERS = 0,
+		WORKER_CONVOYS,
+		WORKER_PATH_EXPLORER,
+		WORKER_PRIVATE_CARS,
+		MAX_WORKERS
+	};
+
+	enum { SAMPLES = 256 };
+
+	struct stats_t {
+		uint32 samples; ///< number of samples taken into account
+		uint32 last;
+		uint32 mean;
+		uint32 p50;
+		uint32 p90;
+		uint32 p99;
+		uint32 max;
+	};
+
+private:
+	struct series_t {
+		uint32 samples[SAMPLES];
+		uint32 next;
+		uint32 count;
+	};
+
+	static series_t phases[MAX_PHASES];
+	static series_t workers[MAX_WORKERS][MAX_THREADS];
+
+	static void add(series_t &series, uint32 usec);
+	static void get_stats(const series_t &series, stats_t &stats);
+
+public:
+	/// monotonic clock in microseconds
+	static uint64 get_time_us();
+
+	static void add_phase(phase_t phase, uint32 usec) { add( phases[phase], usec ); }
+
+	/// threads beyond MAX_THREADS are not recorded
+	static void add_worker(worker_t worker, uint32 thread_number, uint32 usec)
+	{
+		if(  thread_number < MAX_THREADS  ) {
+			add( workers[worker][thread_number], usec );
+		}
+	}
+
+	/// @return false if there are no samples yet
+	static bool get_phase_stats(phase_t phase, stats_t &stats);
+	static bool get_worker_stats(worker_t worker, uint32 thread_number, stats_t &stats);
+
+	static const char *get_phase_name(phase_t phase);
+	static const char *get_worker_name(worker_t worker);
+
+	/// forgets all samples
+	static void reset();
+
+	/// one line per phase and worker thread with samples
+	static void write_csv(CSV_t &csv);
+
+	/// @return false if the file could not be written
+	static bool write_csv(const char *filename);
+};
+
+
+/**
+ * Measures the time until it goes out of scope.
+ */
+class profile_scope_t
+{
+	const profiler_t::phase_t phase;
+	const uint64 start;
+
+public:
+	explicit profile_scope_t(profiler_t::phase_t phase) : phase(phase), start(profiler_t::get_time_us()) {}
+	~profile_scope_t() { profiler_t::add_phase( phase, (uint32)(profiler_t::get_time_us() - start) ); }
+};
+
+
+/**
+ * Measures the time a worker thread spends on one batch of work.
+ */
+class profile_worker_scope_t
+{
+	const profiler_t::worker_t worker;
+	const uint32 thread_number;
+	const uint64 start;
+
+public:
+	profile_worker_scope_t(profiler_t::worker_t worker, uint32 thread_number) : worker(worker), thread_number(thread_number), start(profiler_t::get_time_us()) {}
+	~profile_worker_scope_t() { profiler_t::add_worker( worker, thread_number, (uint32)(profiler_t::get_time_us() - start) ); }
+};
+
+
+/**
+ * For long functions made of consecutive phases, like karte_t::step():
+ * each lap() records the time since the previous one.
+ */
+class profile_laps_t
+{
+	uint64 last;
+
+public:
+	profile_laps_t() : last(profiler_t::get_time_us()) {}
+
+	void lap(profiler_t::phase_t phase)
+	{
+		const uint64 now = profiler_t::get_time_us();
+		profiler_t::add_phase( phase, (uint32)(now - last) );
+		last = now;
+	}
+};
+
+#endif
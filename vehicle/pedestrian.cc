@@ -276,6 +276,15 @@ sync_result pedestrian_t::sync_step(uint32 delta_t)
 }
 
 
+sint16 pedestrian_t::prepare_parallel_sync_step(uint32 delta_t)
+{
+	if(  time_to_life <= (sint32)delta_t  ) {
+		return -1;
+	}
+	return prepare_local_drive( weg_next + 128*delta_t );
+}
+
+
 grund_t* pedestrian_t::hop_check()
 {
 	grund_t *from = welt->lookup(pos_next);
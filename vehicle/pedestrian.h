@@ -61,6 +61,8 @@ public:
 
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
 
+	sint16 prepare_parallel_sync_step(uint32 delta_t) OVERRIDE;
+
 	///@ returns true if pedestrian walks on the left side of the road
 	bool is_on_left() const { return on_left; }
 
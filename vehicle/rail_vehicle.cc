@@ -293,6 +293,37 @@ bool rail_vehicle_t::check_next_tile(const grund_t *bd) const
 }
 
 
+bool rail_vehicle_t::get_route_cache_key(uint64 &key) const
+{
+	if(  cnv == NULL  ||  cnv->get_is_choosing()  ||  (target_halt.is_bound()  &&  cnv->is_waiting())  ) {
+		// these searches depend on the reservations
+		return false;
+	}
+
+	// everything check_next_tile(), check_access() and get_cost() depend on apart from the ways
+	way_constraints_mask permissive = 0;
+	way_constraints_mask prohibitive = (way_constraints_mask)~0;
+	for(  uint8 i = 0;  i < cnv->get_vehicle_count();  i++  ) {
+		const way_constraints_of_vehicle_t &wc = cnv->get_vehicle(i)->get_desc()->get_way_constraints();
+		permissive |= wc.get_permissive();
+		prohibitive &= wc.get_prohibitive();
+	}
+	const grund_t *gr = welt->lookup(get_pos());
+	const weg_t *current_way = gr ? gr->get_weg(get_waytype()) : NULL;
+	const uint8 current_way_owner = current_way == NULL ? 0xFF : current_way->get_owner() == NULL ? 0xFE : current_way->get_owner()->get_player_nr();
+
+	key = (uint64)get_owner_nr()
+		| ((uint64)current_way_owner << 8)
+		| ((uint64)permissive << 16)
+		| ((uint64)prohibitive << 24)
+		| ((uint64)cnv->needs_electrification() << 32)
+		| ((uint64)(speed_limit < INT_MAX) << 33)
+		| ((uint64)desc->get_override_way_speed() << 34)
+		| ((uint64)(uint32)cnv->get_min_top_speed() << 35);
+	return true;
+}
+
+
 // how expensive to go here (for way search)
 int rail_vehicle_t::get_cost(const grund_t *gr, const sint32 max_speed, koord from_pos)
 {
@@ -3122,16 +3153,15 @@ void rail_vehicle_t::clear_token_reservation(signal_t* sig, rail_vehicle_t* w, s
 	{
 		// The route has been recalculated since token block mode was entered, so delete all the reservations.
 		// Do not unreserve tiles ahead in the route (i.e., those not marked stale), however.
+		// Backwards, as releasing a way moves the last one into its place.
 		const waytype_t waytype = sch->get_waytype();
-		FOR(vector_tpl<weg_t*>, const way, weg_t::get_alle_wege())
+		const vector_tpl<schiene_t*> &reserved_ways = cnv->get_reserved_ways();
+		for(sint32 i = reserved_ways.get_count() - 1; i >= 0; i--)
 		{
-			if(way->get_waytype() == waytype)
+			schiene_t* const reserved_sch = reserved_ways[i];
+			if(reserved_sch->get_waytype() == waytype && reserved_sch->is_stale())
 			{
-				schiene_t* const sch = obj_cast<schiene_t>(way);
-				if(sch->get_reserved_convoi() == cnv->self && sch->is_stale())
-				{
-					sch->unreserve(w);
-				}
+				reserved_sch->unreserve(w);
 			}
 		}
 		cnv->set_needs_full_route_flush(false);
@@ -37,6 +37,8 @@ public:
 	// how expensive to go here (for way search)
 	int get_cost(const grund_t *, const sint32, koord) OVERRIDE;
 
+	bool get_route_cache_key(uint64 &key) const OVERRIDE;
+
 	uint32 get_cost_upslope() const OVERRIDE { return 75; } // Standard is 15
 
 	// returns true for the way search to an unknown target.
@@ -145,6 +145,22 @@ uint32 private_car_t::get_max_speed()
 }
 
 
+sint16 road_user_t::prepare_local_drive(uint32 distance)
+{
+	const uint32 steps_to_do = distance >> YARDS_PER_VEHICLE_STEP_SHIFT;
+	if(  steps_to_do + (uint32)steps > (uint32)steps_next  ) {
+		// will hop
+		return -1;
+	}
+	// same as in do_drive()
+	if(  steps_to_do > 0  &&  !get_flag(obj_t::dirty)  ) {
+		mark_image_dirty( image, 0 );
+		set_flag( obj_t::dirty );
+	}
+	return get_pos().y;
+}
+
+
 void road_user_t::hop(grund_t *)
 {
 	// V.Meyer: weg_position_t changed to grund_t::get_neighbour()
@@ -555,6 +571,16 @@ sync_result private_car_t::sync_step(uint32 delta_t)
 }
 
 
+sint16 private_car_t::prepare_parallel_sync_step(uint32 delta_t)
+{
+	// only plain driving within the tile: no slow destruction, no traffic jam and not the first step
+	if(  time_to_life <= (sint32)delta_t + 10000  ||  current_speed == 0  ||  ms_traffic_jam == SINT32_MAX_VALUE  ) {
+		return -1;
+	}
+	return prepare_local_drive( weg_next + current_speed * delta_t );
+}
+
+
 void private_car_t::rdwr(loadsave_t *file)
 {
 	xml_tag_t s( file, "private_car_t" );
@@ -49,6 +49,13 @@ protected:
 	void hop(grund_t *gr) OVERRIDE;
 	virtual void update_bookkeeping(uint32) OVERRIDE {};
 
+	/**
+	 * For prepare_parallel_sync_step(): if do_drive(distance) will not leave
+	 * the tile, marks the image dirty (do_drive() will then not touch the
+	 * display) and returns the map row. Otherwise -1.
+	 */
+	sint16 prepare_local_drive(uint32 distance);
+
 #ifdef INLINE_OBJ_TYPE
 	road_user_t(typ type);
 
@@ -137,6 +144,8 @@ public:
 
 	sync_result sync_step(uint32 delta_t) OVERRIDE;
 
+	sint16 prepare_parallel_sync_step(uint32 delta_t) OVERRIDE;
+
 	void hop(grund_t *gr) OVERRIDE;
 	bool can_enter_tile(grund_t *gr);
 